@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "MappedFile.hpp"
+#include "Parser.hpp"
+
+/**
+ * @brief Banco de pruebas de la carga de ficheros de máquina (make bench-parse)
+ *
+ * Genera máquinas de N transiciones con todas las transiciones definidas:
+ * monocinta (63 símbolos de cinta por estado) y MULTICINTA 2 (9 símbolos por
+ * cinta, 81 combinaciones por estado). Mide cuánto tarda Parser::load_auto_detect,
+ * el mismo camino que usa mt-sim, en cargarlas: mejor tiempo de varias
+ * repeticiones, nanosegundos por transición y MB/s. Con varios tamaños se
+ * comprueba que el coste crece linealmente.
+ */
+
+static const char SYMBOLS[] =
+    "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+static const size_t MONO_SYMBOLS = sizeof(SYMBOLS) - 1;  // Símbolos de entrada monocinta
+static const size_t MULTI_SYMBOLS = 8;                    // Símbolos de entrada por cinta (multicinta)
+
+static void show_help(const char* program_name) {
+  std::cout << "Uso: " << program_name << " [opciones]\n"
+            << "Opciones:\n"
+            << "  --transitions N,M,...  Tamaños a medir (por defecto 10000,100000,1000000)\n"
+            << "  --tapes K,...          Cintas de las máquinas generadas (por defecto 1,2)\n"
+            << "  --repeat R             Repeticiones por tamaño (por defecto 3)\n"
+            << "  --dir <directorio>     Dónde generar las máquinas (por defecto /tmp)\n"
+            << "  --keep                 No borra las máquinas generadas\n"
+            << "  --help                 Muestra esta ayuda\n";
+}
+
+/**
+ * @brief Escribe una lista de símbolos separados por sep
+ */
+static void write_list(std::ostream& out, const char* symbols, size_t count, char sep) {
+  for (size_t i = 0; i < count; ++i) {
+    if (i > 0) {
+      out << sep;
+    }
+    out << symbols[i];
+  }
+}
+
+/**
+ * @brief Escribe una máquina generada de num_transitions transiciones
+ * @param path Ruta del fichero
+ * @param num_transitions Número de transiciones
+ * @param num_tapes Cintas (1 = formato monocinta, más = formato MULTICINTA)
+ * @return true si se pudo escribir
+ */
+static bool generate_machine(const std::string& path, size_t num_transitions, size_t num_tapes) {
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  // Cada estado tiene una transición por combinación de símbolos leídos
+  size_t num_symbols = num_tapes == 1 ? MONO_SYMBOLS : MULTI_SYMBOLS;
+  size_t per_state = 1;
+  for (size_t t = 0; t < num_tapes; ++t) {
+    per_state *= num_symbols + 1;
+  }
+  size_t num_states = std::max<size_t>(2, (num_transitions + per_state - 1) / per_state);
+
+  file << "# Máquina generada por parse-bench: " << num_transitions << " transiciones\n";
+  if (num_tapes > 1) {
+    file << "MULTICINTA " << num_tapes << "\n";
+  }
+  for (size_t s = 0; s < num_states; ++s) {
+    file << (s > 0 ? " q" : "q") << s;
+  }
+  file << "\n";
+  write_list(file, SYMBOLS, num_symbols, ' ');
+  file << "\n";
+  write_list(file, SYMBOLS, num_symbols, ' ');
+  file << " .\nq0\n.\nq" << (num_states - 1) << "\n";
+
+  // Destinos, escrituras y movimientos pseudoaleatorios pero deterministas
+  static const char MOVES[] = "LRS";
+  size_t written = 0;
+  for (size_t s = 0; s < num_states && written < num_transitions; ++s) {
+    for (size_t c = 0; c < per_state && written < num_transitions; ++c, ++written) {
+      size_t to = (s * 7919 + c * 104729 + 1) % num_states;
+      std::string reads, writes, moves;
+      size_t rest = c;
+      for (size_t t = 0; t < num_tapes; ++t) {
+        size_t digit = rest % (num_symbols + 1);
+        rest /= num_symbols + 1;
+        if (t > 0) {
+          reads += ',';
+          writes += ',';
+          moves += ',';
+        }
+        reads += digit < num_symbols ? SYMBOLS[digit] : '.';
+        writes += SYMBOLS[(s + c + t) % num_symbols];
+        moves += MOVES[(s + c + t) % 3];
+      }
+      file << "q" << s << " " << reads << " q" << to << " " << writes << " " << moves << "\n";
+    }
+  }
+  return file.good();
+}
+
+/**
+ * @brief Convierte una lista "N,M,..." en números
+ */
+static std::vector<size_t> parse_list(const std::string& value) {
+  std::vector<size_t> numbers;
+  std::istringstream list(value);
+  std::string item;
+  while (std::getline(list, item, ',')) {
+    numbers.push_back(std::stoul(item));
+  }
+  return numbers;
+}
+
+int main(int argc, char** argv) {
+  std::vector<size_t> sizes = {10000, 100000, 1000000};
+  std::vector<size_t> tapes = {1, 2};
+  size_t repeat = 3;
+  std::string dir = "/tmp";
+  bool keep = false;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--help") {
+      show_help(argv[0]);
+      return 0;
+    } else if (arg == "--keep") {
+      keep = true;
+    } else if ((arg == "--transitions" || arg == "--tapes" || arg == "--repeat" || arg == "--dir") &&
+               i + 1 < argc) {
+      std::string value = argv[++i];
+      if (arg == "--dir") {
+        dir = value;
+        continue;
+      }
+      try {
+        if (arg == "--repeat") {
+          repeat = std::max<size_t>(1, std::stoul(value));
+        } else if (arg == "--tapes") {
+          tapes = parse_list(value);
+        } else {
+          sizes = parse_list(value);
+        }
+      } catch (...) {
+        std::cerr << "[Error] " << arg << " requiere enteros válidos\n";
+        return 1;
+      }
+    } else {
+      std::cerr << "[Error] Opción desconocida o incompleta: " << arg << "\n";
+      return 1;
+    }
+  }
+
+  std::printf("%-10s %14s %10s %12s %12s %10s\n", "formato", "transiciones", "MB", "mejor (s)",
+              "ns/trans", "MB/s");
+  for (size_t num_tapes : tapes) {
+    if (num_tapes == 0) {
+      continue;
+    }
+    std::string format = num_tapes == 1 ? "mono" : "multi-" + std::to_string(num_tapes);
+    for (size_t size : sizes) {
+      std::string path = dir + "/parse_bench_" + format + "_" + std::to_string(size) + ".txt";
+      if (!generate_machine(path, size, num_tapes)) {
+        std::cerr << "[Error] No se puede generar " << path << "\n";
+        return 3;
+      }
+      MappedFile probe(path);
+      double megabytes = static_cast<double>(probe.size()) / (1024.0 * 1024.0);
+      probe.close();
+
+      double best = 0.0;
+      for (size_t r = 0; r < repeat; ++r) {
+        TuringMachine machine;
+        MultiTuringMachine multi_machine(1);
+        bool is_multi_tape = false;
+        auto start = std::chrono::steady_clock::now();
+        bool ok = Parser::load_auto_detect(path, machine, multi_machine, is_multi_tape);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        size_t loaded = is_multi_tape ? multi_machine.get_transition_count() : machine.get_transition_count();
+        if (!ok || loaded != size || is_multi_tape != (num_tapes > 1)) {
+          std::cerr << "[Error] Carga incorrecta de " << path << ": " << Parser::get_last_error() << "\n";
+          return 2;
+        }
+        best = (r == 0) ? seconds : std::min(best, seconds);
+      }
+      std::printf("%-10s %14zu %10.1f %12.4f %12.1f %10.1f\n", format.c_str(), size, megabytes, best,
+                  best * 1e9 / static_cast<double>(size), megabytes / best);
+
+      if (!keep) {
+        std::remove(path.c_str());
+      }
+    }
+  }
+  return 0;
+}
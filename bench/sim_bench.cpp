@@ -0,0 +1,522 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "CompiledMachine.hpp"
+#include "MachineFactory.hpp"
+#include "Parser.hpp"
+#include "Simulator.hpp"
+#include "Tape.hpp"
+#include "WordReader.hpp"
+
+/**
+ * @brief Banco de pruebas de la simulación (make bench)
+ *
+ * Ejecuta cada motor (Simulator y MultiSimulator) sobre una matriz de cargas:
+ * - Las máquinas de data/ con las palabras válidas de tests/ (1000 pasos como
+ *   máximo por palabra, como mt-sim).
+ * - Campeones de Busy Beaver (2 a 5 estados), escalando el límite de pasos.
+ * - Contador unario (borra un 1 por pasada: n²/2 pasos) y contador binario
+ *   (incrementa 1^n: unos 3n pasos), escalando la entrada.
+ * - Copia a k cintas (MULTICINTA k), escalando la entrada.
+ * - Bordes de la cinta: una cinta de n celdas que se borra alternando los dos
+ *   extremos y consulta los extremos del contenido tras cada borrado (un
+ *   "paso" por borrado); el coste por paso no debe crecer con n.
+ *
+ * Cada medida se ejecuta en un proceso hijo, así que el pico de memoria (RSS)
+ * y las reservas de memoria son solo suyos; un hijo que supera el tiempo
+ * límite se mata y el resto de tamaños de esa carga se omite. Las máquinas y
+ * palabras se construyen antes de empezar a medir. Los resultados se imprimen
+ * como tabla y se guardan en JSON para comparar entre commits.
+ */
+
+// ===== Contador de reservas de memoria =====
+
+static uint64_t allocation_count = 0;  // Reservas desde el último reinicio
+static uint64_t allocation_bytes = 0;  // Bytes reservados desde el último reinicio
+
+void* operator new(std::size_t size) {
+  allocation_count++;
+  allocation_bytes += size;
+  if (void* pointer = std::malloc(size > 0 ? size : 1)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+// GCC no sabe que este operator new reserva con malloc
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+#pragma GCC diagnostic pop
+
+// ===== Cargas =====
+
+static const size_t DATA_MAX_STEPS = 1000;  // Límite por palabra de data/ (el de mt-sim)
+
+/**
+ * @brief Motor que ejecuta una carga
+ */
+enum class Engine {
+  MONO,   // Simulator sobre la máquina monocinta
+  MULTI   // MultiSimulator (las máquinas monocinta se convierten a 1 cinta)
+};
+
+/**
+ * @brief Una carga: cómo construir la máquina y la entrada de un tamaño
+ */
+struct Workload {
+  std::string name;           // Nombre en los resultados
+  Engine engine;              // Motor
+  std::string machine_path;   // Máquina de data/ (vacío si es generada)
+  bool scales_steps;          // El tamaño es el límite de pasos (no la entrada)
+  bool scales;                // Si se mide con cada tamaño o una sola vez
+};
+
+/**
+ * @brief Resultado de una medida, enviado del hijo al padre
+ */
+struct Measure {
+  uint64_t words;        // Palabras simuladas
+  uint64_t symbols;      // Símbolos de entrada
+  uint64_t steps;        // Pasos totales
+  double seconds;        // Tiempo de simulación
+  uint64_t peak_rss_kb;  // Pico de memoria residente del hijo
+  uint64_t allocations;  // Reservas durante la simulación
+  uint64_t allocated;    // Bytes reservados durante la simulación
+  int result;            // SimulationResult de la última palabra
+  bool ok;               // Si la carga se pudo preparar
+};
+
+/**
+ * @brief Palabra de n símbolos repitiendo un patrón
+ */
+static std::string repeat_pattern(const std::string& pattern, size_t n) {
+  std::string word(n, ' ');
+  for (size_t i = 0; i < n; ++i) {
+    word[i] = pattern[i % pattern.size()];
+  }
+  return word;
+}
+
+/**
+ * @brief Palabras válidas de todos los ficheros de tests/ para una máquina
+ */
+static std::vector<std::string> data_words(const CompiledMachine& compiled, const std::string& tests_dir) {
+  std::vector<std::string> words;
+  DIR* dir = opendir(tests_dir.c_str());
+  if (dir == nullptr) {
+    return words;
+  }
+  std::vector<std::string> files;
+  while (dirent* entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name.size() > 4 && name.compare(name.size() - 4, 4, ".txt") == 0) {
+      files.push_back(tests_dir + "/" + name);
+    }
+  }
+  closedir(dir);
+  std::sort(files.begin(), files.end());
+
+  for (const std::string& file : files) {
+    WordReader reader;
+    if (!reader.open_file(file)) {
+      continue;
+    }
+    std::string_view word;
+    while (reader.next(word)) {
+      if (compiled.is_valid_input_word(word)) {
+        words.emplace_back(word);
+      }
+    }
+  }
+  return words;
+}
+
+/**
+ * @brief Mide la carga de bordes de la cinta con n celdas
+ */
+static Measure run_tape_bounds(size_t size) {
+  Measure measure{};
+  Tape tape('.');
+  for (size_t i = 0; i < size; ++i) {
+    tape.write('1');
+    tape.move_right();
+  }
+
+  allocation_count = 0;
+  allocation_bytes = 0;
+  auto start = std::chrono::steady_clock::now();
+  while (!tape.is_empty()) {
+    // Consultar los dos extremos, como la salida y los detectores de bucles
+    // tras cada paso, y borrar uno de ellos
+    int first = tape.get_content_start();
+    int last = tape.get_content_end();
+    tape.set_head_position(measure.steps % 2 == 0 ? first : last);
+    tape.write('.');
+    ++measure.steps;
+  }
+  measure.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  measure.allocations = allocation_count;
+  measure.allocated = allocation_bytes;
+
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  measure.peak_rss_kb = static_cast<uint64_t>(usage.ru_maxrss);
+  measure.symbols = size;
+  measure.words = 1;
+  measure.result = static_cast<int>(measure.steps == size ? SimulationResult::ACCEPTED : SimulationResult::ERROR);
+  measure.ok = true;
+  return measure;
+}
+
+/**
+ * @brief Prepara y mide una carga de un tamaño (se ejecuta en el proceso hijo)
+ */
+static Measure run_workload(const Workload& workload, size_t size, const std::string& tests_dir) {
+  if (workload.name == "bordes-cinta") {
+    return run_tape_bounds(size);
+  }
+  Measure measure{};
+  TuringMachine mono;
+  MultiTuringMachine multi(1);
+  bool is_multi_tape = false;
+  std::vector<std::string> words;
+  size_t max_steps = 0;
+
+  if (!workload.machine_path.empty()) {
+    if (!Parser::load_auto_detect(workload.machine_path, mono, multi, is_multi_tape)) {
+      return measure;
+    }
+    max_steps = DATA_MAX_STEPS;
+  } else if (workload.name.compare(0, 3, "bb-") == 0) {
+    mono = MachineFactory::busy_beaver(workload.name[3] - '0');
+    words.push_back("");
+    max_steps = size;
+  } else if (workload.name == "contador-unario") {
+    mono = MachineFactory::unary_counter();
+    words.push_back(std::string(size, '1'));
+  } else if (workload.name == "contador-binario") {
+    mono = MachineFactory::binary_counter();
+    words.push_back(std::string(size, '1'));
+  } else {
+    multi = MachineFactory::tape_copy(static_cast<size_t>(workload.name.back() - '0'));
+    is_multi_tape = true;
+    words.push_back(repeat_pattern("ab", size));
+  }
+  if (!is_multi_tape && workload.engine == Engine::MULTI) {
+    multi = MultiTuringMachine::from_mono_machine(mono, 1);
+    is_multi_tape = true;
+  }
+
+  CompiledMachine compiled;
+  if (!(is_multi_tape ? compiled.compile(multi) : compiled.compile(mono))) {
+    return measure;
+  }
+  if (!workload.machine_path.empty()) {
+    words = data_words(compiled, tests_dir);
+  }
+  std::unique_ptr<Simulator> simulator;
+  std::unique_ptr<MultiSimulator> multi_simulator;
+  if (is_multi_tape) {
+    multi_simulator = std::make_unique<MultiSimulator>(&compiled);
+  } else {
+    simulator = std::make_unique<Simulator>(&compiled);
+  }
+
+  SimulationResult result = SimulationResult::ERROR;
+  allocation_count = 0;
+  allocation_bytes = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (const std::string& word : words) {
+    if (is_multi_tape) {
+      result = multi_simulator->simulate(word, false, max_steps);
+      measure.steps += multi_simulator->get_step_count();
+    } else {
+      result = simulator->simulate(word, false, max_steps);
+      measure.steps += simulator->get_step_count();
+    }
+    measure.symbols += word.size();
+  }
+  measure.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  measure.allocations = allocation_count;
+  measure.allocated = allocation_bytes;
+
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  measure.peak_rss_kb = static_cast<uint64_t>(usage.ru_maxrss);
+  measure.words = words.size();
+  measure.result = static_cast<int>(result);
+  measure.ok = true;
+  return measure;
+}
+
+/**
+ * @brief Ejecuta una medida en un proceso hijo con tiempo límite
+ * @param timed_out Salida: si el hijo superó el tiempo límite
+ * @return true si se obtuvo la medida
+ */
+static bool measure_in_child(const Workload& workload, size_t size, const std::string& tests_dir,
+                             unsigned timeout_s, Measure& measure, bool& timed_out) {
+  timed_out = false;
+  int fds[2];
+  if (pipe(fds) < 0) {
+    return false;
+  }
+  std::cout.flush();
+  pid_t pid = fork();
+  if (pid < 0) {
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+  if (pid == 0) {
+    close(fds[0]);
+    alarm(timeout_s);
+    Measure child = run_workload(workload, size, tests_dir);
+    ssize_t written = write(fds[1], &child, sizeof(child));
+    _exit(written == static_cast<ssize_t>(sizeof(child)) ? 0 : 1);
+  }
+
+  close(fds[1]);
+  size_t received = 0;
+  char* buffer = reinterpret_cast<char*>(&measure);
+  while (received < sizeof(measure)) {
+    ssize_t n = read(fds[0], buffer + received, sizeof(measure) - received);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      break;
+    }
+    received += static_cast<size_t>(n);
+  }
+  close(fds[0]);
+
+  int status = 0;
+  while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+  }
+  if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM) {
+    timed_out = true;
+    return false;
+  }
+  return received == sizeof(measure) && measure.ok;
+}
+
+static std::string result_name(int result) {
+  return Simulator::result_to_string(static_cast<SimulationResult>(result));
+}
+
+static void show_help(const char* program_name) {
+  std::cout << "Uso: " << program_name << " [opciones]\n"
+            << "Opciones:\n"
+            << "  --sizes N,M,...    Tamaños de entrada (o límites de pasos en Busy Beaver);\n"
+            << "                     por defecto 10,100,...,10000000\n"
+            << "  --timeout S        Segundos por medida; al superarlos se omiten los tamaños\n"
+            << "                     mayores de esa carga (por defecto 10)\n"
+            << "  --filter <texto>   Solo las cargas cuyo nombre lo contiene\n"
+            << "  --json <fichero>   Resultados en JSON (por defecto bench-results.json)\n"
+            << "  --label <texto>    Etiqueta guardada en el JSON (p. ej. el commit)\n"
+            << "  --data <dir>       Máquinas de ejemplo (por defecto data)\n"
+            << "  --tests <dir>      Palabras de ejemplo (por defecto tests)\n"
+            << "  --help             Muestra esta ayuda\n";
+}
+
+/**
+ * @brief Convierte una lista "N,M,..." en números
+ */
+static std::vector<size_t> parse_list(const std::string& value) {
+  std::vector<size_t> numbers;
+  std::istringstream list(value);
+  std::string item;
+  while (std::getline(list, item, ',')) {
+    numbers.push_back(std::stoul(item));
+  }
+  return numbers;
+}
+
+/**
+ * @brief Escapa una cadena para JSON (nombres de carga y etiqueta)
+ */
+static std::string json_string(const std::string& text) {
+  std::string escaped = "\"";
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += static_cast<unsigned char>(c) < 0x20 ? ' ' : c;
+  }
+  return escaped + "\"";
+}
+
+int main(int argc, char** argv) {
+  std::vector<size_t> sizes = {10, 100, 1000, 10000, 100000, 1000000, 10000000};
+  unsigned timeout_s = 10;
+  std::string filter;
+  std::string json_path = "bench-results.json";
+  std::string label;
+  std::string data_dir = "data";
+  std::string tests_dir = "tests";
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--help") {
+      show_help(argv[0]);
+      return 0;
+    } else if ((arg == "--sizes" || arg == "--timeout" || arg == "--filter" || arg == "--json" ||
+                arg == "--label" || arg == "--data" || arg == "--tests") &&
+               i + 1 < argc) {
+      std::string value = argv[++i];
+      if (arg == "--filter") {
+        filter = value;
+      } else if (arg == "--json") {
+        json_path = value;
+      } else if (arg == "--label") {
+        label = value;
+      } else if (arg == "--data") {
+        data_dir = value;
+      } else if (arg == "--tests") {
+        tests_dir = value;
+      } else {
+        try {
+          if (arg == "--timeout") {
+            timeout_s = static_cast<unsigned>(std::max(1ul, std::stoul(value)));
+          } else {
+            sizes = parse_list(value);
+          }
+        } catch (...) {
+          std::cerr << "[Error] " << arg << " requiere enteros válidos\n";
+          return 1;
+        }
+      }
+    } else {
+      std::cerr << "[Error] Opción desconocida o incompleta: " << arg << "\n";
+      return 1;
+    }
+  }
+
+  // Matriz de cargas: máquinas de ejemplo y familias generadas, en cada motor
+  std::vector<Workload> workloads;
+  std::vector<std::string> machine_files;
+  if (DIR* dir = opendir(data_dir.c_str())) {
+    while (dirent* entry = readdir(dir)) {
+      std::string name = entry->d_name;
+      if (name.size() > 4 && name.compare(name.size() - 4, 4, ".txt") == 0) {
+        machine_files.push_back(name);
+      }
+    }
+    closedir(dir);
+  }
+  std::sort(machine_files.begin(), machine_files.end());
+  for (const std::string& name : machine_files) {
+    TuringMachine mono;
+    MultiTuringMachine multi(1);
+    bool is_multi_tape = false;
+    std::string path = data_dir + "/" + name;
+    try {
+      if (!Parser::load_auto_detect(path, mono, multi, is_multi_tape)) {
+        continue;  // Ejemplos de ficheros con errores
+      }
+    } catch (const std::exception&) {
+      continue;
+    }
+    std::string stem = "data/" + name.substr(0, name.size() - 4);
+    workloads.push_back({stem, is_multi_tape ? Engine::MULTI : Engine::MONO, path, false, false});
+    if (!is_multi_tape) {
+      workloads.push_back({stem, Engine::MULTI, path, false, false});
+    }
+  }
+  for (const char* name : {"bb-2", "bb-3", "bb-4", "bb-5"}) {
+    workloads.push_back({name, Engine::MONO, "", true, true});
+  }
+  for (const char* name : {"contador-unario", "contador-binario"}) {
+    workloads.push_back({name, Engine::MONO, "", false, true});
+    workloads.push_back({name, Engine::MULTI, "", false, true});
+  }
+  for (const char* name : {"copia-2", "copia-3"}) {
+    workloads.push_back({name, Engine::MULTI, "", false, true});
+  }
+  workloads.push_back({"bordes-cinta", Engine::MONO, "", false, true});
+
+  std::ostringstream json;
+  json << "{\"label\":" << json_string(label) << ",\"timestamp\":" << std::time(nullptr)
+       << ",\"timeout_s\":" << timeout_s << ",\"results\":[";
+  bool first_result = true;
+
+  std::printf("%-24s %-6s %10s %12s %10s %10s %11s %9s %11s %s\n", "carga", "motor", "tamaño",
+              "pasos", "tiempo (s)", "ns/paso", "Mpasos/s", "RSS (MB)", "reservas", "resultado");
+  for (const Workload& workload : workloads) {
+    if (!filter.empty() && workload.name.find(filter) == std::string::npos) {
+      continue;
+    }
+    const char* engine = workload.engine == Engine::MONO ? "mono" : "multi";
+    std::vector<size_t> run_sizes = workload.scales ? sizes : std::vector<size_t>{0};
+    for (size_t size : run_sizes) {
+      Measure measure{};
+      bool timed_out = false;
+      if (!measure_in_child(workload, size, tests_dir, timeout_s, measure, timed_out)) {
+        std::printf("%-24s %-6s %10zu %12s %10s %10s %11s %9s %11s %s\n", workload.name.c_str(),
+                    engine, size, "-", "-", "-", "-", "-", "-",
+                    timed_out ? "TIEMPO AGOTADO" : "ERROR");
+        json << (first_result ? "" : ",") << "{\"workload\":" << json_string(workload.name)
+             << ",\"engine\":\"" << engine << "\",\"size\":" << size << ",\"status\":\""
+             << (timed_out ? "timeout" : "error") << "\"}";
+        first_result = false;
+        break;  // Los tamaños mayores tardarían aún más
+      }
+
+      size_t shown_size = workload.scales ? size : measure.symbols;
+      double ns_per_step = measure.steps > 0 ? measure.seconds * 1e9 / static_cast<double>(measure.steps) : 0.0;
+      double steps_per_second = measure.seconds > 0 ? static_cast<double>(measure.steps) / measure.seconds : 0.0;
+      std::printf("%-24s %-6s %10zu %12llu %10.4f %10.1f %11.2f %9.1f %11llu %s\n",
+                  workload.name.c_str(), engine, shown_size,
+                  static_cast<unsigned long long>(measure.steps), measure.seconds, ns_per_step,
+                  steps_per_second / 1e6, static_cast<double>(measure.peak_rss_kb) / 1024.0,
+                  static_cast<unsigned long long>(measure.allocations), result_name(measure.result).c_str());
+      std::fflush(stdout);
+      json << (first_result ? "" : ",") << "{\"workload\":" << json_string(workload.name)
+           << ",\"engine\":\"" << engine << "\",\"size\":" << shown_size << ",\"status\":\"ok\""
+           << ",\"words\":" << measure.words << ",\"steps\":" << measure.steps
+           << ",\"seconds\":" << measure.seconds << ",\"ns_per_step\":" << ns_per_step
+           << ",\"steps_per_second\":" << steps_per_second << ",\"peak_rss_kb\":" << measure.peak_rss_kb
+           << ",\"allocations\":" << measure.allocations << ",\"allocated_bytes\":" << measure.allocated
+           << ",\"result\":\"" << result_name(measure.result) << "\"}";
+      first_result = false;
+
+      // En Busy Beaver, si la máquina paró antes del límite los demás serían iguales
+      if (workload.scales_steps && measure.steps < size) {
+        break;
+      }
+    }
+  }
+  json << "]}\n";
+
+  std::ofstream file(json_path);
+  file << json.str();
+  if (!file.good()) {
+    std::cerr << "[Error] No se puede escribir " << json_path << "\n";
+    return 3;
+  }
+  std::cout << "Resultados en " << json_path << "\n";
+  return 0;
+}
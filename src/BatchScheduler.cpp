@@ -0,0 +1,146 @@
+#include "BatchScheduler.hpp"
+#include <algorithm>
+#include <exception>
+
+BatchScheduler::BatchScheduler(const CompiledMachine* machine, size_t num_workers, size_t slice_steps,
+                               size_t window)
+    : machine_(machine), is_multi_tape_(machine->get_num_tapes() > 1),
+      slice_steps_(slice_steps > 0 ? slice_steps : DEFAULT_SLICE_STEPS), window_(window > 0 ? window : 1),
+      max_steps_(1000), word_timeout_(0), batch_deadline_(std::chrono::steady_clock::time_point::max()),
+      cancellation_(nullptr), pool_(num_workers, TaskOrder::OLDEST_FIRST), requeued_(0), started_(false) {
+}
+
+BatchScheduler::~BatchScheduler() {
+  if (started_) {
+    pool_.wait();
+  }
+}
+
+bool BatchScheduler::set_deciders(const std::string& list, const DeciderBudget& budget, std::string& error) {
+  // Una cadena por hilo: los decisores guardan estado y no se comparten
+  deciders_.clear();
+  for (size_t i = 0; i < pool_.get_num_workers(); ++i) {
+    auto deciders = std::make_unique<DeciderPipeline>(machine_);
+    if (!deciders->set_deciders(list)) {
+      error = deciders->get_last_error();
+      deciders_.clear();
+      return false;
+    }
+    deciders->set_budget(budget);
+    deciders_.push_back(std::move(deciders));
+  }
+  return true;
+}
+
+void BatchScheduler::submit(size_t index, std::string_view word) {
+  if (!started_) {
+    pool_.start();
+    started_ = true;
+  }
+  auto job = std::make_unique<Job>();
+  job->index = index;
+  job->word = std::string(word);
+  Job* raw = job.get();
+  jobs_.push_back(std::move(job));
+  pool_.submit([this, raw](size_t worker) { run_slice(raw, worker); });
+}
+
+void BatchScheduler::submit_result(size_t index, std::string_view word, SimulationResult result,
+                                   const std::string& bad_symbol) {
+  auto job = std::make_unique<Job>();
+  job->index = index;
+  job->word = std::string(word);
+  job->result = result;
+  job->bad_symbol = bad_symbol;
+  job->done = true;
+  jobs_.push_back(std::move(job));
+}
+
+std::unique_ptr<BatchScheduler::Job> BatchScheduler::next() {
+  if (jobs_.empty()) {
+    return nullptr;
+  }
+  Job* front = jobs_.front().get();
+  {
+    std::unique_lock<std::mutex> lock(done_mutex_);
+    done_cv_.wait(lock, [front] { return front->done.load(); });
+  }
+  std::unique_ptr<Job> job = std::move(jobs_.front());
+  jobs_.pop_front();
+  return job;
+}
+
+void BatchScheduler::finish(Job* job) {
+  {
+    std::lock_guard<std::mutex> lock(done_mutex_);
+    job->done = true;
+  }
+  done_cv_.notify_all();
+}
+
+bool BatchScheduler::start_job(Job* job, size_t worker) {
+  // Agotado el plazo del lote, la palabra ya no se simula
+  auto now = std::chrono::steady_clock::now();
+  if (now >= batch_deadline_) {
+    job->result = SimulationResult::TIMEOUT;
+    return false;
+  }
+  job->simulated = true;
+  auto deadline = batch_deadline_;
+  if (word_timeout_.count() > 0) {
+    deadline = std::min(deadline, now + word_timeout_);
+  }
+
+  bool ok;
+  if (is_multi_tape_) {
+    job->multi_simulator = std::make_unique<MultiSimulator>(machine_);
+    job->multi_simulator->set_deadline(deadline);
+    job->multi_simulator->set_cancellation_token(cancellation_);
+    ok = job->multi_simulator->start_validated(job->word, false, max_steps_);
+  } else {
+    job->simulator = std::make_unique<Simulator>(machine_);
+    job->simulator->set_deadline(deadline);
+    job->simulator->set_cancellation_token(cancellation_);
+    // Los decisores solo actúan en start(): la cadena del hilo queda libre
+    // aunque los tramos siguientes los ejecute otro
+    if (!deciders_.empty()) {
+      job->simulator->set_deciders(deciders_[worker].get());
+    }
+    ok = job->simulator->start_validated(job->word, false, max_steps_);
+    job->simulator->set_deciders(nullptr);
+  }
+  if (!ok) {
+    job->result = SimulationResult::ERROR;
+    return false;
+  }
+  job->generator = is_multi_tape_ ? std::make_unique<SimulationGenerator>(job->multi_simulator.get())
+                                  : std::make_unique<SimulationGenerator>(job->simulator.get());
+  job->generator->set_yield_every(slice_steps_);
+  return true;
+}
+
+void BatchScheduler::run_slice(Job* job, size_t worker) {
+  std::optional<SimulationResult> result;
+  try {
+    if (job->generator == nullptr && !start_job(job, worker)) {
+      finish(job);
+      return;
+    }
+    ++job->slices;
+    job->generator->next();
+    if (job->generator->get_event().kind == SimulationEventKind::FINISHED) {
+      result = job->generator->get_event().result;
+    }
+  } catch (const std::exception& e) {
+    // Una excepción no debe salir del hilo: la palabra termina con ERROR
+    job->error = e.what();
+    result = SimulationResult::ERROR;
+  }
+  if (result.has_value()) {
+    job->result = result.value();
+    finish(job);
+    return;
+  }
+  requeued_.fetch_add(1);
+  pool_.requeue(worker, [this, job](size_t next_worker) { run_slice(job, next_worker); });
+}
@@ -0,0 +1,159 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CancellationToken.hpp"
+#include "CompiledMachine.hpp"
+#include "DeciderPipeline.hpp"
+#include "SimulationGenerator.hpp"
+#include "Simulator.hpp"
+#include "WorkStealingPool.hpp"
+
+/**
+ * @brief Lote de palabras simulado por varios hilos con tramos de pasos (mt-sim --jobs)
+ *
+ * Cada palabra es una tarea reanudable: cada vez que un hilo la toma avanza
+ * como mucho slice_steps pasos (un evento SLICE de SimulationGenerator) y, si no ha
+ * terminado, vuelve a la cola detrás de las que esperan. Así una palabra de
+ * 10^9 pasos no deja esperando a las cortas que le tocan detrás, y los hilos
+ * libres roban tareas de las colas de los demás.
+ *
+ * Los resultados salen en el orden de entrada: next() devuelve la palabra más
+ * antigua cuando termina. Como mucho hay window palabras admitidas sin
+ * recoger (cada una con su simulador); submit() no espera, así que quien
+ * alimenta el lote debe recoger antes de superar la ventana (ver is_full()).
+ *
+ * Las palabras que no se simulan (fuera del alfabeto, plazo del lote agotado)
+ * también pasan por aquí con su resultado ya puesto, para conservar el orden.
+ */
+class BatchScheduler {
+public:
+  static constexpr size_t DEFAULT_SLICE_STEPS = 1 << 16;  // Pasos por tramo
+  static constexpr size_t DEFAULT_WINDOW = 1024;          // Palabras admitidas sin recoger
+
+  /**
+   * @brief Palabra del lote y su simulación
+   */
+  struct Job {
+    size_t index;                                     // Índice de la palabra
+    std::string word;                                 // Palabra (copia: la entrada puede avanzar)
+    bool simulated = false;                           // Si se simuló (si no, result ya venía dado)
+    SimulationResult result = SimulationResult::ERROR;  // Resultado
+    std::string bad_symbol;                           // Símbolo fuera del alfabeto (si no se simuló por eso)
+    std::unique_ptr<Simulator> simulator;             // Simulación monocinta
+    std::unique_ptr<MultiSimulator> multi_simulator;  // Simulación multicinta
+    std::unique_ptr<SimulationGenerator> generator;   // Tramos de la simulación
+    size_t slices = 0;                                // Tramos ejecutados
+    std::string error;                                // Excepción de la simulación (result es ERROR)
+    std::atomic<bool> done{false};                    // Si terminó
+  };
+
+private:
+  const CompiledMachine* machine_;                   // Máquina compilada
+  bool is_multi_tape_;                               // Si se usa MultiSimulator
+  size_t slice_steps_;                               // Pasos por tramo
+  size_t window_;                                    // Palabras admitidas sin recoger
+  size_t max_steps_;                                 // Límite de pasos por palabra
+  std::chrono::milliseconds word_timeout_;           // Plazo por palabra (0 = sin plazo)
+  std::chrono::steady_clock::time_point batch_deadline_;  // Plazo del lote (max() = sin plazo)
+  const CancellationToken* cancellation_;            // Cancelación externa (nullptr = ninguna)
+  std::vector<std::unique_ptr<DeciderPipeline>> deciders_;  // Cadena de decisores por hilo (vacío = ninguna)
+
+  WorkStealingPool pool_;                            // Hilos
+  std::deque<std::unique_ptr<Job>> jobs_;            // Palabras sin recoger, en orden de entrada
+  std::mutex done_mutex_;                            // Espera de la palabra más antigua
+  std::condition_variable done_cv_;                  // Aviso de palabra terminada
+  std::atomic<uint64_t> requeued_;                   // Tramos que no terminaron su palabra
+  bool started_;                                     // Si los hilos están arrancados
+
+  /**
+   * @brief Ejecuta un tramo de una palabra y la vuelve a encolar si no terminó
+   */
+  void run_slice(Job* job, size_t worker);
+
+  /**
+   * @brief Marca una palabra como terminada y avisa
+   */
+  void finish(Job* job);
+
+  /**
+   * @brief Crea el simulador de una palabra y empieza la simulación
+   * @return false si no se pudo empezar (result queda puesto)
+   */
+  bool start_job(Job* job, size_t worker);
+
+public:
+  /**
+   * @brief Constructor
+   * @param machine Máquina compilada (debe sobrevivir al lote)
+   * @param num_workers Número de hilos
+   * @param slice_steps Pasos por tramo
+   * @param window Palabras admitidas sin recoger
+   */
+  BatchScheduler(const CompiledMachine* machine, size_t num_workers,
+                 size_t slice_steps = DEFAULT_SLICE_STEPS, size_t window = DEFAULT_WINDOW);
+
+  /**
+   * @brief Detiene los hilos (las palabras sin recoger se descartan al terminar)
+   */
+  ~BatchScheduler();
+
+  BatchScheduler(const BatchScheduler&) = delete;
+  BatchScheduler& operator=(const BatchScheduler&) = delete;
+
+  void set_max_steps(size_t max_steps) { max_steps_ = max_steps; }
+  void set_word_timeout(std::chrono::milliseconds timeout) { word_timeout_ = timeout; }
+  void set_batch_deadline(std::chrono::steady_clock::time_point deadline) { batch_deadline_ = deadline; }
+  void set_cancellation_token(const CancellationToken* token) { cancellation_ = token; }
+
+  /**
+   * @brief Aplica decisores de no parada a cada palabra (solo monocinta)
+   * @return false si la lista no es válida (ver error)
+   */
+  bool set_deciders(const std::string& list, const DeciderBudget& budget, std::string& error);
+
+  /**
+   * @brief Admite una palabra para simular, ya comprobada contra el alfabeto
+   *        de entrada (las demás van por submit_result())
+   */
+  void submit(size_t index, std::string_view word);
+
+  /**
+   * @brief Admite una palabra que no se simula, con su resultado
+   * @param bad_symbol Símbolo fuera del alfabeto, si es el motivo
+   */
+  void submit_result(size_t index, std::string_view word, SimulationResult result,
+                     const std::string& bad_symbol = "");
+
+  /**
+   * @brief Indica si la ventana está llena (hay que recoger antes de admitir)
+   */
+  bool is_full() const { return jobs_.size() >= window_; }
+
+  /**
+   * @brief Indica si quedan palabras sin recoger
+   */
+  bool has_pending() const { return !jobs_.empty(); }
+
+  /**
+   * @brief Indica si la palabra más antigua ya terminó (next() no esperará)
+   */
+  bool has_ready() const { return !jobs_.empty() && jobs_.front()->done.load(); }
+
+  /**
+   * @brief Espera a que termine la palabra más antigua y la entrega
+   * @return nullptr si no quedan palabras
+   */
+  std::unique_ptr<Job> next();
+
+  uint64_t get_requeued() const { return requeued_.load(); }
+  uint64_t get_steals() const { return pool_.get_steals(); }
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+
+/**
+ * @brief Petición de cancelación compartida entre hilos
+ *
+ * Cualquier hilo, o un manejador de señal, llama a cancel(); los simuladores
+ * la consultan cada Simulator::INTERRUPT_CHECK_INTERVAL pasos y terminan con
+ * SimulationResult::TIMEOUT. Solo contiene un std::atomic<bool> sin cerrojos,
+ * así que cancel() es seguro dentro de un manejador de señal.
+ */
+class CancellationToken {
+private:
+  std::atomic<bool> cancelled_;  // Si se pidió la cancelación
+
+  static_assert(std::atomic<bool>::is_always_lock_free,
+                "CancellationToken necesita un atómico sin cerrojos");
+
+public:
+  CancellationToken() : cancelled_(false) {}
+
+  CancellationToken(const CancellationToken&) = delete;
+  CancellationToken& operator=(const CancellationToken&) = delete;
+
+  /**
+   * @brief Pide la cancelación
+   */
+  void cancel() noexcept { cancelled_.store(true, std::memory_order_relaxed); }
+
+  /**
+   * @brief Anula una petición anterior
+   */
+  void reset() noexcept { cancelled_.store(false, std::memory_order_relaxed); }
+
+  /**
+   * @brief Indica si se pidió la cancelación
+   */
+  bool is_cancelled() const noexcept { return cancelled_.load(std::memory_order_relaxed); }
+};
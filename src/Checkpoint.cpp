@@ -0,0 +1,213 @@
+#include "Checkpoint.hpp"
+#include "ResultCache.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+#include <utility>
+
+namespace {
+
+const char CHECKPOINT_MAGIC[4] = {'M', 'T', 'C', 'K'};
+
+// Cabecera: marca, versión (u32) y suma de la carga (u64)
+const size_t HEADER_SIZE = sizeof(CHECKPOINT_MAGIC) + sizeof(uint32_t) + sizeof(uint64_t);
+
+/**
+ * @brief Sincroniza el directorio de path para que un rename() sea duradero
+ */
+bool sync_parent_directory(const std::string& path) {
+  size_t slash = path.rfind('/');
+  std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+  int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  bool ok = ::fsync(fd) == 0;
+  ::close(fd);
+  return ok;
+}
+
+template <typename T>
+void append_value(std::string& out, const T& value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * @brief Lectura con comprobación de límites sobre el contenido del fichero
+ */
+class Reader {
+private:
+  const std::string& data_;
+  size_t offset_;
+  bool ok_;
+
+public:
+  explicit Reader(const std::string& data) : data_(data), offset_(0), ok_(true) {}
+
+  template <typename T>
+  T get() {
+    T value{};
+    if (ok_ && data_.size() - offset_ >= sizeof(T)) {
+      std::memcpy(&value, data_.data() + offset_, sizeof(T));
+      offset_ += sizeof(T);
+    } else {
+      ok_ = false;
+    }
+    return value;
+  }
+
+  std::string get_bytes(uint64_t length) {
+    if (!ok_ || data_.size() - offset_ < length) {
+      ok_ = false;
+      return std::string();
+    }
+    std::string bytes = data_.substr(offset_, static_cast<size_t>(length));
+    offset_ += static_cast<size_t>(length);
+    return bytes;
+  }
+
+  bool ok() const { return ok_; }
+  bool at_end() const { return offset_ == data_.size(); }
+};
+
+}  // namespace
+
+bool Checkpoint::save(const std::string& path, std::string& error) const {
+  std::string data;
+  data.append(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+  append_value(data, FILE_VERSION);
+  append_value(data, uint64_t(0));  // Suma de la carga, se rellena al final
+  append_value(data, machine_digest);
+  append_value(data, word_index);
+  append_value(data, max_steps);
+  append_value(data, static_cast<uint32_t>(word.size()));
+  data += word;
+  append_value(data, state);
+  append_value(data, steps);
+  append_value(data, static_cast<uint16_t>(tapes.size()));
+  for (const TapeImage& tape : tapes) {
+    append_value(data, tape.head);
+    append_value(data, tape.start);
+    append_value(data, static_cast<uint64_t>(tape.content.size()));
+    data += tape.content;
+  }
+  append_value(data, static_cast<uint8_t>(has_cycle_detector ? 1 : 0));
+  if (has_cycle_detector) {
+    for (const CycleSide* side : {&cycle_right, &cycle_left}) {
+      append_value(data, side->bound);
+      append_value(data, static_cast<uint32_t>(side->records.size()));
+      for (const CycleRecord& record : side->records) {
+        append_value(data, record.state);
+        append_value(data, record.position);
+        append_value(data, record.reach);
+        append_value(data, static_cast<uint32_t>(record.segment.size()));
+        data += record.segment;
+      }
+    }
+  }
+  append_value(data, static_cast<uint64_t>(visited.size()));
+  for (uint64_t hash : visited) {
+    append_value(data, hash);
+  }
+
+  uint64_t checksum = ResultCache::hash_bytes(std::string_view(data).substr(HEADER_SIZE));
+  std::memcpy(&data[HEADER_SIZE - sizeof(checksum)], &checksum, sizeof(checksum));
+
+  std::string temporary = path + ".tmp";
+  int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    error = "No se puede crear el punto de control: " + temporary + " (" + std::strerror(errno) + ")";
+    return false;
+  }
+  size_t written = 0;
+  while (written < data.size()) {
+    ssize_t count = ::write(fd, data.data() + written, data.size() - written);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      break;
+    }
+    written += static_cast<size_t>(count);
+  }
+  bool ok = written == data.size() && ::fsync(fd) == 0;
+  ok = ::close(fd) == 0 && ok;
+  if (!ok || ::rename(temporary.c_str(), path.c_str()) != 0) {
+    error = "Error al escribir el punto de control: " + path + " (" + std::strerror(errno) + ")";
+    ::unlink(temporary.c_str());
+    return false;
+  }
+  if (!sync_parent_directory(path)) {
+    error = "Error al sincronizar el directorio del punto de control: " + path + " (" + std::strerror(errno) + ")";
+    return false;
+  }
+  return true;
+}
+
+bool Checkpoint::load(const std::string& path, std::string& error) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) {
+    error = "No se puede abrir el punto de control: " + path;
+    return false;
+  }
+  std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+  Reader reader(data);
+  std::string magic = reader.get_bytes(sizeof(CHECKPOINT_MAGIC));
+  uint32_t version = reader.get<uint32_t>();
+  if (!reader.ok() || std::memcmp(magic.data(), CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0 ||
+      version != FILE_VERSION) {
+    error = "Punto de control con formato desconocido: " + path;
+    return false;
+  }
+  uint64_t checksum = reader.get<uint64_t>();
+  if (!reader.ok() || ResultCache::hash_bytes(std::string_view(data).substr(HEADER_SIZE)) != checksum) {
+    error = "Suma de comprobación incorrecta (punto de control dañado): " + path;
+    return false;
+  }
+
+  machine_digest = reader.get<uint64_t>();
+  word_index = reader.get<uint64_t>();
+  max_steps = reader.get<uint64_t>();
+  word = reader.get_bytes(reader.get<uint32_t>());
+  state = reader.get<uint32_t>();
+  steps = reader.get<uint64_t>();
+  uint16_t num_tapes = reader.get<uint16_t>();
+  tapes.assign(num_tapes, TapeImage());
+  for (TapeImage& tape : tapes) {
+    tape.head = reader.get<int64_t>();
+    tape.start = reader.get<int64_t>();
+    tape.content = reader.get_bytes(reader.get<uint64_t>());
+  }
+  has_cycle_detector = reader.get<uint8_t>() != 0;
+  cycle_right = CycleSide();
+  cycle_left = CycleSide();
+  if (has_cycle_detector) {
+    for (CycleSide* side : {&cycle_right, &cycle_left}) {
+      side->bound = reader.get<int64_t>();
+      uint32_t num_records = reader.get<uint32_t>();
+      for (uint32_t i = 0; i < num_records && reader.ok(); ++i) {
+        CycleRecord record;
+        record.state = reader.get<uint32_t>();
+        record.position = reader.get<int64_t>();
+        record.reach = reader.get<int64_t>();
+        record.segment = reader.get_bytes(reader.get<uint32_t>());
+        side->records.push_back(std::move(record));
+      }
+    }
+  }
+  uint64_t num_visited = reader.get<uint64_t>();
+  visited.clear();
+  for (uint64_t i = 0; i < num_visited && reader.ok(); ++i) {
+    visited.push_back(reader.get<uint64_t>());
+  }
+
+  if (!reader.ok() || !reader.at_end()) {
+    error = "Punto de control truncado o dañado: " + path;
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Punto de control de una simulación larga (mt-sim --checkpoint / --resume)
+ *
+ * Contiene todo lo necesario para continuar la simulación de una palabra
+ * exactamente donde se dejó: estado, pasos, límite de pasos, imagen compacta
+ * de cada cinta (cabezal, posición inicial y contenido entre el primer y el
+ * último símbolo no blanco), las configuraciones ya visitadas y los récords
+ * del detector de ciclos trasladados (solo monocinta), sin los que la
+ * detección de bucles no daría el mismo resultado en el mismo paso. Sirve
+ * tanto para Configuration (una cinta) como para MultiConfiguration.
+ *
+ * De las configuraciones visitadas solo se guarda su huella FNV-1a de 64 bits
+ * (8 bytes por paso, no la cinta entera de cada paso). Al reanudar, el
+ * simulador las consulta aparte de las claves nuevas; una colisión daría un
+ * INFINITE falso, con probabilidad del orden de n²/2^65 para n pasos.
+ *
+ * Formato del fichero (enteros en el orden de bytes de la máquina): cabecera
+ * "MTCK" + versión (u32) + suma FNV-1a (u64) del resto del fichero, como en
+ * las imágenes de CompiledMachine; después, huella de la máquina (u64), índice de la palabra
+ * (u64), límite de pasos (u64), palabra (u32 longitud + bytes), estado (u32),
+ * pasos (u64), número de cintas (u16) y por cinta cabezal (i64), inicio (i64)
+ * y contenido (u64 longitud + bytes); si hay detector de ciclos (u8), por lado
+ * (derecha e izquierda) el límite (i64), el número de récords (u32) y por
+ * récord estado (u32), posición (i64), alcance (i64) y celdas (u32 longitud +
+ * bytes); por último el número de configuraciones visitadas (u64) y la huella
+ * de cada una (u64).
+ *
+ * save() escribe en un fichero temporal junto al destino, lo sincroniza con
+ * el disco, lo renombra y sincroniza el directorio para que el renombrado
+ * también sobreviva a una caída: un fallo a mitad de escritura deja intacto
+ * el punto de control anterior. load() rechaza un fichero cuya suma no
+ * coincide en lugar de reanudar desde datos dañados.
+ */
+struct Checkpoint {
+  static constexpr uint32_t FILE_VERSION = 5;
+
+  /**
+   * @brief Imagen compacta de una cinta
+   */
+  struct TapeImage {
+    int64_t head = 0;     // Posición del cabezal
+    int64_t start = 0;    // Posición del primer símbolo de content
+    std::string content;  // Contenido (Tape::get_content())
+  };
+
+  /**
+   * @brief Récord del detector de ciclos trasladados (ver TranslatedCycleDetector)
+   */
+  struct CycleRecord {
+    uint32_t state = 0;    // Estado al llegar
+    int64_t position = 0;  // Posición del cabezal
+    int64_t reach = 0;     // Lo más atrás que llegó el cabezal hasta el récord siguiente
+    std::string segment;   // Celdas de detrás del cabezal
+  };
+
+  /**
+   * @brief Un lado del detector de ciclos trasladados
+   */
+  struct CycleSide {
+    int64_t bound = 0;                  // Posición más avanzada por este lado
+    std::vector<CycleRecord> records;   // Récords, del más antiguo al más reciente
+  };
+
+  uint64_t machine_digest = 0;        // Huella del fichero de la máquina
+  uint64_t word_index = 0;            // Índice de la palabra en la entrada
+  std::string word;                   // Palabra de entrada
+  uint64_t max_steps = 0;             // Límite de pasos de la simulación
+  uint32_t state = 0;                 // Estado actual (identificador compilado)
+  uint64_t steps = 0;                 // Pasos ejecutados
+  std::vector<TapeImage> tapes;       // Cintas, en orden
+  bool has_cycle_detector = false;    // Si se guardó el detector de ciclos trasladados
+  CycleSide cycle_right;              // Récords por la derecha
+  CycleSide cycle_left;               // Récords por la izquierda
+  std::vector<uint64_t> visited;      // Huellas FNV-1a de las configuraciones visitadas
+
+  /**
+   * @brief Escribe el punto de control de forma atómica
+   * @param path Fichero de destino
+   * @param error Salida: mensaje de error si no se pudo escribir
+   * @return true si se escribió completo
+   */
+  bool save(const std::string& path, std::string& error) const;
+
+  /**
+   * @brief Lee un punto de control
+   * @param path Fichero a leer
+   * @param error Salida: mensaje de error si no se pudo leer
+   * @return true si el fichero es un punto de control válido
+   */
+  bool load(const std::string& path, std::string& error);
+};
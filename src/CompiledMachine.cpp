@@ -0,0 +1,453 @@
+#include "CompiledMachine.hpp"
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+
+namespace {
+
+const char IMAGE_MAGIC[4] = {'M', 'T', 'M', 'B'};
+
+size_t align8(size_t offset) {
+  return (offset + 7) & ~static_cast<size_t>(7);
+}
+
+void store_bits(const SymbolSet& set, char* out) {
+  uint64_t bits[4] = {0, 0, 0, 0};
+  for (char symbol : set) {
+    unsigned char byte = static_cast<unsigned char>(symbol);
+    bits[byte >> 6] |= uint64_t{1} << (byte & 63);
+  }
+  std::memcpy(out, bits, sizeof(bits));
+}
+
+void load_bits(const char* data, SymbolSet& set) {
+  uint64_t bits[4];
+  std::memcpy(bits, data, sizeof(bits));
+  set.clear();
+  for (int byte = 0; byte < 256; ++byte) {
+    if ((bits[byte >> 6] >> (byte & 63)) & 1u) {
+      set.insert(static_cast<char>(byte));
+    }
+  }
+}
+
+}  // namespace
+
+CompiledMachine::CompiledMachine()
+    : image_(nullptr), header_(), columns_(nullptr), accept_(nullptr),
+      name_offsets_(nullptr), names_(nullptr), from_states_(nullptr),
+      to_states_(nullptr), reads_(nullptr), writes_(nullptr), moves_(nullptr),
+      dense_index_(nullptr), sparse_keys_(nullptr), sparse_ids_(nullptr),
+      dense_stride_(0) {
+}
+
+uint64_t CompiledMachine::dense_entries(uint32_t num_states, uint32_t num_columns,
+                                        uint32_t num_tapes) {
+  uint64_t entries = num_states;
+  for (uint32_t i = 0; i < num_tapes; ++i) {
+    if (num_columns != 0 && entries > DENSE_LIMIT / num_columns) {
+      return DENSE_LIMIT + 1;  // No cabe: se usará la tabla de huellas
+    }
+    entries *= num_columns;
+  }
+  return entries;
+}
+
+CompiledMachine::Layout CompiledMachine::compute_layout(const Header& header) {
+  size_t states = header.num_states;
+  size_t transitions = header.num_transitions;
+  size_t symbols = transitions * header.num_tapes;
+
+  Layout layout;
+  layout.alphabets = 0;
+  layout.columns = layout.alphabets + 64;
+  layout.accept = layout.columns + 256 * sizeof(uint16_t);
+  layout.name_offsets = align8(layout.accept + states);
+  layout.names = align8(layout.name_offsets + (states + 1) * sizeof(uint32_t));
+  layout.from_states = align8(layout.names + header.names_size);
+  layout.to_states = align8(layout.from_states + transitions * sizeof(uint32_t));
+  layout.reads = align8(layout.to_states + transitions * sizeof(uint32_t));
+  layout.writes = align8(layout.reads + symbols);
+  layout.moves = align8(layout.writes + symbols);
+  layout.index = align8(layout.moves + symbols);
+  if (header.dense) {
+    uint64_t entries = dense_entries(header.num_states, header.num_columns, header.num_tapes);
+    layout.index_ids = layout.index;
+    layout.total = align8(layout.index + entries * sizeof(uint32_t));
+  } else {
+    layout.index_ids = layout.index + transitions * sizeof(uint64_t);
+    layout.total = align8(layout.index_ids + transitions * sizeof(uint32_t));
+  }
+  return layout;
+}
+
+uint64_t CompiledMachine::checksum(const char* data, size_t size) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+uint64_t CompiledMachine::key_hash(uint32_t state, const char* symbols, uint32_t num_tapes) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (int shift = 0; shift < 32; shift += 8) {
+    hash ^= (state >> shift) & 0xFF;
+    hash *= 1099511628211ULL;
+  }
+  for (uint32_t i = 0; i < num_tapes; ++i) {
+    hash ^= static_cast<unsigned char>(symbols[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+bool CompiledMachine::compile(const TuringMachine& machine) {
+  if (!machine.is_valid()) {
+    last_error_ = "La máquina de Turing no es válida";
+    return false;
+  }
+
+  std::vector<std::string> states(machine.get_states().begin(), machine.get_states().end());
+  std::vector<std::string> accept(machine.get_accept_states().begin(),
+                                  machine.get_accept_states().end());
+  std::vector<MultiTransition> transitions;
+  for (const Transition& transition : machine.get_all_transitions()) {
+    transitions.push_back(MultiTransition::from_mono_transition(transition, 1));
+  }
+  return build(false, 1, machine.get_blank_symbol(), machine.get_input_alphabet(),
+               machine.get_tape_alphabet(), machine.get_initial_state(), states, accept,
+               transitions);
+}
+
+bool CompiledMachine::compile(const MultiTuringMachine& machine) {
+  if (!machine.is_valid()) {
+    last_error_ = "La máquina de Turing multicinta no es válida";
+    return false;
+  }
+
+  std::vector<std::string> states(machine.get_states().begin(), machine.get_states().end());
+  std::vector<std::string> accept(machine.get_accept_states().begin(),
+                                  machine.get_accept_states().end());
+  return build(true, machine.get_num_tapes(), machine.get_blank_symbol(),
+               machine.get_input_alphabet(), machine.get_tape_alphabet(),
+               machine.get_initial_state(), states, accept, machine.get_all_transitions());
+}
+
+bool CompiledMachine::build(bool multi_tape, size_t num_tapes, char blank,
+                            const SymbolSet& input_alphabet, const SymbolSet& tape_alphabet,
+                            const std::string& initial_state,
+                            const std::vector<std::string>& states,
+                            const std::vector<std::string>& accept_states,
+                            const std::vector<MultiTransition>& transitions) {
+  // Estados en orden alfabético: la imagen no depende del orden de los hashes
+  std::vector<std::string> names(states);
+  std::sort(names.begin(), names.end());
+  std::unordered_map<std::string, uint32_t> ids;
+  size_t names_size = 0;
+  for (uint32_t i = 0; i < names.size(); ++i) {
+    ids[names[i]] = i;
+    names_size += names[i].size();
+  }
+
+  // Transiciones ordenadas por (origen, símbolos leídos)
+  std::vector<size_t> order(transitions.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    uint32_t from_a = ids.at(transitions[a].get_from_state());
+    uint32_t from_b = ids.at(transitions[b].get_from_state());
+    if (from_a != from_b) {
+      return from_a < from_b;
+    }
+    return transitions[a].get_read_symbols() < transitions[b].get_read_symbols();
+  });
+
+  Header header{};
+  std::memcpy(header.magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC));
+  header.version = IMAGE_VERSION;
+  header.num_tapes = static_cast<uint32_t>(num_tapes);
+  header.num_states = static_cast<uint32_t>(names.size());
+  header.num_transitions = static_cast<uint32_t>(transitions.size());
+  header.initial_state = ids.at(initial_state);
+  header.num_columns = static_cast<uint32_t>(tape_alphabet.size());
+  header.names_size = static_cast<uint32_t>(names_size);
+  header.blank_symbol = static_cast<uint8_t>(blank);
+  header.multi_tape = multi_tape ? 1 : 0;
+  header.dense = dense_entries(header.num_states, header.num_columns, header.num_tapes) <= DENSE_LIMIT;
+
+  Layout layout = compute_layout(header);
+  header.payload_size = layout.total;
+
+  mapped_.close();
+  owned_.assign((sizeof(Header) + layout.total + 7) / 8, 0);
+  char* image = reinterpret_cast<char*>(owned_.data());
+  char* payload = image + sizeof(Header);
+
+  store_bits(input_alphabet, payload + layout.alphabets);
+  store_bits(tape_alphabet, payload + layout.alphabets + 32);
+
+  uint16_t columns[256];
+  std::fill(columns, columns + 256, NO_COLUMN);
+  uint16_t next_column = 0;
+  for (char symbol : tape_alphabet) {
+    columns[static_cast<unsigned char>(symbol)] = next_column++;
+  }
+  std::memcpy(payload + layout.columns, columns, sizeof(columns));
+
+  for (const std::string& state : accept_states) {
+    payload[layout.accept + ids.at(state)] = 1;
+  }
+
+  uint32_t* name_offsets = reinterpret_cast<uint32_t*>(payload + layout.name_offsets);
+  uint32_t offset = 0;
+  for (size_t i = 0; i < names.size(); ++i) {
+    name_offsets[i] = offset;
+    std::memcpy(payload + layout.names + offset, names[i].data(), names[i].size());
+    offset += static_cast<uint32_t>(names[i].size());
+  }
+  name_offsets[names.size()] = offset;
+
+  uint32_t* from_states = reinterpret_cast<uint32_t*>(payload + layout.from_states);
+  uint32_t* to_states = reinterpret_cast<uint32_t*>(payload + layout.to_states);
+  for (size_t id = 0; id < order.size(); ++id) {
+    const MultiTransition& transition = transitions[order[id]];
+    from_states[id] = ids.at(transition.get_from_state());
+    to_states[id] = ids.at(transition.get_to_state());
+    for (size_t tape = 0; tape < num_tapes; ++tape) {
+      size_t at = id * num_tapes + tape;
+      payload[layout.reads + at] = transition.get_read_symbol(tape);
+      payload[layout.writes + at] = transition.get_write_symbol(tape);
+      payload[layout.moves + at] = static_cast<char>(transition.get_movement(tape));
+    }
+  }
+
+  header.checksum = 0;
+  std::memcpy(image, &header, sizeof(header));
+  attach(image);
+
+  // Índice de búsqueda (usa las vistas recién preparadas)
+  if (header.dense) {
+    uint32_t* dense = reinterpret_cast<uint32_t*>(payload + layout.index);
+    uint64_t entries = dense_entries(header.num_states, header.num_columns, header.num_tapes);
+    std::fill(dense, dense + entries, NO_TRANSITION);
+    for (uint32_t id = 0; id < header.num_transitions; ++id) {
+      uint64_t entry = 0;
+      uint64_t weight = 1;
+      const char* reads = get_read_symbols(id);
+      for (uint32_t tape = 0; tape < header.num_tapes; ++tape) {
+        entry += columns[static_cast<unsigned char>(reads[tape])] * weight;
+        weight *= header.num_columns;
+      }
+      dense[from_states[id] * dense_stride_ + entry] = id;
+    }
+  } else {
+    std::vector<std::pair<uint64_t, uint32_t>> keys(header.num_transitions);
+    for (uint32_t id = 0; id < header.num_transitions; ++id) {
+      keys[id] = {key_hash(from_states[id], get_read_symbols(id), header.num_tapes), id};
+    }
+    std::sort(keys.begin(), keys.end());
+    uint64_t* sparse_keys = reinterpret_cast<uint64_t*>(payload + layout.index);
+    uint32_t* sparse_ids = reinterpret_cast<uint32_t*>(payload + layout.index_ids);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      sparse_keys[i] = keys[i].first;
+      sparse_ids[i] = keys[i].second;
+    }
+  }
+
+  header_.checksum = checksum(payload, layout.total);
+  std::memcpy(image, &header_, sizeof(header_));
+  last_error_.clear();
+  return true;
+}
+
+void CompiledMachine::attach(const char* image) {
+  image_ = image;
+  std::memcpy(&header_, image, sizeof(header_));
+  Layout layout = compute_layout(header_);
+  const char* payload = image + sizeof(Header);
+
+  load_bits(payload + layout.alphabets, input_alphabet_);
+  load_bits(payload + layout.alphabets + 32, tape_alphabet_);
+  columns_ = reinterpret_cast<const uint16_t*>(payload + layout.columns);
+  accept_ = reinterpret_cast<const uint8_t*>(payload + layout.accept);
+  name_offsets_ = reinterpret_cast<const uint32_t*>(payload + layout.name_offsets);
+  names_ = payload + layout.names;
+  from_states_ = reinterpret_cast<const uint32_t*>(payload + layout.from_states);
+  to_states_ = reinterpret_cast<const uint32_t*>(payload + layout.to_states);
+  reads_ = payload + layout.reads;
+  writes_ = payload + layout.writes;
+  moves_ = reinterpret_cast<const uint8_t*>(payload + layout.moves);
+
+  if (header_.dense) {
+    dense_index_ = reinterpret_cast<const uint32_t*>(payload + layout.index);
+    dense_stride_ = dense_entries(1, header_.num_columns, header_.num_tapes);
+    sparse_keys_ = nullptr;
+    sparse_ids_ = nullptr;
+  } else {
+    dense_index_ = nullptr;
+    dense_stride_ = 0;
+    sparse_keys_ = reinterpret_cast<const uint64_t*>(payload + layout.index);
+    sparse_ids_ = reinterpret_cast<const uint32_t*>(payload + layout.index_ids);
+  }
+}
+
+uint32_t CompiledMachine::find_sparse(uint32_t state, const char* symbols) const {
+  uint64_t key = key_hash(state, symbols, header_.num_tapes);
+  const uint64_t* end = sparse_keys_ + header_.num_transitions;
+  for (const uint64_t* it = std::lower_bound(sparse_keys_, end, key);
+       it != end && *it == key; ++it) {
+    uint32_t id = sparse_ids_[it - sparse_keys_];
+    if (from_states_[id] == state &&
+        std::memcmp(get_read_symbols(id), symbols, header_.num_tapes) == 0) {
+      return id;
+    }
+  }
+  return NO_TRANSITION;
+}
+
+uint32_t CompiledMachine::find_state(std::string_view name) const {
+  // Los nombres están ordenados: búsqueda binaria
+  uint32_t low = 0;
+  uint32_t high = header_.num_states;
+  while (low < high) {
+    uint32_t mid = low + (high - low) / 2;
+    std::string_view candidate = get_state_name(mid);
+    if (candidate == name) {
+      return mid;
+    }
+    if (candidate < name) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return NO_TRANSITION;
+}
+
+bool CompiledMachine::load_image(const std::string& path) {
+  MappedFile file;
+  if (!file.open(path, false)) {
+    last_error_ = file.get_last_error();
+    return false;
+  }
+
+  std::string_view data = file.view();
+  Header header;
+  if (data.size() < sizeof(Header)) {
+    last_error_ = "Imagen compilada truncada: " + path;
+    return false;
+  }
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (std::memcmp(header.magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC)) != 0) {
+    last_error_ = "No es una imagen compilada: " + path;
+    return false;
+  }
+  if (header.version != IMAGE_VERSION) {
+    last_error_ = "Versión de imagen no soportada (" + std::to_string(header.version) +
+                  "): " + path + ". Vuelve a compilar la máquina";
+    return false;
+  }
+  if (header.num_tapes == 0 || header.num_states == 0 ||
+      header.initial_state >= header.num_states || header.num_columns > 256 ||
+      header.payload_size != data.size() - sizeof(Header) ||
+      compute_layout(header).total != header.payload_size) {
+    last_error_ = "Cabecera de imagen inconsistente: " + path;
+    return false;
+  }
+  if (checksum(data.data() + sizeof(Header), header.payload_size) != header.checksum) {
+    last_error_ = "Suma de comprobación incorrecta (imagen dañada): " + path;
+    return false;
+  }
+
+  owned_.clear();
+  owned_.shrink_to_fit();
+  mapped_ = std::move(file);
+  attach(mapped_.view().data());
+  last_error_.clear();
+  return true;
+}
+
+bool CompiledMachine::save_image(const std::string& path) const {
+  if (image_ == nullptr) {
+    return false;
+  }
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    return false;
+  }
+  out.write(image_, static_cast<std::streamsize>(sizeof(Header) + header_.payload_size));
+  return static_cast<bool>(out);
+}
+
+bool CompiledMachine::is_image_file(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  char magic[4];
+  return in.read(magic, sizeof(magic)) &&
+         std::memcmp(magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC)) == 0;
+}
+
+bool CompiledMachine::to_machine(TuringMachine& machine) const {
+  if (image_ == nullptr || header_.num_tapes != 1) {
+    return false;
+  }
+
+  machine = TuringMachine(get_blank_symbol());
+  for (uint32_t state = 0; state < header_.num_states; ++state) {
+    machine.add_state(std::string(get_state_name(state)));
+  }
+  for (char symbol : tape_alphabet_) {
+    machine.add_tape_symbol(symbol);
+  }
+  for (char symbol : input_alphabet_) {
+    machine.add_input_symbol(symbol);
+  }
+  machine.set_initial_state(std::string(get_state_name(header_.initial_state)));
+  for (uint32_t state = 0; state < header_.num_states; ++state) {
+    if (is_accept_state(state)) {
+      machine.add_accept_state(std::string(get_state_name(state)));
+    }
+  }
+  for (uint32_t id = 0; id < header_.num_transitions; ++id) {
+    machine.add_transition(std::string(get_state_name(from_states_[id])), reads_[id],
+                           std::string(get_state_name(to_states_[id])), writes_[id],
+                           get_movement(id, 0));
+  }
+  return true;
+}
+
+void CompiledMachine::to_multi_machine(MultiTuringMachine& machine) const {
+  size_t num_tapes = header_.num_tapes;
+  machine = MultiTuringMachine(num_tapes, get_blank_symbol());
+  if (image_ == nullptr) {
+    return;
+  }
+
+  for (uint32_t state = 0; state < header_.num_states; ++state) {
+    machine.add_state(std::string(get_state_name(state)));
+  }
+  for (char symbol : tape_alphabet_) {
+    machine.add_tape_symbol(symbol);
+  }
+  for (char symbol : input_alphabet_) {
+    machine.add_input_symbol(symbol);
+  }
+  machine.set_initial_state(std::string(get_state_name(header_.initial_state)));
+  for (uint32_t state = 0; state < header_.num_states; ++state) {
+    if (is_accept_state(state)) {
+      machine.add_accept_state(std::string(get_state_name(state)));
+    }
+  }
+  for (uint32_t id = 0; id < header_.num_transitions; ++id) {
+    std::vector<char> reads(get_read_symbols(id), get_read_symbols(id) + num_tapes);
+    std::vector<char> writes(get_write_symbols(id), get_write_symbols(id) + num_tapes);
+    std::vector<Movement> moves;
+    for (size_t tape = 0; tape < num_tapes; ++tape) {
+      moves.push_back(get_movement(id, tape));
+    }
+    machine.add_transition(std::string(get_state_name(from_states_[id])), reads,
+                           std::string(get_state_name(to_states_[id])), writes, moves);
+  }
+}
@@ -0,0 +1,253 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MappedFile.hpp"
+#include "MultiTuringMachine.hpp"
+#include "SymbolSet.hpp"
+#include "TuringMachine.hpp"
+
+/**
+ * @brief Forma compilada de una máquina (monocinta o multicinta) lista para simular
+ *
+ * Los estados se internan como enteros (orden alfabético de sus nombres) y las
+ * transiciones se numeran por (estado origen, símbolos leídos). La búsqueda de
+ * la transición aplicable usa:
+ * - Una tabla densa estado × columna^k, donde la columna de un símbolo es su
+ *   posición en el alfabeto de cinta, si cabe en DENSE_LIMIT entradas.
+ * - En otro caso (muchas cintas o alfabetos grandes), una tabla ordenada de
+ *   huellas (estado, símbolos) con búsqueda binaria.
+ *
+ * Toda la máquina vive en una única imagen binaria contigua, la misma que se
+ * guarda con save_image(). Al cargar un fichero .tmb con load_image() la imagen
+ * se proyecta en memoria y se usa tal cual: solo se validan la cabecera y la
+ * suma de comprobación, sin parsear nada.
+ *
+ * Formato de la imagen (enteros en el orden de bytes del anfitrión):
+ *   cabecera (56 bytes): "MTMB", versión (u32), cintas (u32), estados (u32),
+ *     transiciones (u32), estado inicial (u32), columnas (u32), bytes de
+ *     nombres (u32), blanco (u8), tabla densa (u8), multicinta (u8), 5 bytes
+ *     reservados,
+ *     tamaño de la carga (u64) y suma FNV-1a de la carga (u64).
+ *   carga, con cada sección alineada a 8 bytes:
+ *     alfabeto de entrada y de cinta (2 × 32 bytes de bits), columna de cada
+ *     byte (u16 × 256), estados de aceptación (u8 por estado), desplazamientos
+ *     de los nombres (u32 × (estados + 1)) y nombres, y por transición: estado
+ *     origen (u32), destino (u32), k símbolos leídos, k escritos y k movimientos.
+ *     Al final, la tabla densa (u32 por entrada) o las huellas ordenadas (u64)
+ *     con sus transiciones (u32).
+ *
+ * Las imágenes son artefactos generados por `mt-sim compile`: la suma de
+ * comprobación detecta ficheros dañados, no imágenes manipuladas.
+ */
+class CompiledMachine {
+public:
+  static constexpr uint32_t NO_TRANSITION = 0xFFFFFFFFu;
+  static constexpr uint16_t NO_COLUMN = 0xFFFF;
+  static constexpr uint32_t IMAGE_VERSION = 1;
+  static constexpr uint64_t DENSE_LIMIT = 1u << 22;  // Entradas máximas de la tabla densa
+
+private:
+  struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t num_tapes;
+    uint32_t num_states;
+    uint32_t num_transitions;
+    uint32_t initial_state;
+    uint32_t num_columns;
+    uint32_t names_size;
+    uint8_t blank_symbol;
+    uint8_t dense;
+    uint8_t multi_tape;
+    uint8_t reserved[5];
+    uint64_t payload_size;
+    uint64_t checksum;
+  };
+
+  /**
+   * @brief Desplazamientos de cada sección dentro de la carga
+   */
+  struct Layout {
+    size_t alphabets, columns, accept, name_offsets, names;
+    size_t from_states, to_states, reads, writes, moves;
+    size_t index, index_ids, total;
+  };
+
+  std::vector<uint64_t> owned_;  // Imagen compilada en memoria (alineada a 8)
+  MappedFile mapped_;            // Imagen proyectada desde un .tmb
+  const char* image_;            // Inicio de la imagen (cabecera incluida)
+  Header header_;                // Copia de la cabecera
+
+  // Vistas sobre la carga de la imagen
+  const uint16_t* columns_;
+  const uint8_t* accept_;
+  const uint32_t* name_offsets_;
+  const char* names_;
+  const uint32_t* from_states_;
+  const uint32_t* to_states_;
+  const char* reads_;
+  const char* writes_;
+  const uint8_t* moves_;
+  const uint32_t* dense_index_;
+  const uint64_t* sparse_keys_;
+  const uint32_t* sparse_ids_;
+  uint64_t dense_stride_;        // Entradas de la tabla densa por estado
+
+  SymbolSet input_alphabet_;     // Σ
+  SymbolSet tape_alphabet_;      // Γ
+  std::string last_error_;       // Último error ocurrido
+
+  static Layout compute_layout(const Header& header);
+  static uint64_t dense_entries(uint32_t num_states, uint32_t num_columns, uint32_t num_tapes);
+  static uint64_t checksum(const char* data, size_t size);
+  static uint64_t key_hash(uint32_t state, const char* symbols, uint32_t num_tapes);
+
+  /**
+   * @brief Construye la imagen a partir de los datos genéricos de una máquina
+   */
+  bool build(bool multi_tape, size_t num_tapes, char blank, const SymbolSet& input_alphabet,
+             const SymbolSet& tape_alphabet, const std::string& initial_state,
+             const std::vector<std::string>& states,
+             const std::vector<std::string>& accept_states,
+             const std::vector<MultiTransition>& transitions);
+
+  /**
+   * @brief Prepara las vistas sobre una imagen ya validada
+   */
+  void attach(const char* image);
+
+  /**
+   * @brief Busca una transición en la tabla de huellas
+   */
+  uint32_t find_sparse(uint32_t state, const char* symbols) const;
+
+public:
+  /**
+   * @brief Constructor de una máquina vacía (sin imagen)
+   */
+  CompiledMachine();
+
+  CompiledMachine(const CompiledMachine&) = delete;
+  CompiledMachine& operator=(const CompiledMachine&) = delete;
+
+  /**
+   * @brief Compila una máquina monocinta
+   * @param machine Máquina a compilar (debe ser válida)
+   * @return true si se pudo compilar
+   */
+  bool compile(const TuringMachine& machine);
+
+  /**
+   * @brief Compila una máquina multicinta
+   * @param machine Máquina a compilar (debe ser válida)
+   * @return true si se pudo compilar
+   */
+  bool compile(const MultiTuringMachine& machine);
+
+  /**
+   * @brief Carga una imagen .tmb proyectándola en memoria
+   * @param path Ruta del fichero
+   * @return true si la cabecera y la suma de comprobación son correctas
+   */
+  bool load_image(const std::string& path);
+
+  /**
+   * @brief Guarda la imagen en un fichero .tmb
+   * @param path Ruta del fichero
+   * @return true si se pudo escribir
+   */
+  bool save_image(const std::string& path) const;
+
+  /**
+   * @brief Verifica si un fichero empieza con la firma de una imagen compilada
+   * @param path Ruta del fichero
+   * @return true si es una imagen .tmb
+   */
+  static bool is_image_file(const std::string& path);
+
+  /**
+   * @brief Reconstruye la definición monocinta (para --info o para guardarla)
+   * @param machine Máquina de destino
+   * @return false si la imagen es multicinta
+   */
+  bool to_machine(TuringMachine& machine) const;
+
+  /**
+   * @brief Reconstruye la definición multicinta
+   * @param machine Máquina de destino
+   */
+  void to_multi_machine(MultiTuringMachine& machine) const;
+
+  /**
+   * @brief Busca la transición aplicable
+   * @param state Estado actual
+   * @param symbols Símbolos bajo cada cabezal (num_tapes símbolos)
+   * @return Número de transición o NO_TRANSITION
+   */
+  uint32_t find_transition(uint32_t state, const char* symbols) const {
+    if (dense_index_ == nullptr) {
+      return find_sparse(state, symbols);
+    }
+    uint64_t entry = 0;
+    uint64_t weight = 1;
+    for (uint32_t i = 0; i < header_.num_tapes; ++i) {
+      uint16_t column = columns_[static_cast<unsigned char>(symbols[i])];
+      if (column == NO_COLUMN) {
+        return NO_TRANSITION;
+      }
+      entry += column * weight;
+      weight *= header_.num_columns;
+    }
+    return dense_index_[state * dense_stride_ + entry];
+  }
+
+  /**
+   * @brief Busca un estado por su nombre
+   * @param name Nombre del estado
+   * @return Identificador o NO_TRANSITION si no existe
+   */
+  uint32_t find_state(std::string_view name) const;
+
+  bool is_loaded() const { return image_ != nullptr; }
+  size_t get_num_tapes() const { return header_.num_tapes; }
+  size_t get_num_states() const { return header_.num_states; }
+  size_t get_transition_count() const { return header_.num_transitions; }
+  uint32_t get_initial_state() const { return header_.initial_state; }
+  char get_blank_symbol() const { return static_cast<char>(header_.blank_symbol); }
+  bool is_dense() const { return dense_index_ != nullptr; }
+  bool is_multi_tape() const { return header_.multi_tape != 0; }
+  bool is_accept_state(uint32_t state) const { return accept_[state] != 0; }
+
+  std::string_view get_state_name(uint32_t state) const {
+    return std::string_view(names_ + name_offsets_[state],
+                            name_offsets_[state + 1] - name_offsets_[state]);
+  }
+
+  uint32_t get_from_state(uint32_t transition) const { return from_states_[transition]; }
+  uint32_t get_to_state(uint32_t transition) const { return to_states_[transition]; }
+  const char* get_read_symbols(uint32_t transition) const {
+    return reads_ + static_cast<size_t>(transition) * header_.num_tapes;
+  }
+  const char* get_write_symbols(uint32_t transition) const {
+    return writes_ + static_cast<size_t>(transition) * header_.num_tapes;
+  }
+  Movement get_movement(uint32_t transition, size_t tape_index) const {
+    return static_cast<Movement>(moves_[static_cast<size_t>(transition) * header_.num_tapes + tape_index]);
+  }
+
+  const SymbolSet& get_input_alphabet() const { return input_alphabet_; }
+  const SymbolSet& get_tape_alphabet() const { return tape_alphabet_; }
+
+  bool is_valid_input_word(std::string_view word) const {
+    return input_alphabet_.contains_all(word);
+  }
+
+  size_t find_invalid_input_symbol(std::string_view word) const {
+    return input_alphabet_.find_first_not_in(word);
+  }
+
+  const std::string& get_last_error() const { return last_error_; }
+};
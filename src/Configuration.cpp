@@ -2,7 +2,7 @@
 #include <sstream>
 
 Configuration::Configuration(const std::string& initial_state, 
-                             const std::string& input_string, 
+                             std::string_view input_string, 
                              char blank_symbol)
     : current_state_(initial_state), 
       tape_(input_string, blank_symbol),
@@ -32,7 +32,7 @@ const std::string& Configuration::get_current_state() const {
   return current_state_;
 }
 
-void Configuration::set_current_state(const std::string& state) {
+void Configuration::set_current_state(std::string_view state) {
   current_state_ = state;
 }
 
@@ -73,8 +73,11 @@ std::string Configuration::to_string(bool show_tape_window, int window_size) con
 
 std::string Configuration::to_compact_string() const {
   std::ostringstream oss;
+  // Sin el inicio del contenido, el mismo contenido desplazado daría la
+  // misma clave y se tomaría por una configuración repetida
   oss << current_state_ << "|" 
       << tape_.get_head_position() << "|" 
+      << tape_.get_content_start() << "|"
       << tape_.get_content();
   return oss.str();
 }
@@ -83,7 +86,7 @@ bool Configuration::is_equivalent(const Configuration& other) const {
   // Dos configuraciones son equivalentes si tienen:
   // 1. El mismo estado actual
   // 2. La misma posición del cabezal
-  // 3. El mismo contenido en la cinta
+  // 3. El mismo contenido en la cinta, empezando en la misma celda
   
   if (current_state_ != other.current_state_) {
     return false;
@@ -93,19 +96,16 @@ bool Configuration::is_equivalent(const Configuration& other) const {
     return false;
   }
   
-  // Comparar el contenido de las cintas
-  std::string content1 = tape_.get_content();
-  std::string content2 = other.tape_.get_content();
-  
-  return content1 == content2;
+  // Comparar el contenido de las cintas (sin construir las cadenas)
+  return tape_.has_same_content(other.tape_);
 }
 
 bool Configuration::operator==(const Configuration& other) const {
   return is_equivalent(other);
 }
 
-void Configuration::reset(const std::string& initial_state, 
-                         const std::string& input_string) {
+void Configuration::reset(std::string_view initial_state, 
+                         std::string_view input_string) {
   current_state_ = initial_state;
   tape_.reset(input_string);
   step_count_ = 0;
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include "Tape.hpp"
 
 /**
@@ -24,7 +25,7 @@ public:
    * @param blank_symbol Símbolo blanco de la cinta
    */
   Configuration(const std::string& initial_state, 
-                const std::string& input_string = "", 
+                std::string_view input_string = "", 
                 char blank_symbol = '.');
 
   /**
@@ -55,7 +56,7 @@ public:
    * @brief Establece el estado actual de la máquina
    * @param state Nuevo estado
    */
-  void set_current_state(const std::string& state);
+  void set_current_state(std::string_view state);
 
   /**
    * @brief Obtiene una referencia a la cinta
@@ -96,7 +97,7 @@ public:
 
   /**
    * @brief Obtiene una representación compacta de la configuración
-   * Formato: "estado|posición_cabezal|contenido_cinta"
+   * Formato: "estado|posición_cabezal|inicio_contenido|contenido_cinta"
    * @return String con la representación compacta
    */
   std::string to_compact_string() const;
@@ -104,7 +105,8 @@ public:
   /**
    * @brief Verifica si dos configuraciones son equivalentes
    * Dos configuraciones son equivalentes si tienen el mismo estado,
-   * la misma posición del cabezal y el mismo contenido en la cinta
+   * la misma posición del cabezal y el mismo contenido en la cinta, en las
+   * mismas celdas
    * @param other Configuración a comparar
    * @return true si las configuraciones son equivalentes
    */
@@ -122,5 +124,5 @@ public:
    * @param initial_state Nuevo estado inicial
    * @param input_string Nueva cadena de entrada
    */
-  void reset(const std::string& initial_state, const std::string& input_string = "");
+  void reset(std::string_view initial_state, std::string_view input_string = "");
 };
\ No newline at end of file
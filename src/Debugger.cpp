@@ -0,0 +1,443 @@
+#include "Debugger.hpp"
+#include <sstream>
+
+Debugger::Debugger(Simulator* simulator, MultiSimulator* multi_simulator)
+    : simulator_(simulator, multi_simulator), watch_writes_(false), watch_boundaries_(false),
+      halted_(false), cancellation_(nullptr) {
+}
+
+bool Debugger::start(std::string_view word) {
+  if (!simulator_.start(word, false, 0)) {
+    last_error_ = simulator_.get_last_error();
+    return false;
+  }
+  snapshot_steps_.clear();
+  snapshots_.clear();
+  multi_snapshots_.clear();
+  events_.clear();
+  halted_ = false;
+  take_snapshot();
+  return true;
+}
+
+void Debugger::take_snapshot() {
+  size_t now = simulator_.step_count();
+  if (!snapshot_steps_.empty() && snapshot_steps_.back() >= now) {
+    return;
+  }
+  snapshot_steps_.push_back(now);
+  if (simulator_.is_multi_tape()) {
+    multi_snapshots_.push_back(simulator_.get_multi_simulator()->get_current_configuration());
+  } else {
+    snapshots_.push_back(simulator_.get_simulator()->get_current_configuration());
+  }
+
+  // Aclarado: la copia del paso 0 y la actual se conservan siempre
+  size_t kept = 0;
+  for (size_t i = 0; i < snapshot_steps_.size(); ++i) {
+    size_t step = snapshot_steps_[i];
+    bool keep = step == 0 || step == now;
+    if (!keep) {
+      size_t slot = step / SNAPSHOT_SPACING;
+      size_t reach = SNAPSHOT_SPACING * 2 * (slot & (~slot + 1));  // SPACING·2^(nivel+1)
+      keep = step + reach > now;
+    }
+    if (!keep) {
+      continue;
+    }
+    if (kept != i) {
+      snapshot_steps_[kept] = snapshot_steps_[i];
+      if (simulator_.is_multi_tape()) {
+        multi_snapshots_[kept] = multi_snapshots_[i];
+      } else {
+        snapshots_[kept] = snapshots_[i];
+      }
+    }
+    kept++;
+  }
+  snapshot_steps_.resize(kept);
+  if (simulator_.is_multi_tape()) {
+    multi_snapshots_.erase(multi_snapshots_.begin() + static_cast<std::ptrdiff_t>(kept), multi_snapshots_.end());
+  } else {
+    snapshots_.erase(snapshots_.begin() + static_cast<std::ptrdiff_t>(kept), snapshots_.end());
+  }
+}
+
+void Debugger::restore_snapshot(size_t index, bool discard_later) {
+  if (simulator_.is_multi_tape()) {
+    simulator_.get_multi_simulator()->set_configuration(multi_snapshots_[index]);
+  } else {
+    simulator_.get_simulator()->set_configuration(snapshots_[index]);
+  }
+  halted_ = false;
+  if (discard_later) {
+    snapshot_steps_.resize(index + 1);
+    if (simulator_.is_multi_tape()) {
+      multi_snapshots_.erase(multi_snapshots_.begin() + static_cast<std::ptrdiff_t>(index + 1),
+                             multi_snapshots_.end());
+    } else {
+      snapshots_.erase(snapshots_.begin() + static_cast<std::ptrdiff_t>(index + 1), snapshots_.end());
+    }
+  }
+}
+
+size_t Debugger::snapshot_before(size_t step) const {
+  size_t index = 0;
+  while (index + 1 < snapshot_steps_.size() && snapshot_steps_[index + 1] <= step) {
+    index++;
+  }
+  return index;
+}
+
+size_t Debugger::step(size_t count) {
+  size_t done = 0;
+  while (done < count && !halted_) {
+    if (simulator_.is_accepting() || !simulator_.step()) {
+      halted_ = true;
+      break;
+    }
+    done++;
+    if (simulator_.step_count() % SNAPSHOT_SPACING == 0) {
+      take_snapshot();
+    }
+  }
+  return done;
+}
+
+bool Debugger::go_to_step(size_t target) {
+  if (target < simulator_.step_count()) {
+    restore_snapshot(snapshot_before(target), true);
+  }
+  while (simulator_.step_count() < target) {
+    if (step(1) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Debugger::continue_forward() {
+  events_.clear();
+  if (halted_) {
+    return false;
+  }
+
+  // Un SLICE por paso para mirar los puntos de ruptura y las copias; los
+  // eventos vigilados de un paso llegan antes que su SLICE
+  SimulationGenerator generator(simulator_);
+  generator.set_raw_steps();
+  generator.set_yield_every(1);
+  for (const std::string& state : watched_states_) {
+    generator.watch_state(state);
+  }
+  generator.watch_writes(watch_writes_);
+  generator.watch_boundaries(watch_boundaries_);
+  while (generator.next()) {
+    const SimulationEvent& event = generator.get_event();
+    switch (event.kind) {
+      case SimulationEventKind::FINISHED:
+        halted_ = true;
+        return false;
+      case SimulationEventKind::SLICE:
+        if (simulator_.step_count() % SNAPSHOT_SPACING == 0) {
+          take_snapshot();
+        }
+        if (!events_.empty() || at_breakpoint()) {
+          return true;
+        }
+        if (interrupted()) {
+          return false;
+        }
+        break;
+      default:
+        events_.push_back(event);
+        break;
+    }
+  }
+  return false;
+}
+
+bool Debugger::continue_backward() {
+  size_t now = simulator_.step_count();
+  if (now == 0) {
+    return false;
+  }
+
+  // Se recorren los tramos entre copias de atrás hacia delante de la
+  // posición: en cada uno se resimula buscando el último punto que se cumple
+  size_t end = now;
+  size_t index = snapshot_before(now - 1);
+  while (true) {
+    restore_snapshot(index, false);
+    bool found = false;
+    size_t hit = 0;
+    while (simulator_.step_count() < end && !interrupted()) {
+      if (at_breakpoint()) {
+        found = true;
+        hit = simulator_.step_count();
+      }
+      if (simulator_.is_accepting() || !simulator_.step()) {
+        break;
+      }
+    }
+    if (found || index == 0 || interrupted()) {
+      // La búsqueda movió el simulador: se coloca en el punto encontrado, en
+      // el paso 0 o, si se interrumpió, donde estaba
+      size_t target = found ? hit : interrupted() ? now : 0;
+      restore_snapshot(snapshot_before(target), true);
+      go_to_step(target);
+      return found;
+    }
+    end = snapshot_steps_[index];
+    index--;
+  }
+}
+
+bool Debugger::run_until_state(std::string_view state) {
+  while (simulator_.state() != state) {
+    if (step(1) == 0 || interrupted()) {
+      return simulator_.state() == state;
+    }
+  }
+  return true;
+}
+
+void Debugger::clear_watches() {
+  watched_states_.clear();
+  watch_writes_ = false;
+  watch_boundaries_ = false;
+}
+
+void Debugger::add_breakpoint(const Breakpoint& breakpoint) {
+  breakpoints_.push_back(breakpoint);
+}
+
+bool Debugger::at_breakpoint() const {
+  if (breakpoints_.empty()) {
+    return false;
+  }
+  std::string_view state = simulator_.state();
+  std::string symbols;
+  for (const Breakpoint& breakpoint : breakpoints_) {
+    if (breakpoint.state != state) {
+      continue;
+    }
+    if (breakpoint.symbols.empty()) {
+      return true;
+    }
+    if (symbols.empty()) {
+      symbols = simulator_.symbols();
+    }
+    if (breakpoint.symbols.size() != symbols.size()) {
+      continue;
+    }
+    bool match = true;
+    for (size_t i = 0; i < symbols.size() && match; ++i) {
+      match = breakpoint.symbols[i] == '*' || breakpoint.symbols[i] == symbols[i];
+    }
+    if (match) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Debugger::set_cancellation_token(CancellationToken* token) {
+  cancellation_ = token;
+}
+
+void Debugger::print_status(std::ostream& out) const {
+  out << simulator_.to_string() << "\n";
+  if (halted_) {
+    out << "[Detenida] " << (simulator_.is_accepting() ? "ACCEPT" : "REJECT (sin transición aplicable)") << "\n";
+  }
+}
+
+void Debugger::print_events(std::ostream& out) const {
+  for (const SimulationEvent& event : events_) {
+    switch (event.kind) {
+      case SimulationEventKind::STATE_ENTERED:
+        out << "[Estado] " << simulator_.state() << "\n";  // Se detuvo en ese paso
+        break;
+      case SimulationEventKind::CELL_WRITTEN:
+        out << "[Escritura] cinta " << (event.tape + 1) << ", celda " << event.position
+            << ": '" << event.symbol << "'\n";
+        break;
+      case SimulationEventKind::BOUNDARY_CROSSED:
+        out << "[Celda nueva] cinta " << (event.tape + 1) << ", celda " << event.position << "\n";
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+bool Debugger::execute(const std::string& line, std::ostream& out) {
+  std::istringstream words(line);
+  std::string command;
+  if (!(words >> command)) {
+    return true;
+  }
+
+  // Argumento numérico opcional
+  auto number = [&words](size_t fallback, size_t& value) {
+    std::string text;
+    if (!(words >> text)) {
+      value = fallback;
+      return true;
+    }
+    if (text.find_first_not_of("0123456789") != std::string::npos) {
+      return false;
+    }
+    value = static_cast<size_t>(std::stoull(text));
+    return true;
+  };
+
+  size_t count = 0;
+  if (command == "s" || command == "step") {
+    if (!number(1, count)) {
+      out << "[Error] step requiere un número de pasos\n";
+      return true;
+    }
+    step(count);
+  } else if (command == "b" || command == "back" || command == "rstep") {
+    if (!number(1, count)) {
+      out << "[Error] back requiere un número de pasos\n";
+      return true;
+    }
+    go_to_step(simulator_.step_count() > count ? simulator_.step_count() - count : 0);
+  } else if (command == "c" || command == "continue") {
+    if (continue_forward() && at_breakpoint()) {
+      out << "[Punto de ruptura]\n";
+    }
+    print_events(out);
+  } else if (command == "rc" || command == "rcontinue") {
+    if (continue_backward()) {
+      out << "[Punto de ruptura]\n";
+    }
+  } else if (command == "goto" || command == "until-step") {
+    if (!(words >> count) || !go_to_step(count)) {
+      out << "[Aviso] No se llegó al paso pedido\n";
+    }
+  } else if (command == "until" || command == "until-state") {
+    std::string state;
+    if (!(words >> state)) {
+      out << "[Error] until requiere un estado\n";
+      return true;
+    }
+    if (!run_until_state(state)) {
+      out << "[Aviso] No se llegó al estado " << state << "\n";
+    }
+  } else if (command == "break") {
+    Breakpoint breakpoint;
+    if (!(words >> breakpoint.state)) {
+      out << "[Error] break requiere un estado y, opcionalmente, los símbolos\n";
+      return true;
+    }
+    words >> breakpoint.symbols;
+    add_breakpoint(breakpoint);
+    out << "Punto de ruptura " << breakpoints_.size() << ": " << breakpoint.state << " "
+        << (breakpoint.symbols.empty() ? "*" : breakpoint.symbols) << "\n";
+    return true;
+  } else if (command == "watch") {
+    std::string what;
+    words >> what;
+    if (what == "state") {
+      std::string state;
+      if (!(words >> state)) {
+        out << "[Error] watch state requiere un estado\n";
+        return true;
+      }
+      watch_state(state);
+    } else if (what == "writes") {
+      watch_writes();
+    } else if (what == "bounds") {
+      watch_boundaries();
+    } else {
+      out << "[Error] watch requiere state <estado>, writes o bounds\n";
+    }
+    return true;
+  } else if (command == "unwatch") {
+    clear_watches();
+    return true;
+  } else if (command == "delete") {
+    if (!(words >> count)) {
+      breakpoints_.clear();
+    } else if (count >= 1 && count <= breakpoints_.size()) {
+      breakpoints_.erase(breakpoints_.begin() + static_cast<std::ptrdiff_t>(count - 1));
+    } else {
+      out << "[Error] No existe el punto de ruptura " << count << "\n";
+    }
+    return true;
+  } else if (command == "info") {
+    for (size_t i = 0; i < breakpoints_.size(); ++i) {
+      out << "Punto de ruptura " << (i + 1) << ": " << breakpoints_[i].state << " "
+          << (breakpoints_[i].symbols.empty() ? "*" : breakpoints_[i].symbols) << "\n";
+    }
+    for (const std::string& state : watched_states_) {
+      out << "Vigilado: estado " << state << "\n";
+    }
+    if (watch_writes_) {
+      out << "Vigilado: escrituras\n";
+    }
+    if (watch_boundaries_) {
+      out << "Vigilado: celdas nuevas\n";
+    }
+    out << "Copias guardadas: " << snapshot_steps_.size() << " (pasos";
+    for (size_t step : snapshot_steps_) {
+      out << " " << step;
+    }
+    out << ")\n";
+    return true;
+  } else if (command == "p" || command == "print") {
+    // Solo se muestra el estado
+  } else if (command == "q" || command == "quit") {
+    return false;
+  } else if (command == "h" || command == "help") {
+    out << "Órdenes:\n"
+        << "  s, step [N]          Avanza N pasos (1)\n"
+        << "  b, back [N]          Retrocede N pasos (1)\n"
+        << "  c, continue          Avanza hasta un punto de ruptura o la parada\n"
+        << "  rc, rcontinue        Retrocede hasta el punto de ruptura anterior o el paso 0\n"
+        << "  until <estado>       Avanza hasta llegar al estado\n"
+        << "  goto <paso>          Va al paso indicado (hacia delante o hacia atrás)\n"
+        << "  break <estado> [sím] Punto de ruptura; un símbolo por cinta, '*' = cualquiera\n"
+        << "  delete [n]           Borra el punto n (o todos)\n"
+        << "  watch state <estado> continue para al llegar al estado\n"
+        << "  watch writes         continue para al cambiar el símbolo de una celda\n"
+        << "  watch bounds         continue para cuando un cabezal pisa una celda nueva\n"
+        << "  unwatch              Deja de vigilar\n"
+        << "  info                 Puntos de ruptura y copias guardadas\n"
+        << "  p, print             Configuración actual\n"
+        << "  q, quit              Termina\n"
+        << "Ctrl-C interrumpe continue, rcontinue, until y goto.\n";
+    return true;
+  } else {
+    out << "[Error] Orden desconocida: " << command << " (help para la lista)\n";
+    return true;
+  }
+
+  if (interrupted()) {
+    out << "[Interrumpido]\n";
+  }
+  print_status(out);
+  return true;
+}
+
+void Debugger::run_repl(std::istream& in, std::ostream& out) {
+  print_status(out);
+  std::string line;
+  while (true) {
+    out << "(mt) " << std::flush;
+    if (!std::getline(in, line)) {
+      out << "\n";
+      return;
+    }
+    if (cancellation_ != nullptr) {
+      cancellation_->reset();
+    }
+    if (!execute(line, out)) {
+      return;
+    }
+  }
+}
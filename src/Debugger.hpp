@@ -0,0 +1,188 @@
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CancellationToken.hpp"
+#include "SimulationGenerator.hpp"
+#include "Simulator.hpp"
+#include "SimulatorHandle.hpp"
+
+/**
+ * @brief Depurador interactivo con ejecución hacia atrás (mt-sim --debug)
+ *
+ * Avanza la simulación con Simulator::step() (o MultiSimulator::step()) y
+ * permite volver a cualquier paso anterior sin guardar toda la traza: guarda
+ * copias de la configuración cada SNAPSHOT_SPACING pasos y las va aclarando
+ * para que su separación crezca exponencialmente hacia el pasado. Una copia
+ * del paso s con nivel k (s / SNAPSHOT_SPACING múltiplo de 2^k) se conserva
+ * mientras esté a menos de SNAPSHOT_SPACING·2^(k+1) pasos del actual, así que
+ * quedan unas dos por nivel: O(log pasos) configuraciones en memoria. Volver
+ * al paso t es restaurar la copia más cercana anterior a t y simular hacia
+ * delante desde ella.
+ *
+ * Los puntos de ruptura son pares (estado, símbolos): se detienen antes de
+ * dar un paso desde ese estado con esos símbolos bajo los cabezales ('*' vale
+ * cualquier símbolo; sin símbolos, cualquier combinación).
+ *
+ * continue avanza con un SimulationGenerator en pasos de step(), así que
+ * también se detiene en los eventos vigilados (watch): llegada a un estado,
+ * escritura de una celda o cabezal en una celda no visitada en ese continue.
+ */
+class Debugger {
+public:
+  static constexpr size_t SNAPSHOT_SPACING = 64;  // Pasos entre copias de la configuración
+
+  /**
+   * @brief Punto de ruptura
+   */
+  struct Breakpoint {
+    std::string state;    // Estado
+    std::string symbols;  // Un símbolo por cinta ('*' = cualquiera); vacío = cualquiera
+  };
+
+private:
+  SimulatorHandle simulator_;                        // Simulador de cualquiera de los dos tipos
+  std::vector<size_t> snapshot_steps_;               // Paso de cada copia, en orden
+  std::vector<Configuration> snapshots_;             // Copias (monocinta)
+  std::vector<MultiConfiguration> multi_snapshots_;  // Copias (multicinta)
+  std::vector<Breakpoint> breakpoints_;              // Puntos de ruptura
+  std::vector<std::string> watched_states_;          // Estados vigilados por continue
+  bool watch_writes_;                                // Si continue para al cambiar una celda
+  bool watch_boundaries_;                            // Si continue para en una celda nueva
+  std::vector<SimulationEvent> events_;              // Eventos vigilados del último continue
+  bool halted_;                                      // Si la máquina se detuvo en el paso actual
+  CancellationToken* cancellation_;                  // Interrupción de continue y similares
+  std::string last_error_;                           // Último error ocurrido
+
+  /**
+   * @brief Copia la configuración actual y aclara las copias antiguas
+   */
+  void take_snapshot();
+
+  /**
+   * @brief Restaura la copia i
+   * @param discard_later Si se descartan las copias posteriores (la posición
+   *                      actual pasa a ser la de la copia)
+   */
+  void restore_snapshot(size_t index, bool discard_later);
+
+  /**
+   * @brief Índice de la última copia con paso <= step
+   */
+  size_t snapshot_before(size_t step) const;
+
+  /**
+   * @brief Indica si se pidió interrumpir la orden en curso
+   */
+  bool interrupted() const { return cancellation_ != nullptr && cancellation_->is_cancelled(); }
+
+  /**
+   * @brief Escribe la configuración actual y, si se detuvo, el resultado
+   */
+  void print_status(std::ostream& out) const;
+
+  /**
+   * @brief Escribe los eventos vigilados en los que se detuvo el último continue
+   */
+  void print_events(std::ostream& out) const;
+
+  /**
+   * @brief Ejecuta una orden del intérprete
+   * @return false si la orden termina la sesión
+   */
+  bool execute(const std::string& line, std::ostream& out);
+
+public:
+  /**
+   * @brief Constructor sobre uno de los dos simuladores (el otro, nullptr)
+   */
+  Debugger(Simulator* simulator, MultiSimulator* multi_simulator);
+
+  /**
+   * @brief Empieza a depurar una palabra (paso 0)
+   * @return false si no se puede simular (ver get_last_error())
+   */
+  bool start(std::string_view word);
+
+  /**
+   * @brief Avanza hasta count pasos (menos si la máquina se detiene)
+   * @return Pasos dados
+   */
+  size_t step(size_t count = 1);
+
+  /**
+   * @brief Vuelve al paso indicado, hacia atrás o hacia delante
+   * @return false si la máquina se detiene antes de llegar
+   */
+  bool go_to_step(size_t step);
+
+  /**
+   * @brief Avanza hasta un punto de ruptura, un evento vigilado o hasta que la
+   *        máquina se detenga
+   * @return true si se detuvo en un punto de ruptura o en un evento vigilado
+   *         (ver get_events())
+   */
+  bool continue_forward();
+
+  /**
+   * @brief Retrocede hasta el último punto de ruptura anterior o hasta el paso 0
+   * @return true si se detuvo en un punto de ruptura
+   */
+  bool continue_backward();
+
+  /**
+   * @brief Avanza hasta llegar a un estado
+   * @return true si se llegó
+   */
+  bool run_until_state(std::string_view state);
+
+  /**
+   * @brief Añade un punto de ruptura
+   */
+  void add_breakpoint(const Breakpoint& breakpoint);
+
+  /**
+   * @brief Vigila la llegada a un estado en continue (STATE_ENTERED)
+   */
+  void watch_state(std::string_view state) { watched_states_.emplace_back(state); }
+
+  /**
+   * @brief Vigila en continue los cambios de símbolo de las celdas (CELL_WRITTEN)
+   */
+  void watch_writes(bool enable = true) { watch_writes_ = enable; }
+
+  /**
+   * @brief Vigila en continue la llegada de un cabezal a una celda no visitada
+   *        desde que empezó el continue (BOUNDARY_CROSSED)
+   */
+  void watch_boundaries(bool enable = true) { watch_boundaries_ = enable; }
+
+  /**
+   * @brief Deja de vigilar eventos
+   */
+  void clear_watches();
+
+  /**
+   * @brief Indica si la configuración actual cumple algún punto de ruptura
+   */
+  bool at_breakpoint() const;
+
+  /**
+   * @brief Enlaza la cancelación que interrumpe las órdenes largas (SIGINT);
+   *        el intérprete la anula antes de cada orden
+   */
+  void set_cancellation_token(CancellationToken* token);
+
+  /**
+   * @brief Intérprete de órdenes: lee de in hasta quit o fin de entrada
+   */
+  void run_repl(std::istream& in, std::ostream& out);
+
+  bool is_halted() const { return halted_; }
+  size_t get_snapshot_count() const { return snapshot_steps_.size(); }
+  const std::vector<SimulationEvent>& get_events() const { return events_; }
+  const std::string& get_last_error() const { return last_error_; }
+};
@@ -0,0 +1,61 @@
+#include "DeciderPipeline.hpp"
+#include <sstream>
+
+DeciderPipeline::DeciderPipeline(const CompiledMachine* machine)
+    : machine_(machine), backward_(machine), closed_language_(machine), bouncer_(machine) {
+}
+
+bool DeciderPipeline::set_deciders(const std::string& list) {
+  if (machine_ == nullptr || machine_->get_num_tapes() != 1) {
+    last_error_ = "Los decisores solo admiten máquinas monocinta";
+    return false;
+  }
+  deciders_.clear();
+  std::istringstream names(list);
+  std::string name;
+  while (std::getline(names, name, ',')) {
+    if (name == "all") {
+      deciders_ = {DeciderKind::BACKWARD_REASONING, DeciderKind::CLOSED_TAPE_LANGUAGE, DeciderKind::BOUNCER};
+    } else if (name == "backward") {
+      deciders_.push_back(DeciderKind::BACKWARD_REASONING);
+    } else if (name == "ctl") {
+      deciders_.push_back(DeciderKind::CLOSED_TAPE_LANGUAGE);
+    } else if (name == "bouncer") {
+      deciders_.push_back(DeciderKind::BOUNCER);
+    } else {
+      last_error_ = "Decisor desconocido: " + name + " (backward, ctl, bouncer o all)";
+      deciders_.clear();
+      return false;
+    }
+  }
+  if (deciders_.empty()) {
+    last_error_ = "La lista de decisores está vacía";
+    return false;
+  }
+  return true;
+}
+
+void DeciderPipeline::set_budget(const DeciderBudget& budget) {
+  budget_ = budget;
+}
+
+bool DeciderPipeline::decide(std::string_view word, DeciderCertificate& certificate) {
+  for (DeciderKind kind : deciders_) {
+    bool proven = false;
+    switch (kind) {
+      case DeciderKind::BACKWARD_REASONING:
+        proven = backward_.decide(word, budget_, certificate);
+        break;
+      case DeciderKind::CLOSED_TAPE_LANGUAGE:
+        proven = closed_language_.decide(word, budget_, certificate);
+        break;
+      case DeciderKind::BOUNCER:
+        proven = bouncer_.decide(word, budget_, certificate);
+        break;
+    }
+    if (proven) {
+      return true;
+    }
+  }
+  return false;
+}
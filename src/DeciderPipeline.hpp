@@ -0,0 +1,67 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Deciders.hpp"
+
+/**
+ * @brief Decisor de no parada de la cadena
+ */
+enum class DeciderKind {
+  BACKWARD_REASONING,    // Razonamiento hacia atrás desde las paradas (backward)
+  CLOSED_TAPE_LANGUAGE,  // Lenguaje de cinta cerrado con n-gramas (ctl)
+  BOUNCER                // Rebotes con bloques que crecen (bouncer)
+};
+
+/**
+ * @brief Cadena de decisores de no parada (mt-sim --deciders)
+ *
+ * Antes de simular una palabra, Simulator::start() pasa la palabra por los
+ * decisores en el orden configurado, cada uno con el mismo presupuesto de
+ * trabajo y de tiempo. El primero que demuestra que la máquina no se detiene
+ * deja su certificado y la simulación termina en el paso 0 con INFINITE; si
+ * ninguno lo consigue, se simula como siempre.
+ *
+ * Solo admite máquinas monocinta. Los decisores guardan estado entre palabras
+ * (el análisis hacia atrás depende solo de la máquina), así que una cadena no
+ * debe compartirse entre hilos.
+ */
+class DeciderPipeline {
+private:
+  const CompiledMachine* machine_;           // Máquina compilada monocinta
+  std::vector<DeciderKind> deciders_;        // Decisores en orden de aplicación
+  DeciderBudget budget_;                     // Presupuesto de cada decisor
+  BackwardReasoningDecider backward_;
+  ClosedTapeLanguageDecider closed_language_;
+  BouncerDecider bouncer_;
+  std::string last_error_;                   // Último error ocurrido
+
+public:
+  /**
+   * @brief Constructor sin decisores
+   * @param machine Máquina compilada monocinta (debe sobrevivir a la cadena)
+   */
+  explicit DeciderPipeline(const CompiledMachine* machine);
+
+  /**
+   * @brief Configura los decisores a partir de una lista
+   * @param list Nombres separados por comas (backward, ctl, bouncer) o all
+   * @return false si algún nombre no existe o la máquina no es monocinta
+   */
+  bool set_deciders(const std::string& list);
+
+  /**
+   * @brief Establece el presupuesto de cada decisor
+   */
+  void set_budget(const DeciderBudget& budget);
+
+  /**
+   * @brief Aplica los decisores a una palabra
+   * @param certificate Certificado del decisor que lo demuestra
+   * @return true si alguno demuestra que la máquina no se detiene
+   */
+  bool decide(std::string_view word, DeciderCertificate& certificate);
+
+  bool empty() const { return deciders_.empty(); }
+  const std::string& get_last_error() const { return last_error_; }
+};
@@ -0,0 +1,581 @@
+#include "Deciders.hpp"
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+const char HEAD_MARK = static_cast<char>(0x80);  // Bit que marca la celda del cabezal
+
+int move_offset(Movement movement) {
+  switch (movement) {
+    case Movement::LEFT:
+      return -1;
+    case Movement::RIGHT:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief Cinta contigua que crece por los dos lados (ejecuciones concretas
+ *        de los decisores, sin detección de bucles)
+ */
+class FlatTape {
+private:
+  std::string cells_;   // Celdas guardadas
+  long origin_;         // Índice en cells_ de la posición 0
+  char blank_;          // Símbolo blanco
+
+public:
+  FlatTape(std::string_view word, char blank) : cells_(word), origin_(0), blank_(blank) {}
+
+  char read(long position) const {
+    long index = position + origin_;
+    return index >= 0 && index < static_cast<long>(cells_.size()) ? cells_[index] : blank_;
+  }
+
+  void write(long position, char symbol) {
+    long index = position + origin_;
+    if (index < 0) {
+      if (symbol == blank_) {
+        return;
+      }
+      size_t extra = std::max(static_cast<size_t>(-index), cells_.size() / 2 + 16);
+      cells_.insert(0, extra, blank_);
+      origin_ += static_cast<long>(extra);
+      index += static_cast<long>(extra);
+    } else if (index >= static_cast<long>(cells_.size())) {
+      if (symbol == blank_) {
+        return;
+      }
+      cells_.resize(std::max(static_cast<size_t>(index) + 1, cells_.size() * 3 / 2 + 16), blank_);
+    }
+    cells_[index] = symbol;
+  }
+
+  size_t size() const { return cells_.size(); }
+
+  /**
+   * @brief Cinta sin blancos en los extremos, con la celda del cabezal marcada
+   */
+  std::string snapshot(long head) const {
+    long first = std::min(-origin_, head);
+    long last = std::max(static_cast<long>(cells_.size()) - origin_ - 1, head);
+    std::string tape;
+    tape.reserve(static_cast<size_t>(last - first + 1));
+    for (long position = first; position <= last; ++position) {
+      char symbol = read(position);
+      tape += position == head ? static_cast<char>(symbol | HEAD_MARK) : symbol;
+    }
+    size_t begin = tape.find_first_not_of(blank_);
+    size_t end = tape.find_last_not_of(blank_);
+    return tape.substr(begin, end - begin + 1);  // La marca nunca es blanco
+  }
+};
+
+/**
+ * @brief Ejecución concreta de una máquina monocinta
+ */
+struct Run {
+  uint32_t state;
+  long head;
+  FlatTape tape;
+
+  Run(const CompiledMachine& machine, std::string_view word)
+      : state(machine.get_initial_state()), head(0), tape(word, machine.get_blank_symbol()) {}
+
+  /**
+   * @brief Da un paso
+   * @return false si la configuración actual es de parada
+   */
+  bool step(const CompiledMachine& machine) {
+    if (machine.is_accept_state(state)) {
+      return false;
+    }
+    char symbol = tape.read(head);
+    uint32_t transition = machine.find_transition(state, &symbol);
+    if (transition == CompiledMachine::NO_TRANSITION) {
+      return false;
+    }
+    tape.write(head, machine.get_write_symbols(transition)[0]);
+    head += move_offset(machine.get_movement(transition, 0));
+    state = machine.get_to_state(transition);
+    return true;
+  }
+};
+
+}  // namespace
+
+// ===== DECIDERMETER =====
+
+DeciderMeter::DeciderMeter(const DeciderBudget& budget)
+    : limit_(budget.steps), spent_(0), next_clock_check_(CLOCK_INTERVAL),
+      deadline_(budget.milliseconds > 0
+                    ? std::chrono::steady_clock::now() + std::chrono::milliseconds(budget.milliseconds)
+                    : std::chrono::steady_clock::time_point::max()),
+      exhausted_(false) {
+}
+
+// ===== RAZONAMIENTO HACIA ATRÁS =====
+
+BackwardReasoningDecider::BackwardReasoningDecider(const CompiledMachine* machine)
+    : machine_(machine), analyzed_(false), bounded_(false), halting_bound_(0), nodes_(0) {
+}
+
+bool BackwardReasoningDecider::search(const Node& node, size_t depth, DeciderMeter& meter) {
+  if (!meter.spend()) {
+    return false;
+  }
+  ++nodes_;
+  halting_bound_ = std::max(halting_bound_, depth);
+
+  for (uint32_t transition : incoming_[node.state]) {
+    // Antes del paso el cabezal estaba en la celda que escribió la transición
+    long previous_head = static_cast<long>(node.head) - move_offset(machine_->get_movement(transition, 0));
+    char fixed = previous_head >= 0 && previous_head < static_cast<long>(node.cells.size())
+                     ? node.cells[previous_head] : '\0';
+    if (fixed != '\0' && fixed != machine_->get_write_symbols(transition)[0]) {
+      continue;
+    }
+    if (depth + 1 > MAX_DEPTH) {
+      return false;
+    }
+
+    Node previous{machine_->get_from_state(transition), 0, node.cells};
+    if (previous_head < 0) {
+      previous.cells.insert(previous.cells.begin(), '\0');
+      previous_head = 0;
+    } else if (previous_head == static_cast<long>(previous.cells.size())) {
+      previous.cells.push_back('\0');
+    }
+    previous.head = static_cast<size_t>(previous_head);
+    previous.cells[previous.head] = machine_->get_read_symbols(transition)[0];
+    if (!search(previous, depth + 1, meter)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool BackwardReasoningDecider::analyze(DeciderMeter& meter) {
+  // Desde un estado de aceptación no se da ningún paso: sus transiciones no cuentan
+  incoming_.assign(machine_->get_num_states(), {});
+  for (uint32_t t = 0; t < machine_->get_transition_count(); ++t) {
+    if (!machine_->is_accept_state(machine_->get_from_state(t))) {
+      incoming_[machine_->get_to_state(t)].push_back(t);
+    }
+  }
+
+  // Símbolos que pueden aparecer en la cinta
+  std::string symbols(1, machine_->get_blank_symbol());
+  for (const SymbolSet* alphabet : {&machine_->get_tape_alphabet(), &machine_->get_input_alphabet()}) {
+    for (char symbol : *alphabet) {
+      if (symbols.find(symbol) == std::string::npos) {
+        symbols += symbol;
+      }
+    }
+  }
+  for (uint32_t state = 0; state < machine_->get_num_states(); ++state) {
+    if (machine_->is_accept_state(state)) {
+      if (!search(Node{state, 0, std::string(1, '\0')}, 0, meter)) {
+        return false;
+      }
+      continue;
+    }
+    for (char symbol : symbols) {
+      if (machine_->find_transition(state, &symbol) == CompiledMachine::NO_TRANSITION &&
+          !search(Node{state, 0, std::string(1, symbol)}, 0, meter)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool BackwardReasoningDecider::decide(std::string_view word, const DeciderBudget& budget,
+                                      DeciderCertificate& certificate) {
+  if (!analyzed_) {
+    analyzed_ = true;
+    DeciderMeter meter(budget);
+    bounded_ = analyze(meter);
+  }
+  if (!bounded_) {
+    return false;
+  }
+
+  // Si se detiene, lo hace en como mucho halting_bound_ pasos
+  Run run(*machine_, word);
+  for (size_t step = 0; step <= halting_bound_; ++step) {
+    if (!run.step(*machine_)) {
+      return false;
+    }
+  }
+  certificate.proof = InfiniteProof::BACKWARD_REASONING;
+  certificate.detail = "toda parada ocurre como mucho en el paso " + std::to_string(halting_bound_) +
+                       ", nodos explorados: " + std::to_string(nodes_);
+  return true;
+}
+
+// ===== LENGUAJE DE CINTA CERRADO =====
+
+ClosedTapeLanguageDecider::ClosedTapeLanguageDecider(const CompiledMachine* machine)
+    : machine_(machine) {
+}
+
+bool ClosedTapeLanguageDecider::close(size_t n, std::string_view word, DeciderMeter& meter,
+                                      size_t& configurations) {
+  const char blank = machine_->get_blank_symbol();
+
+  // n-gramas de cada lado (0 izquierda, 1 derecha), leídos desde el cabezal
+  // hacia fuera, e índice por sus n - 1 primeras celdas
+  std::unordered_set<std::string> grams[2];
+  std::unordered_map<std::string, std::vector<std::string>> by_prefix[2];
+  bool grams_changed = false;
+  auto add_gram = [&](int side, const std::string& gram) {
+    if (grams[side].insert(gram).second) {
+      by_prefix[side][gram.substr(0, n - 1)].push_back(gram);
+      grams_changed = true;
+    }
+  };
+
+  // Contextos: estado (4 bytes), n celdas a la izquierda, símbolo leído y n a la derecha
+  std::unordered_set<std::string> seen;
+  std::vector<std::string> contexts;
+  auto add_context = [&](uint32_t state, const std::string& left, char head, const std::string& right) {
+    std::string key(reinterpret_cast<const char*>(&state), sizeof(state));
+    key += left;
+    key += head;
+    key += right;
+    if (seen.insert(key).second) {
+      contexts.push_back(std::move(key));
+    }
+  };
+
+  // Cinta inicial: blancos a la izquierda y la palabra desde el cabezal
+  std::string blanks(n, blank);
+  std::string right_tape = word.size() > 1 ? std::string(word.substr(1)) : std::string();
+  right_tape += blanks;
+  add_gram(0, blanks);
+  for (size_t i = 0; i + n <= right_tape.size(); ++i) {
+    add_gram(1, right_tape.substr(i, n));
+  }
+  add_context(machine_->get_initial_state(), blanks, word.empty() ? blank : word[0], right_tape.substr(0, n));
+
+  // Cada pasada expande todos los contextos; se repite mientras aparezcan n-gramas
+  do {
+    grams_changed = false;
+    for (size_t i = 0; i < contexts.size(); ++i) {
+      if (!meter.spend()) {
+        return false;
+      }
+      std::string key = contexts[i];
+      uint32_t state;
+      std::memcpy(&state, key.data(), sizeof(state));
+      std::string left = key.substr(sizeof(state), n);
+      char head = key[sizeof(state) + n];
+      std::string right = key.substr(sizeof(state) + n + 1, n);
+
+      if (machine_->is_accept_state(state)) {
+        return false;
+      }
+      uint32_t transition = machine_->find_transition(state, &head);
+      if (transition == CompiledMachine::NO_TRANSITION) {
+        return false;
+      }
+      char written = machine_->get_write_symbols(transition)[0];
+      uint32_t next = machine_->get_to_state(transition);
+      switch (machine_->get_movement(transition, 0)) {
+        case Movement::STAY:
+          add_context(next, left, written, right);
+          break;
+        case Movement::RIGHT: {
+          std::string pushed = written + left.substr(0, n - 1);
+          add_gram(0, pushed);
+          auto it = by_prefix[1].find(right.substr(1));
+          if (it != by_prefix[1].end()) {
+            if (!meter.spend(it->second.size())) {
+              return false;
+            }
+            for (const std::string& gram : it->second) {
+              add_context(next, pushed, right[0], gram);
+            }
+          }
+          break;
+        }
+        case Movement::LEFT: {
+          std::string pushed = written + right.substr(0, n - 1);
+          add_gram(1, pushed);
+          auto it = by_prefix[0].find(left.substr(1));
+          if (it != by_prefix[0].end()) {
+            if (!meter.spend(it->second.size())) {
+              return false;
+            }
+            for (const std::string& gram : it->second) {
+              add_context(next, gram, left[0], pushed);
+            }
+          }
+          break;
+        }
+      }
+    }
+  } while (grams_changed);
+
+  configurations = contexts.size();
+  return true;
+}
+
+bool ClosedTapeLanguageDecider::decide(std::string_view word, const DeciderBudget& budget,
+                                       DeciderCertificate& certificate) {
+  DeciderMeter meter(budget);
+  for (size_t n = 1; n <= MAX_GRAM && !meter.is_exhausted(); ++n) {
+    size_t configurations = 0;
+    if (close(n, word, meter, configurations)) {
+      certificate.proof = InfiniteProof::CLOSED_TAPE_LANGUAGE;
+      certificate.detail = std::to_string(n) + "-gramas, " + std::to_string(configurations) + " contextos";
+      return true;
+    }
+  }
+  return false;
+}
+
+// ===== REBOTES =====
+
+BouncerDecider::BouncerDecider(const CompiledMachine* machine) : machine_(machine) {
+}
+
+BouncerDecider::Canonical BouncerDecider::canonical(const SymbolicTape& tape) const {
+  const char blank = machine_->get_blank_symbol();
+  Canonical form{tape.state, tape.left, tape.unit, 0, tape.right};
+  if (tape.head_left) {
+    form.prefix[tape.head] = static_cast<char>(form.prefix[tape.head] | HEAD_MARK);
+  } else {
+    form.suffix[tape.head] = static_cast<char>(form.suffix[tape.head] | HEAD_MARK);
+  }
+
+  // Los blancos de los extremos se confunden con los infinitos de la cinta
+  size_t begin = form.prefix.find_first_not_of(blank);
+  form.prefix.erase(0, begin == std::string::npos ? form.prefix.size() : begin);
+  size_t end = form.suffix.find_last_not_of(blank);
+  form.suffix.erase(end == std::string::npos ? 0 : end + 1);
+
+  // x a (y' a)^n z = x (a y')^n a z: el bloque empieza lo más a la izquierda
+  // posible, y las copias enteras que lo siguen pasan al exponente
+  size_t length = form.unit.size();
+  while (!form.prefix.empty() && form.prefix.back() == form.unit.back()) {
+    char symbol = form.prefix.back();
+    form.prefix.pop_back();
+    form.unit.pop_back();
+    form.unit.insert(form.unit.begin(), symbol);
+    form.suffix.insert(form.suffix.begin(), symbol);
+  }
+  while (form.suffix.size() >= length && form.suffix.compare(0, length, form.unit) == 0) {
+    form.suffix.erase(0, length);
+    ++form.extra;
+  }
+  return form;
+}
+
+bool BouncerDecider::shift(SymbolicTape& tape, int direction, DeciderMeter& meter) const {
+  // Recorre una sola copia del bloque; si sale por el otro lado en el mismo
+  // estado, cada copia se recorre igual y el bloque entero queda transformado
+  std::string cells = tape.unit;
+  long length = static_cast<long>(cells.size());
+  long position = direction > 0 ? 0 : length - 1;
+  uint32_t state = tape.state;
+  while (position >= 0 && position < length) {
+    if (!meter.spend() || machine_->is_accept_state(state)) {
+      return false;
+    }
+    uint32_t transition = machine_->find_transition(state, &cells[position]);
+    if (transition == CompiledMachine::NO_TRANSITION) {
+      return false;
+    }
+    cells[position] = machine_->get_write_symbols(transition)[0];
+    position += move_offset(machine_->get_movement(transition, 0));
+    state = machine_->get_to_state(transition);
+  }
+  if ((direction > 0) != (position >= length) || state != tape.state) {
+    return false;
+  }
+  tape.unit = cells;
+  return true;
+}
+
+bool BouncerDecider::symbolic_step(SymbolicTape& tape, DeciderMeter& meter) const {
+  const char blank = machine_->get_blank_symbol();
+  std::string& cells = tape.head_left ? tape.left : tape.right;
+  if (machine_->is_accept_state(tape.state)) {
+    return false;
+  }
+  uint32_t transition = machine_->find_transition(tape.state, &cells[tape.head]);
+  if (transition == CompiledMachine::NO_TRANSITION) {
+    return false;
+  }
+  cells[tape.head] = machine_->get_write_symbols(transition)[0];
+  tape.state = machine_->get_to_state(transition);
+
+  switch (machine_->get_movement(transition, 0)) {
+    case Movement::LEFT:
+      if (!tape.head_left) {
+        if (tape.head > 0) {
+          --tape.head;
+          break;
+        }
+        if (!shift(tape, -1, meter)) {
+          return false;
+        }
+        tape.head_left = true;
+        if (tape.left.empty()) {
+          tape.left.assign(1, blank);
+        }
+        tape.head = tape.left.size() - 1;
+      } else if (tape.head == 0) {
+        tape.left.insert(tape.left.begin(), blank);
+      } else {
+        --tape.head;
+      }
+      break;
+    case Movement::RIGHT:
+      if (tape.head_left) {
+        if (tape.head + 1 < tape.left.size()) {
+          ++tape.head;
+          break;
+        }
+        if (!shift(tape, 1, meter)) {
+          return false;
+        }
+        tape.head_left = false;
+        if (tape.right.empty()) {
+          tape.right.assign(1, blank);
+        }
+        tape.head = 0;
+      } else if (++tape.head == tape.right.size()) {
+        tape.right.push_back(blank);
+      }
+      break;
+    case Movement::STAY:
+      break;
+  }
+  return true;
+}
+
+bool BouncerDecider::prove(const Record& previous, const Record& current, DeciderMeter& meter,
+                           DeciderCertificate& certificate) const {
+  // current debe ser previous con un bloque insertado; se toma el de más a la
+  // derecha que encaja y se extiende hacia la izquierda con sus copias
+  const std::string& before = previous.tape;
+  const std::string& after = current.tape;
+  size_t length = after.size() - before.size();
+  size_t split = 0;
+  while (split < before.size() && before[split] == after[split]) {
+    ++split;
+  }
+  if (after.compare(split + length, std::string::npos, before, split, std::string::npos) != 0) {
+    return false;
+  }
+  std::string unit = after.substr(split, length);
+  if (std::any_of(unit.begin(), unit.end(), [](char c) { return (c & HEAD_MARK) != 0; })) {
+    return false;
+  }
+  size_t start = split;
+  while (start >= length && before.compare(start - length, length, unit) == 0) {
+    start -= length;
+  }
+
+  // previous = A u^k B en la forma simbólica A u^n B
+  SymbolicTape tape{previous.state, before.substr(0, start), unit, before.substr(split), false, 0};
+  for (std::string* cells : {&tape.left, &tape.right}) {
+    for (size_t i = 0; i < cells->size(); ++i) {
+      if (((*cells)[i] & HEAD_MARK) != 0) {
+        tape.head_left = cells == &tape.left;
+        tape.head = i;
+        (*cells)[i] = static_cast<char>((*cells)[i] & ~HEAD_MARK);
+      }
+    }
+  }
+
+  Canonical target = canonical(tape);
+  ++target.extra;
+
+  // A u^n B debe llegar a A u^(n+1) B; el tramo concreto duró current.step -
+  // previous.step pasos, y la forma simbólica no necesita más
+  uint64_t limit = 2 * (current.step - previous.step) + 1024;
+  for (uint64_t step = 0; step < limit; ++step) {
+    if (!meter.spend() || !symbolic_step(tape, meter)) {
+      return false;
+    }
+    // Comparar cuesta una unidad por cada 64 celdas
+    if (tape.state == target.state &&
+        meter.spend((tape.left.size() + tape.right.size()) / 64) && canonical(tape) == target) {
+      certificate.proof = InfiniteProof::BOUNCER;
+      certificate.detail = "bloque \"" + unit + "\" que se repite una vez más cada pasada, desde el paso " +
+                           std::to_string(previous.step);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool BouncerDecider::decide(std::string_view word, const DeciderBudget& budget,
+                            DeciderCertificate& certificate) {
+  for (char symbol : machine_->get_tape_alphabet()) {
+    if ((symbol & HEAD_MARK) != 0) {
+      return false;
+    }
+  }
+
+  DeciderMeter meter(budget);
+  Run run(*machine_, word);
+  long right_bound = word.empty() ? 0 : static_cast<long>(word.size()) - 1;
+  long left_bound = 0;
+  std::deque<Record> records[2];  // 0 derecha, 1 izquierda
+  uint64_t step = 0;
+  while (meter.spend()) {
+    if (!run.step(*machine_)) {
+      return false;  // Se detiene: no hay nada que demostrar
+    }
+    ++step;
+    int side = run.head > right_bound ? 0 : run.head < left_bound ? 1 : -1;
+    if (side < 0) {
+      continue;
+    }
+    (side == 0 ? right_bound : left_bound) = run.head;
+    if (static_cast<size_t>(right_bound - left_bound) >= MAX_TAPE) {
+      return false;  // Las copias abarcan todo lo recorrido, escrito o no
+    }
+
+    // Los dos récords anteriores del mismo lado con el mismo estado
+    Record record{run.state, step, run.tape.snapshot(run.head)};
+    if (!meter.spend(record.tape.size() / 64)) {
+      return false;
+    }
+    const Record* last = nullptr;
+    const Record* before_last = nullptr;
+    for (auto it = records[side].rbegin(); it != records[side].rend(); ++it) {
+      if (it->state != record.state) {
+        continue;
+      }
+      if (last == nullptr) {
+        last = &*it;
+      } else {
+        before_last = &*it;
+        break;
+      }
+    }
+    if (before_last != nullptr && record.tape.size() > last->tape.size() &&
+        record.tape.size() - last->tape.size() == last->tape.size() - before_last->tape.size() &&
+        last->tape.size() > before_last->tape.size() && prove(*last, record, meter, certificate)) {
+      return true;
+    }
+
+    records[side].push_back(std::move(record));
+    if (records[side].size() > MAX_RECORDS) {
+      records[side].pop_front();
+    }
+  }
+  return false;
+}
@@ -0,0 +1,258 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CompiledMachine.hpp"
+#include "Simulator.hpp"
+
+/**
+ * @brief Presupuesto de un decisor
+ */
+struct DeciderBudget {
+  uint64_t steps = 100000;      // Unidades de trabajo como máximo (pasos, nodos o contextos)
+  uint64_t milliseconds = 50;   // Tiempo de reloj como máximo (0 = sin plazo)
+};
+
+/**
+ * @brief Certificado de que una simulación no se detiene
+ */
+struct DeciderCertificate {
+  InfiniteProof proof = InfiniteProof::NONE;  // Tipo de prueba
+  std::string detail;                          // Parámetros de la prueba, legibles
+};
+
+/**
+ * @brief Contador del trabajo de un decisor contra su presupuesto
+ *
+ * El reloj solo se consulta cada CLOCK_INTERVAL unidades.
+ */
+class DeciderMeter {
+public:
+  static constexpr uint64_t CLOCK_INTERVAL = 1024;  // Unidades entre consultas del reloj
+
+private:
+  uint64_t limit_;                                   // Unidades permitidas
+  uint64_t spent_;                                   // Unidades gastadas
+  uint64_t next_clock_check_;                        // Gasto en que se mira el reloj
+  std::chrono::steady_clock::time_point deadline_;   // Plazo (max() = sin plazo)
+  bool exhausted_;                                   // Si se agotó el presupuesto
+
+public:
+  explicit DeciderMeter(const DeciderBudget& budget);
+
+  /**
+   * @brief Gasta unidades de trabajo
+   * @return false si el presupuesto está agotado
+   */
+  bool spend(uint64_t units = 1) {
+    spent_ += units;
+    if (spent_ > limit_) {
+      exhausted_ = true;
+    } else if (spent_ >= next_clock_check_) {
+      next_clock_check_ = spent_ + CLOCK_INTERVAL;
+      exhausted_ = deadline_ != std::chrono::steady_clock::time_point::max() &&
+                   std::chrono::steady_clock::now() >= deadline_;
+    }
+    return !exhausted_;
+  }
+
+  bool is_exhausted() const { return exhausted_; }
+  uint64_t get_spent() const { return spent_; }
+};
+
+/**
+ * @brief Razonamiento hacia atrás desde las configuraciones de parada
+ *
+ * Parte de cada configuración local de parada (un estado de aceptación, o un
+ * estado y un símbolo sin transición) y explora hacia atrás las transiciones
+ * que pueden llevar a ella, anotando las celdas que cada camino fija. Si todos
+ * los caminos mueren (una celda tendría que valer dos cosas o el estado no
+ * tiene transiciones de entrada) antes de MAX_DEPTH pasos, una simulación que
+ * se detenga lo hace como mucho en la profundidad máxima alcanzada D: basta
+ * simular D pasos sin detenerse para saber que no se detiene nunca.
+ *
+ * El análisis depende solo de la máquina y se hace una vez; cada palabra
+ * cuesta después como mucho D + 1 pasos.
+ */
+class BackwardReasoningDecider {
+public:
+  static constexpr size_t MAX_DEPTH = 256;  // Profundidad máxima de la búsqueda hacia atrás
+
+private:
+  /**
+   * @brief Configuración parcial: estado y celdas fijadas alrededor del cabezal
+   */
+  struct Node {
+    uint32_t state;       // Estado
+    size_t head;          // Posición del cabezal en cells
+    std::string cells;    // Celdas fijadas ('\0' = cualquier símbolo)
+  };
+
+  const CompiledMachine* machine_;                 // Máquina monocinta
+  std::vector<std::vector<uint32_t>> incoming_;    // Transiciones que llegan a cada estado
+  bool analyzed_;                                   // Si ya se hizo el análisis
+  bool bounded_;                                    // Si todos los caminos hacia atrás mueren
+  size_t halting_bound_;                            // Profundidad máxima alcanzada (D)
+  uint64_t nodes_;                                  // Nodos explorados
+
+  /**
+   * @brief Explora hacia atrás desde un nodo
+   * @return false si se agota el presupuesto o se supera MAX_DEPTH
+   */
+  bool search(const Node& node, size_t depth, DeciderMeter& meter);
+
+  /**
+   * @brief Explora desde todas las configuraciones de parada
+   * @return true si todos los caminos mueren
+   */
+  bool analyze(DeciderMeter& meter);
+
+public:
+  explicit BackwardReasoningDecider(const CompiledMachine* machine);
+
+  /**
+   * @brief Intenta demostrar que la palabra no se detiene
+   * @return true si lo demuestra (certificate queda completo)
+   */
+  bool decide(std::string_view word, const DeciderBudget& budget, DeciderCertificate& certificate);
+};
+
+/**
+ * @brief Lenguaje de cinta cerrado con autómatas de n-gramas
+ *
+ * Aproxima las configuraciones alcanzables por un lenguaje regular: el estado,
+ * el símbolo bajo el cabezal, las n celdas más cercanas de cada lado y dos
+ * conjuntos de n-gramas que contienen todas las ventanas de n celdas de la
+ * parte izquierda y de la derecha de la cinta (un autómata finito que acepta
+ * las cintas cuyas ventanas están en el conjunto). Se parte de la cinta
+ * inicial y se cierra el conjunto bajo la función de transición: al desplazar
+ * el cabezal se empuja una celda a un lado y se toman del otro todos los
+ * n-gramas que continúan la ventana. Si el cierre no contiene ninguna
+ * configuración de parada, la máquina no se detiene.
+ *
+ * Se prueba con n = 1 .. MAX_GRAM mientras quede presupuesto.
+ */
+class ClosedTapeLanguageDecider {
+public:
+  static constexpr size_t MAX_GRAM = 3;  // n máximo de los n-gramas
+
+private:
+  const CompiledMachine* machine_;  // Máquina monocinta
+
+  /**
+   * @brief Calcula el cierre con n-gramas de longitud n
+   * @param configurations Contextos del cierre, si se completa
+   * @return true si se cierra sin configuraciones de parada
+   */
+  bool close(size_t n, std::string_view word, DeciderMeter& meter, size_t& configurations);
+
+public:
+  explicit ClosedTapeLanguageDecider(const CompiledMachine* machine);
+
+  /**
+   * @brief Intenta demostrar que la palabra no se detiene
+   * @return true si lo demuestra (certificate queda completo)
+   */
+  bool decide(std::string_view word, const DeciderBudget& budget, DeciderCertificate& certificate);
+};
+
+/**
+ * @brief Detección acotada de máquinas que rebotan
+ *
+ * Una máquina que rebota recorre la cinta de un extremo a otro y en cada
+ * pasada añade un mismo bloque u, así que en sus récords del cabezal (llegar
+ * más lejos que nunca por un lado) la cinta es A u^k B, A u^(k+1) B, ...
+ * Se simula guardando la cinta en cada récord; cuando tres récords del mismo
+ * lado y estado crecen lo mismo, se toma el bloque insertado como u y se
+ * demuestra de forma simbólica que A u^n B lleva a A u^(n+1) B para todo n:
+ * la cinta simbólica tiene un solo bloque u^n y, cuando el cabezal entra en
+ * él, se comprueba una regla de desplazamiento (recorrer una copia de u
+ * entrando por un lado deja el cabezal al otro lado en el mismo estado, así
+ * que recorre las n copias igual). Al llegar al mismo estado, ambas cintas se
+ * comparan en una forma canónica que no depende de n.
+ *
+ * Las copias de la cinta se limitan a MAX_TAPE celdas y solo se admiten
+ * alfabetos ASCII (el bit alto marca la celda del cabezal).
+ */
+class BouncerDecider {
+public:
+  static constexpr size_t MAX_TAPE = 4096;    // Celdas máximas de las copias de la cinta
+  static constexpr size_t MAX_RECORDS = 32;   // Récords guardados por lado
+
+private:
+  /**
+   * @brief Récord del cabezal
+   */
+  struct Record {
+    uint32_t state;      // Estado
+    uint64_t step;       // Paso
+    std::string tape;    // Cinta sin blancos en los extremos, con la celda del cabezal marcada
+  };
+
+  /**
+   * @brief Cinta simbólica left u^n right (blancos infinitos a ambos lados)
+   */
+  struct SymbolicTape {
+    uint32_t state;      // Estado
+    std::string left;    // Celdas a la izquierda del bloque
+    std::string unit;    // Bloque repetido n veces
+    std::string right;   // Celdas a la derecha del bloque
+    bool head_left;      // Si el cabezal está en left (si no, en right)
+    size_t head;         // Posición del cabezal en left o right
+  };
+
+  /**
+   * @brief Forma canónica de una cinta simbólica: prefix unit^(n + extra) suffix
+   */
+  struct Canonical {
+    uint32_t state;
+    std::string prefix;
+    std::string unit;
+    uint64_t extra;
+    std::string suffix;
+
+    bool operator==(const Canonical& other) const {
+      return state == other.state && extra == other.extra && prefix == other.prefix &&
+             unit == other.unit && suffix == other.suffix;
+    }
+  };
+
+  const CompiledMachine* machine_;  // Máquina monocinta
+
+  /**
+   * @brief Forma canónica (el cabezal va marcado en prefix o suffix)
+   */
+  Canonical canonical(const SymbolicTape& tape) const;
+
+  /**
+   * @brief Aplica una regla de desplazamiento sobre el bloque
+   * @param direction +1 si el cabezal entra por la izquierda, -1 por la derecha
+   * @return false si el recorrido de una copia no sale por el otro lado en el mismo estado
+   */
+  bool shift(SymbolicTape& tape, int direction, DeciderMeter& meter) const;
+
+  /**
+   * @brief Da un paso (o recorre el bloque entero) en la cinta simbólica
+   * @return false si la máquina puede detenerse o no se puede seguir
+   */
+  bool symbolic_step(SymbolicTape& tape, DeciderMeter& meter) const;
+
+  /**
+   * @brief Intenta demostrar el rebote a partir de dos récords consecutivos
+   *        del mismo lado y estado
+   */
+  bool prove(const Record& previous, const Record& current, DeciderMeter& meter,
+             DeciderCertificate& certificate) const;
+
+public:
+  explicit BouncerDecider(const CompiledMachine* machine);
+
+  /**
+   * @brief Intenta demostrar que la palabra no se detiene
+   * @return true si lo demuestra (certificate queda completo)
+   */
+  bool decide(std::string_view word, const DeciderBudget& budget, DeciderCertificate& certificate);
+};
@@ -0,0 +1,271 @@
+#include "Enumerator.hpp"
+#include <algorithm>
+#include "CompiledMachine.hpp"
+#include "DeciderPipeline.hpp"
+#include "TuringMachine.hpp"
+
+namespace {
+
+const char SYMBOLS[] = {'.', '1', '2', '3'};  // Símbolo de cinta de cada índice
+
+std::string state_name(size_t state) {
+  return std::string(1, static_cast<char>('A' + state));
+}
+
+/**
+ * @brief Construye la máquina de una tabla parcial
+ */
+TuringMachine build_machine(const std::vector<uint8_t>& table, size_t num_states, size_t num_symbols) {
+  TuringMachine machine('.');
+  for (size_t state = 0; state < num_states; ++state) {
+    machine.add_state(state_name(state));
+  }
+  for (size_t symbol = 0; symbol < num_symbols; ++symbol) {
+    machine.add_tape_symbol(SYMBOLS[symbol]);
+  }
+  machine.add_input_symbol('1');
+  machine.set_initial_state("A");
+  for (size_t i = 0; i < table.size(); ++i) {
+    if (table[i] == 0) {
+      continue;
+    }
+    size_t code = table[i] - 1u;
+    size_t move = code % 2;
+    size_t write = (code / 2) % num_symbols;
+    size_t to = code / 2 / num_symbols;
+    machine.add_transition(state_name(i / num_symbols), SYMBOLS[i % num_symbols], state_name(to),
+                           SYMBOLS[write], move == 0 ? Movement::LEFT : Movement::RIGHT);
+  }
+  return machine;
+}
+
+const char* result_name(EnumerationResult result) {
+  switch (result) {
+    case EnumerationResult::HALT:
+      return "HALT";
+    case EnumerationResult::NONHALT:
+      return "NONHALT";
+    default:
+      return "UNDECIDED";
+  }
+}
+
+}  // namespace
+
+Enumerator::Enumerator(const EnumerationOptions& options)
+    : options_(options), output_(nullptr), format_(EnumerationFormat::BINARY), output_failed_(false) {
+}
+
+void Enumerator::set_output(std::FILE* output, EnumerationFormat format) {
+  output_ = output;
+  format_ = format;
+}
+
+std::string Enumerator::to_standard_notation(const std::vector<uint8_t>& table, size_t num_symbols) {
+  std::string text;
+  for (size_t i = 0; i < table.size(); ++i) {
+    if (i > 0 && i % num_symbols == 0) {
+      text += '_';
+    }
+    if (table[i] == 0) {
+      text += "---";
+      continue;
+    }
+    size_t code = table[i] - 1u;
+    text += static_cast<char>('0' + (code / 2) % num_symbols);
+    text += code % 2 == 0 ? 'L' : 'R';
+    text += static_cast<char>('A' + code / 2 / num_symbols);
+  }
+  return text;
+}
+
+void Enumerator::record(WorkerState& state, const Node& node, EnumerationResult result,
+                        InfiniteProof proof, uint64_t steps) {
+  Summary& summary = state.summary;
+  ++summary.nodes;
+  switch (result) {
+    case EnumerationResult::HALT: {
+      ++summary.halting;
+      // Empates: la primera en notación estándar, para que no dependa de los hilos
+      std::string notation;
+      if (steps >= summary.max_halt_steps) {
+        notation = to_standard_notation(node.table, options_.num_symbols);
+      }
+      if (steps > summary.max_halt_steps || (steps == summary.max_halt_steps &&
+                                             (summary.champion.empty() || notation < summary.champion))) {
+        summary.max_halt_steps = steps;
+        summary.champion = notation;
+      }
+      break;
+    }
+    case EnumerationResult::NONHALT:
+      ++summary.nonhalting;
+      ++summary.proofs[static_cast<size_t>(proof)];
+      break;
+    case EnumerationResult::UNDECIDED:
+      ++summary.undecided;
+      break;
+  }
+
+  if (output_ == nullptr) {
+    return;
+  }
+  std::string& out = state.buffer;
+  if (format_ == EnumerationFormat::TEXT) {
+    out += to_standard_notation(node.table, options_.num_symbols);
+    out += '\t';
+    out += result_name(result);
+    out += '\t';
+    out += std::to_string(steps);
+    if (result == EnumerationResult::NONHALT) {
+      out += '\t';
+      out += Simulator::proof_to_string(proof);
+    }
+    out += '\n';
+  } else {
+    out.append(reinterpret_cast<const char*>(node.table.data()), node.table.size());
+    out += static_cast<char>(result);
+    out += static_cast<char>(proof);
+    out.append(reinterpret_cast<const char*>(&steps), sizeof(steps));
+  }
+  if (out.size() >= FLUSH_THRESHOLD) {
+    flush(out);
+  }
+}
+
+void Enumerator::flush(std::string& buffer) {
+  if (buffer.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(output_mutex_);
+  if (std::fwrite(buffer.data(), 1, buffer.size(), output_) != buffer.size()) {
+    output_failed_ = true;
+  }
+  buffer.clear();
+}
+
+void Enumerator::expand(const Node& node, WorkStealingPool& pool, size_t worker) {
+  const size_t num_states = options_.num_states;
+  const size_t num_symbols = options_.num_symbols;
+
+  TuringMachine machine = build_machine(node.table, num_states, num_symbols);
+  CompiledMachine compiled;
+  compiled.compile(machine);  // Siempre válida: se construye con estados y símbolos declarados
+  Simulator simulator(&compiled);
+  WorkerState& state = workers_[worker];
+  SimulationResult result = simulator.simulate("", false, options_.max_steps);
+  uint64_t steps = simulator.get_step_count();
+  if (result != SimulationResult::REJECTED) {
+    InfiniteProof proof = simulator.get_infinite_proof();
+    // Los decisores solo se prueban con las que la simulación no decide: las
+    // que se detienen o repiten antes del límite no pagan su presupuesto
+    if (proof == InfiniteProof::NONE && !options_.deciders.empty()) {
+      DeciderPipeline deciders(&compiled);
+      deciders.set_deciders(options_.deciders);  // Lista ya validada en run()
+      deciders.set_budget(options_.budget);
+      simulator.set_deciders(&deciders);
+      simulator.simulate("", false, options_.max_steps);
+      proof = simulator.get_infinite_proof();
+    }
+    record(state, node, proof == InfiniteProof::NONE ? EnumerationResult::UNDECIDED : EnumerationResult::NONHALT,
+           proof, steps);
+    return;
+  }
+  record(state, node, EnumerationResult::HALT, InfiniteProof::NONE, steps);
+
+  // Siempre queda al menos una transición sin definir para detenerse
+  if (node.defined + 1 >= num_states * num_symbols) {
+    return;
+  }
+  const Configuration& config = simulator.get_current_configuration();
+  size_t from = static_cast<size_t>(config.get_current_state()[0] - 'A');
+  char read = config.get_tape().read();
+  size_t symbol = static_cast<size_t>(std::find(SYMBOLS, SYMBOLS + num_symbols, read) - SYMBOLS);
+  size_t slot = from * num_symbols + symbol;
+
+  // Destinos: los estados usados y el siguiente; escritos: los símbolos usados
+  // y el siguiente; la primera transición solo a la derecha
+  size_t max_to = std::min(num_states, node.used_states + 1);
+  size_t max_write = std::min(num_symbols, node.used_symbols + 1);
+  for (size_t to = 0; to < max_to; ++to) {
+    for (size_t write = 0; write < max_write; ++write) {
+      for (size_t move = node.defined == 0 ? 1 : 0; move < 2; ++move) {
+        Node child{node.table, node.defined + 1, std::max(node.used_states, to + 1),
+                   std::max(node.used_symbols, write + 1)};
+        child.table[slot] = static_cast<uint8_t>(1 + (to * num_symbols + write) * 2 + move);
+        pool.push(worker, [this, &pool, child](size_t w) { expand(child, pool, w); });
+      }
+    }
+  }
+}
+
+bool Enumerator::run() {
+  if (options_.num_states == 0 || options_.num_states > MAX_STATES) {
+    last_error_ = "Número de estados fuera de rango (1-" + std::to_string(MAX_STATES) + ")";
+    return false;
+  }
+  if (options_.num_symbols < 2 || options_.num_symbols > MAX_SYMBOLS) {
+    last_error_ = "Número de símbolos fuera de rango (2-" + std::to_string(MAX_SYMBOLS) + ")";
+    return false;
+  }
+
+  // La máquina vacía sirve para validar la lista de decisores
+  Node root{std::vector<uint8_t>(options_.num_states * options_.num_symbols, 0), 0, 1, 1};
+  if (!options_.deciders.empty()) {
+    CompiledMachine compiled;
+    compiled.compile(build_machine(root.table, options_.num_states, options_.num_symbols));
+    DeciderPipeline deciders(&compiled);
+    if (!deciders.set_deciders(options_.deciders)) {
+      last_error_ = deciders.get_last_error();
+      return false;
+    }
+  }
+
+  if (output_ != nullptr && format_ == EnumerationFormat::BINARY) {
+    std::string header("MTEN");
+    header.append(reinterpret_cast<const char*>(&FILE_VERSION), sizeof(FILE_VERSION));
+    header += static_cast<char>(options_.num_states);
+    header += static_cast<char>(options_.num_symbols);
+    uint64_t max_steps = options_.max_steps;
+    header.append(reinterpret_cast<const char*>(&max_steps), sizeof(max_steps));
+    flush(header);
+  }
+
+  // Un recuento por InfiniteProof (BOUNCER es el último)
+  const size_t proof_kinds = static_cast<size_t>(InfiniteProof::BOUNCER) + 1;
+  WorkStealingPool pool(options_.num_workers);
+  workers_.assign(pool.get_num_workers(), WorkerState{});
+  for (WorkerState& state : workers_) {
+    state.summary.proofs.assign(proof_kinds, 0);
+  }
+  pool.submit([this, &pool, &root](size_t w) { expand(root, pool, w); });
+  pool.run();
+
+  summary_ = Summary{};
+  summary_.proofs.assign(proof_kinds, 0);
+  for (WorkerState& state : workers_) {
+    if (output_ != nullptr) {
+      flush(state.buffer);
+    }
+    const Summary& partial = state.summary;
+    summary_.nodes += partial.nodes;
+    summary_.halting += partial.halting;
+    summary_.nonhalting += partial.nonhalting;
+    summary_.undecided += partial.undecided;
+    for (size_t i = 0; i < proof_kinds; ++i) {
+      summary_.proofs[i] += partial.proofs[i];
+    }
+    if (!partial.champion.empty() &&
+        (partial.max_halt_steps > summary_.max_halt_steps ||
+         (partial.max_halt_steps == summary_.max_halt_steps &&
+          (summary_.champion.empty() || partial.champion < summary_.champion)))) {
+      summary_.max_halt_steps = partial.max_halt_steps;
+      summary_.champion = partial.champion;
+    }
+  }
+  if (output_ != nullptr && (output_failed_ || std::fflush(output_) != 0)) {
+    last_error_ = "Error al escribir la base de datos de resultados";
+    return false;
+  }
+  return true;
+}
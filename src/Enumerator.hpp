@@ -0,0 +1,162 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Deciders.hpp"
+#include "Simulator.hpp"
+#include "WorkStealingPool.hpp"
+
+/**
+ * @brief Clasificación de una máquina enumerada
+ */
+enum class EnumerationResult : uint8_t {
+  HALT = 0,       // Llega a una transición sin definir (se detiene)
+  NONHALT = 1,    // Demostrado que no se detiene (InfiniteProof indica cómo)
+  UNDECIDED = 2   // Alcanzó el límite de pasos sin prueba
+};
+
+/**
+ * @brief Formato de la base de datos de resultados
+ */
+enum class EnumerationFormat {
+  BINARY,  // Registros binarios de tamaño fijo
+  TEXT     // Una línea por máquina en notación estándar
+};
+
+/**
+ * @brief Parámetros de una enumeración
+ */
+struct EnumerationOptions {
+  size_t num_states = 2;         // Estados (A, B, ...)
+  size_t num_symbols = 2;        // Símbolos de cinta ('.', '1', ...; '.' es el blanco)
+  size_t max_steps = 1000;       // Límite de pasos por máquina
+  std::string deciders = "all";  // Decisores de no parada (vacío = ninguno)
+  DeciderBudget budget{100000, 0};  // Sin plazo de reloj: resultados reproducibles
+  size_t num_workers = 1;        // Hilos
+};
+
+/**
+ * @brief Enumeración de todas las máquinas de n estados y m símbolos (mt-enum)
+ *
+ * Las máquinas se generan en forma normal de árbol: se parte de la máquina sin
+ * transiciones y se simula desde la cinta en blanco; las transiciones solo se
+ * definen cuando la simulación llega a ellas. Llegar a una sin definir es
+ * detenerse (como en Simulator: REJECT por falta de transición), así que ese
+ * nodo es una máquina que se detiene; si aún puede definirse otra transición
+ * (siempre queda al menos una sin definir para parar), sus hijos son todas
+ * las formas de definir la que se alcanzó y se vuelven a simular.
+ *
+ * Las simetrías se podan al generar: los estados nuevos aparecen en orden (el
+ * destino es un estado ya usado o el siguiente sin usar), igual que los
+ * símbolos escritos, y la primera transición mueve a la derecha (la máquina
+ * reflejada se comporta igual). No se genera el movimiento S.
+ *
+ * Cada nodo se compila con CompiledMachine y se simula con Simulator; solo si
+ * llega al límite de pasos sin prueba se vuelve a simular con la cadena de
+ * decisores. Los nodos se reparten entre hilos con robo de trabajo
+ * (un nodo encola sus hijos en su propio hilo y los hilos libres roban los
+ * subárboles pendientes más antiguos).
+ *
+ * Base de datos binaria: cabecera "MTEN" + versión (u32), estados (u8),
+ * símbolos (u8) y límite de pasos (u64); por máquina, la tabla (un byte por
+ * estado y símbolo leído: 0 sin definir, si no 1 + (destino·m + escrito)·2 +
+ * movimiento con 0 = L y 1 = R), resultado (u8), prueba (u8, InfiniteProof) y
+ * pasos (u64). Enteros en el orden de bytes del anfitrión. Los registros van
+ * en el orden en que terminan los hilos.
+ */
+class Enumerator {
+public:
+  static constexpr size_t MAX_STATES = 8;            // Estados máximos
+  static constexpr size_t MAX_SYMBOLS = 4;           // Símbolos máximos ('.', '1', '2', '3')
+  static constexpr uint32_t FILE_VERSION = 1;
+  static constexpr size_t FLUSH_THRESHOLD = 1 << 16; // Bytes de un hilo antes de volcar
+
+  /**
+   * @brief Recuento de resultados
+   */
+  struct Summary {
+    uint64_t nodes = 0;                       // Máquinas simuladas (nodos del árbol)
+    uint64_t halting = 0;                     // Se detienen
+    uint64_t nonhalting = 0;                  // No se detienen, demostrado
+    uint64_t undecided = 0;                   // Sin decidir
+    std::vector<uint64_t> proofs;             // No se detienen, por InfiniteProof
+    uint64_t max_halt_steps = 0;              // Pasos de la que más tarda en detenerse
+    std::string champion;                     // Esa máquina, en notación estándar
+  };
+
+private:
+  /**
+   * @brief Máquina parcial (nodo del árbol)
+   */
+  struct Node {
+    std::vector<uint8_t> table;  // Transiciones, codificadas como en la base de datos
+    size_t defined;              // Transiciones definidas
+    size_t used_states;          // Estados usados (los primeros)
+    size_t used_symbols;         // Símbolos escritos o leídos (los primeros)
+  };
+
+  /**
+   * @brief Estado propio de cada hilo
+   */
+  struct WorkerState {
+    Summary summary;             // Recuento parcial
+    std::string buffer;          // Registros pendientes de volcar
+  };
+
+  EnumerationOptions options_;              // Parámetros
+  std::FILE* output_;                       // Base de datos (nullptr = sin salida)
+  EnumerationFormat format_;                // Formato de la base de datos
+  std::mutex output_mutex_;                 // Serializa los volcados
+  std::atomic<bool> output_failed_;         // Si falló alguna escritura
+  std::vector<WorkerState> workers_;        // Estado de cada hilo
+  Summary summary_;                         // Recuento total tras run()
+  std::string last_error_;                  // Último error ocurrido
+
+  /**
+   * @brief Simula un nodo, anota su resultado y encola sus hijos
+   */
+  void expand(const Node& node, WorkStealingPool& pool, size_t worker);
+
+  /**
+   * @brief Añade el registro de un nodo al buffer del hilo
+   */
+  void record(WorkerState& state, const Node& node, EnumerationResult result, InfiniteProof proof,
+              uint64_t steps);
+
+  /**
+   * @brief Vuelca un buffer en la base de datos
+   */
+  void flush(std::string& buffer);
+
+public:
+  /**
+   * @brief Constructor
+   * @param options Parámetros (se validan en run())
+   */
+  explicit Enumerator(const EnumerationOptions& options);
+
+  /**
+   * @brief Escribe los resultados en un fichero abierto (no se cierra)
+   */
+  void set_output(std::FILE* output, EnumerationFormat format);
+
+  /**
+   * @brief Enumera todas las máquinas
+   * @return false si los parámetros no son válidos o falló la escritura
+   */
+  bool run();
+
+  /**
+   * @brief Máquina en notación estándar: una parte por estado separadas por
+   *        '_', tres caracteres por símbolo leído (escrito, L/R, destino) y
+   *        "---" si no está definida
+   */
+  static std::string to_standard_notation(const std::vector<uint8_t>& table, size_t num_symbols);
+
+  const Summary& get_summary() const { return summary_; }
+  const std::string& get_last_error() const { return last_error_; }
+};
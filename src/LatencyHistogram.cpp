@@ -0,0 +1,33 @@
+#include "LatencyHistogram.hpp"
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram()
+  : counts_(NUM_BUCKETS, 0), total_(0), min_(0), max_(0) {
+}
+
+uint64_t LatencyHistogram::bucket_upper_bound(size_t index) {
+  if (index < 2 * SUB_BUCKETS) {
+    return index;
+  }
+  size_t shift = index / SUB_BUCKETS - 1;
+  uint64_t lower = static_cast<uint64_t>(index % SUB_BUCKETS + SUB_BUCKETS) << shift;
+  return lower + ((uint64_t{1} << shift) - 1);
+}
+
+uint64_t LatencyHistogram::percentile(double quantile) const {
+  if (total_ == 0) {
+    return 0;
+  }
+  // Rango del valor buscado entre los registros ordenados (al menos el primero)
+  double wanted = std::ceil(quantile * static_cast<double>(total_));
+  uint64_t rank = wanted < 1.0 ? 1 : static_cast<uint64_t>(wanted);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      uint64_t bound = bucket_upper_bound(i);
+      return bound < max_ ? bound : max_;
+    }
+  }
+  return max_;
+}
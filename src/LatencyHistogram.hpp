@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Histograma de valores enteros con cubetas logarítmicas (estilo HDR)
+ *
+ * Cada potencia de dos se divide en SUB_BUCKETS cubetas iguales, así que el
+ * error relativo de un percentil es como mucho 1/SUB_BUCKETS (~3%) sea cual
+ * sea la magnitud, y todo el rango de uint64_t cabe en menos de 2000
+ * contadores. Los valores menores que 2·SUB_BUCKETS se guardan exactos.
+ *
+ * record() es en línea y solo calcula un índice e incrementa un contador.
+ */
+class LatencyHistogram {
+public:
+  static constexpr int SUB_BUCKET_BITS = 5;                      // Cubetas por potencia de dos: 2^5
+  static constexpr uint64_t SUB_BUCKETS = uint64_t{1} << SUB_BUCKET_BITS;
+  static constexpr size_t NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+private:
+  std::vector<uint64_t> counts_;  // Valores por cubeta
+  uint64_t total_;                // Valores registrados
+  uint64_t min_;                  // Valor mínimo
+  uint64_t max_;                  // Valor máximo
+
+  /**
+   * @brief Cubeta de un valor
+   */
+  static size_t bucket_index(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+      return static_cast<size_t>(value);
+    }
+    int shift = 63 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+    return static_cast<size_t>(shift + 1) * SUB_BUCKETS + static_cast<size_t>(value >> shift) - SUB_BUCKETS;
+  }
+
+  /**
+   * @brief Mayor valor que cae en una cubeta
+   */
+  static uint64_t bucket_upper_bound(size_t index);
+
+public:
+  /**
+   * @brief Constructor: histograma vacío
+   */
+  LatencyHistogram();
+
+  /**
+   * @brief Registra un valor
+   */
+  void record(uint64_t value) {
+    counts_[bucket_index(value)]++;
+    if (total_ == 0 || value < min_) {
+      min_ = value;
+    }
+    if (value > max_) {
+      max_ = value;
+    }
+    total_++;
+  }
+
+  /**
+   * @brief Valor por debajo del cual queda la fracción pedida de los registros
+   * @param quantile Fracción entre 0 y 1 (0.99 es el percentil 99)
+   * @return Límite superior de la cubeta del percentil, acotado por el máximo
+   *         (0 si el histograma está vacío)
+   */
+  uint64_t percentile(double quantile) const;
+
+  uint64_t get_count() const { return total_; }
+  uint64_t get_min() const { return total_ > 0 ? min_ : 0; }
+  uint64_t get_max() const { return max_; }
+};
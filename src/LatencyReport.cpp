@@ -0,0 +1,106 @@
+#include "LatencyReport.hpp"
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+
+const double QUANTILES[] = {0.50, 0.90, 0.99, 0.999};
+const char* const QUANTILE_NAMES[] = {"p50", "p90", "p99", "p99.9"};
+
+}  // namespace
+
+bool LatencyReport::faster(const SlowWord& a, const SlowWord& b) {
+  return a.nanoseconds > b.nanoseconds;
+}
+
+LatencyReport::LatencyReport(size_t slowest_limit)
+  : slowest_limit_(slowest_limit) {
+  slowest_.reserve(slowest_limit);
+}
+
+void LatencyReport::record(size_t index, std::string_view word, SimulationResult result,
+                           uint64_t nanoseconds, uint64_t steps) {
+  size_t r = static_cast<size_t>(result);
+  if (r < NUM_RESULTS) {
+    time_[r].record(nanoseconds);
+    steps_[r].record(steps);
+  }
+  total_time_.record(nanoseconds);
+  total_steps_.record(steps);
+
+  if (slowest_limit_ == 0) {
+    return;
+  }
+  if (slowest_.size() == slowest_limit_) {
+    if (nanoseconds <= slowest_.front().nanoseconds) {
+      return;
+    }
+    std::pop_heap(slowest_.begin(), slowest_.end(), faster);
+    slowest_.pop_back();
+  }
+  slowest_.push_back({nanoseconds, steps, index, result,
+                      std::string(word.substr(0, MAX_WORD_LENGTH + 1))});
+  std::push_heap(slowest_.begin(), slowest_.end(), faster);
+}
+
+void LatencyReport::print_table(std::ostream& out, const char* title,
+                                const LatencyHistogram* by_result, const LatencyHistogram& total,
+                                bool nanoseconds) const {
+  auto cell = [&out, nanoseconds](uint64_t value) {
+    if (nanoseconds) {
+      out << std::setw(12) << std::fixed << std::setprecision(1) << static_cast<double>(value) / 1000.0;
+    } else {
+      out << std::setw(12) << value;
+    }
+  };
+  auto row = [&](const std::string& name, const LatencyHistogram& histogram) {
+    out << std::left << std::setw(10) << name << std::right << std::setw(10) << histogram.get_count();
+    for (double quantile : QUANTILES) {
+      cell(histogram.percentile(quantile));
+    }
+    cell(histogram.get_max());
+    out << "\n";
+  };
+
+  out << "\n" << title << ":\n";
+  out << std::left << std::setw(10) << "resultado" << std::right << std::setw(10) << "palabras";
+  for (const char* name : QUANTILE_NAMES) {
+    out << std::setw(12) << name;
+  }
+  out << std::setw(13) << "máx" << "\n";  // setw cuenta bytes: "á" ocupa dos
+  for (size_t r = 0; r < NUM_RESULTS; ++r) {
+    if (by_result[r].get_count() > 0) {
+      row(Simulator::result_to_string(static_cast<SimulationResult>(r)), by_result[r]);
+    }
+  }
+  row("total", total);
+}
+
+void LatencyReport::print_report(std::ostream& out) const {
+  out << "=== Latencia por palabra ===\n";
+  out << "Palabras simuladas: " << total_time_.get_count()
+      << " (percentiles con un error relativo de hasta un "
+      << 100 / LatencyHistogram::SUB_BUCKETS << "%)\n";
+  print_table(out, "Tiempo (µs)", time_, total_time_, true);
+  print_table(out, "Pasos", steps_, total_steps_, false);
+
+  if (!slowest_.empty()) {
+    std::vector<SlowWord> sorted = slowest_;
+    std::sort(sorted.begin(), sorted.end(), faster);
+    out << "\nPalabras más lentas:\n";
+    out << std::setw(13) << "µs" << std::setw(14) << "pasos" << std::setw(11) << "índice"
+        << "  resultado  palabra\n";
+    for (const SlowWord& slow : sorted) {
+      out << std::setw(12) << std::fixed << std::setprecision(1)
+          << static_cast<double>(slow.nanoseconds) / 1000.0 << std::setw(14) << slow.steps
+          << std::setw(10) << slow.index << "  " << std::left << std::setw(9)
+          << Simulator::result_to_string(slow.result) << std::right << "  \""
+          << std::string_view(slow.word).substr(0, MAX_WORD_LENGTH) << "\"";
+      if (slow.word.size() > MAX_WORD_LENGTH) {
+        out << "...";
+      }
+      out << "\n";
+    }
+  }
+  out << std::defaultfloat;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "LatencyHistogram.hpp"
+#include "Simulator.hpp"
+
+/**
+ * @brief Latencia por palabra de una ejecución por lotes (mt-sim --latency)
+ *
+ * Guarda, para cada resultado (ACCEPT, REJECT, INFINITE, ERROR, TIMEOUT), un
+ * histograma del tiempo de reloj de cada palabra y otro de sus pasos, y las K
+ * palabras más lentas en un montículo acotado: una palabra solo se copia si
+ * entra entre las K más lentas.
+ */
+class LatencyReport {
+public:
+  static constexpr size_t MAX_WORD_LENGTH = 64;  // Caracteres de palabra guardados en las más lentas
+
+private:
+  static constexpr size_t NUM_RESULTS = 5;  // Valores de SimulationResult
+
+  /**
+   * @brief Una de las palabras más lentas
+   */
+  struct SlowWord {
+    uint64_t nanoseconds;  // Tiempo de la palabra
+    uint64_t steps;        // Pasos simulados
+    size_t index;          // Índice de la palabra en la entrada
+    SimulationResult result;
+    std::string word;      // Palabra (recortada a MAX_WORD_LENGTH + 1 para saber si sigue)
+  };
+
+  /**
+   * @brief Orden del montículo: la más rápida de las guardadas queda en la cima
+   */
+  static bool faster(const SlowWord& a, const SlowWord& b);
+
+  LatencyHistogram time_[NUM_RESULTS];   // Nanosegundos por resultado
+  LatencyHistogram steps_[NUM_RESULTS];  // Pasos por resultado
+  LatencyHistogram total_time_;          // Nanosegundos de todas las palabras
+  LatencyHistogram total_steps_;         // Pasos de todas las palabras
+  size_t slowest_limit_;                 // K: palabras más lentas a conservar
+  std::vector<SlowWord> slowest_;        // Montículo de mínimos por tiempo
+
+  /**
+   * @brief Escribe una tabla de percentiles (una fila por resultado y el total)
+   */
+  void print_table(std::ostream& out, const char* title, const LatencyHistogram* by_result,
+                   const LatencyHistogram& total, bool nanoseconds) const;
+
+public:
+  /**
+   * @brief Constructor
+   * @param slowest_limit Palabras más lentas a listar (0 = ninguna)
+   */
+  explicit LatencyReport(size_t slowest_limit);
+
+  /**
+   * @brief Registra una palabra
+   * @param index Índice de la palabra en la entrada
+   * @param word Palabra
+   * @param result Resultado de la simulación
+   * @param nanoseconds Tiempo de reloj empleado
+   * @param steps Pasos simulados
+   */
+  void record(size_t index, std::string_view word, SimulationResult result, uint64_t nanoseconds,
+              uint64_t steps);
+
+  /**
+   * @brief Escribe los percentiles p50/p90/p99/p99.9/máx de tiempo y pasos por
+   *        resultado y, si se pidieron, las palabras más lentas
+   */
+  void print_report(std::ostream& out) const;
+};
@@ -0,0 +1,257 @@
+#include "MachineFactory.hpp"
+#include <stdexcept>
+#include <vector>
+#include "SplitMix64.hpp"
+
+namespace {
+
+/**
+ * @brief Declara estados, alfabetos (el de cinta añade el blanco), estado
+ *        inicial (el primero) y estado de aceptación
+ */
+template <typename Machine>
+void declare(Machine& machine, const std::vector<std::string>& states, const std::string& input,
+             const std::string& accept) {
+  for (const std::string& state : states) {
+    machine.add_state(state);
+  }
+  for (char symbol : input) {
+    machine.add_input_symbol(symbol);
+    machine.add_tape_symbol(symbol);
+  }
+  machine.add_tape_symbol('.');
+  machine.set_initial_state(states.front());
+  machine.add_accept_state(accept);
+}
+
+struct BusyBeaverRule {
+  char from;
+  char read;
+  char to;
+  char write;
+  Movement movement;
+};
+
+// Campeones en pasos: estado, leído, destino, escrito y movimiento ('.' hace de 0)
+const std::vector<BusyBeaverRule>& busy_beaver_rules(int num_states) {
+  static const std::vector<BusyBeaverRule> bb2 = {
+      {'A', '.', 'B', '1', Movement::RIGHT}, {'A', '1', 'B', '1', Movement::LEFT},
+      {'B', '.', 'A', '1', Movement::LEFT},  {'B', '1', 'H', '1', Movement::RIGHT}};
+  static const std::vector<BusyBeaverRule> bb3 = {
+      {'A', '.', 'B', '1', Movement::RIGHT}, {'A', '1', 'H', '.', Movement::RIGHT},
+      {'B', '.', 'B', '1', Movement::LEFT},  {'B', '1', 'C', '.', Movement::RIGHT},
+      {'C', '.', 'C', '1', Movement::LEFT},  {'C', '1', 'A', '1', Movement::LEFT}};
+  static const std::vector<BusyBeaverRule> bb4 = {
+      {'A', '.', 'B', '1', Movement::RIGHT}, {'A', '1', 'B', '1', Movement::LEFT},
+      {'B', '.', 'A', '1', Movement::LEFT},  {'B', '1', 'C', '.', Movement::LEFT},
+      {'C', '.', 'H', '1', Movement::RIGHT}, {'C', '1', 'D', '1', Movement::LEFT},
+      {'D', '.', 'D', '1', Movement::RIGHT}, {'D', '1', 'A', '.', Movement::RIGHT}};
+  static const std::vector<BusyBeaverRule> bb5 = {
+      {'A', '.', 'B', '1', Movement::RIGHT}, {'A', '1', 'C', '1', Movement::LEFT},
+      {'B', '.', 'C', '1', Movement::RIGHT}, {'B', '1', 'B', '1', Movement::RIGHT},
+      {'C', '.', 'D', '1', Movement::RIGHT}, {'C', '1', 'E', '.', Movement::LEFT},
+      {'D', '.', 'A', '1', Movement::LEFT},  {'D', '1', 'D', '1', Movement::LEFT},
+      {'E', '.', 'H', '1', Movement::RIGHT}, {'E', '1', 'A', '.', Movement::LEFT}};
+  switch (num_states) {
+    case 2:
+      return bb2;
+    case 3:
+      return bb3;
+    case 4:
+      return bb4;
+    default:
+      return bb5;
+  }
+}
+
+/**
+ * @brief Valida los parámetros y declara la parte común de una máquina aleatoria
+ * @return Número de combinaciones de lectura por estado
+ */
+template <typename Machine>
+size_t declare_random(Machine& machine, const MachineFactory::RandomOptions& options, size_t num_tapes) {
+  const std::string& pool = MachineFactory::symbol_pool();
+  if (options.num_states == 0) {
+    throw std::invalid_argument("La máquina aleatoria necesita al menos un estado");
+  }
+  if (options.num_symbols == 0 || options.num_symbols > pool.size()) {
+    throw std::invalid_argument("Número de símbolos fuera de rango (1-" + std::to_string(pool.size()) + ")");
+  }
+  if (num_tapes == 0) {
+    throw std::invalid_argument("La máquina aleatoria necesita al menos una cinta");
+  }
+  if (!(options.density >= 0.0 && options.density <= 1.0) ||
+      !(options.halt_probability >= 0.0 && options.halt_probability <= 1.0)) {
+    throw std::invalid_argument("La densidad y la probabilidad de parada deben estar entre 0 y 1");
+  }
+
+  size_t per_state = 1;
+  for (size_t t = 0; t < num_tapes; ++t) {
+    per_state *= options.num_symbols + 1;
+    if (per_state * options.num_states > MachineFactory::MAX_RANDOM_TRANSITIONS) {
+      throw std::invalid_argument("La máquina aleatoria tendría más de " +
+                                  std::to_string(MachineFactory::MAX_RANDOM_TRANSITIONS) +
+                                  " transiciones");
+    }
+  }
+
+  std::vector<std::string> states;
+  for (size_t s = 0; s < options.num_states; ++s) {
+    states.push_back("q" + std::to_string(s));
+  }
+  states.push_back("qf");
+  declare(machine, states, pool.substr(0, options.num_symbols), "qf");
+  machine.reserve_transitions(static_cast<size_t>(static_cast<double>(per_state * options.num_states) *
+                                                  options.density) + 1);
+  return per_state;
+}
+
+/**
+ * @brief Sortea las transiciones de una máquina aleatoria
+ * @param emit Recibe (origen, lecturas, destino, escrituras, movimientos) de cada transición
+ */
+template <typename Emit>
+void generate_random(const MachineFactory::RandomOptions& options, size_t num_tapes, size_t per_state,
+                     Emit emit) {
+  static const Movement MOVES[] = {Movement::LEFT, Movement::RIGHT, Movement::STAY};
+  std::string tape_symbols = MachineFactory::symbol_pool().substr(0, options.num_symbols) + ".";
+  size_t radix = tape_symbols.size();
+  SplitMix64 random(options.seed);
+
+  std::vector<char> reads(num_tapes), writes(num_tapes);
+  std::vector<Movement> moves(num_tapes);
+  for (size_t s = 0; s < options.num_states; ++s) {
+    std::string from = "q" + std::to_string(s);
+    for (size_t combination = 0; combination < per_state; ++combination) {
+      // Cada sorteo se hace siempre, se defina o no la transición, para que
+      // cambiar la densidad no desplace las demás decisiones
+      bool defined = random.unit() < options.density;
+      bool halts = random.unit() < options.halt_probability;
+      size_t target = random.below(options.num_states);
+      size_t rest = combination;
+      for (size_t t = 0; t < num_tapes; ++t) {
+        reads[t] = tape_symbols[rest % radix];
+        rest /= radix;
+        writes[t] = tape_symbols[random.below(radix)];
+        moves[t] = MOVES[random.below(3)];
+      }
+      if (defined) {
+        emit(from, reads, halts ? std::string("qf") : "q" + std::to_string(target), writes, moves);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+const std::string& MachineFactory::symbol_pool() {
+  static const std::string pool = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  return pool;
+}
+
+TuringMachine MachineFactory::busy_beaver(int num_states) {
+  if (num_states < 2 || num_states > 5) {
+    throw std::invalid_argument("Busy Beaver solo está disponible para 2 a 5 estados");
+  }
+  TuringMachine machine;
+  std::vector<std::string> states;
+  for (int i = 0; i < num_states; ++i) {
+    states.push_back(std::string(1, static_cast<char>('A' + i)));
+  }
+  states.push_back("H");
+  declare(machine, states, "1", "H");
+  for (const BusyBeaverRule& rule : busy_beaver_rules(num_states)) {
+    machine.add_transition(std::string(1, rule.from), rule.read, std::string(1, rule.to),
+                           rule.write, rule.movement);
+  }
+  return machine;
+}
+
+TuringMachine MachineFactory::unary_counter() {
+  TuringMachine machine;
+  declare(machine, {"q0", "q1", "q2", "qf"}, "1", "qf");
+  machine.add_transition("q0", '1', "q0", '1', Movement::RIGHT);
+  machine.add_transition("q0", '.', "q1", '.', Movement::LEFT);
+  machine.add_transition("q1", '1', "q2", '.', Movement::LEFT);
+  machine.add_transition("q1", '.', "qf", '.', Movement::STAY);
+  machine.add_transition("q2", '1', "q2", '1', Movement::LEFT);
+  machine.add_transition("q2", '.', "q0", '.', Movement::RIGHT);
+  return machine;
+}
+
+TuringMachine MachineFactory::binary_counter() {
+  TuringMachine machine;
+  declare(machine, {"q0", "q1", "q2", "qf"}, "01", "qf");
+  machine.add_transition("q0", '0', "q0", '0', Movement::RIGHT);
+  machine.add_transition("q0", '1', "q0", '1', Movement::RIGHT);
+  machine.add_transition("q0", '.', "q1", '.', Movement::LEFT);
+  machine.add_transition("q1", '1', "q1", '0', Movement::LEFT);
+  machine.add_transition("q1", '0', "q2", '1', Movement::LEFT);
+  machine.add_transition("q1", '.', "q2", '1', Movement::LEFT);
+  machine.add_transition("q2", '0', "q2", '0', Movement::LEFT);
+  machine.add_transition("q2", '1', "q2", '1', Movement::LEFT);
+  machine.add_transition("q2", '.', "qf", '.', Movement::RIGHT);
+  return machine;
+}
+
+TuringMachine MachineFactory::sorter() {
+  TuringMachine machine;
+  declare(machine, {"q0", "q1", "q2", "q3", "qf"}, "ab", "qf");
+  // q0/q1: buscar una a detrás de una b; si no la hay, la palabra está ordenada
+  machine.add_transition("q0", 'a', "q0", 'a', Movement::RIGHT);
+  machine.add_transition("q0", 'b', "q1", 'b', Movement::RIGHT);
+  machine.add_transition("q0", '.', "qf", '.', Movement::STAY);
+  machine.add_transition("q1", 'b', "q1", 'b', Movement::RIGHT);
+  machine.add_transition("q1", 'a', "q2", 'b', Movement::LEFT);
+  machine.add_transition("q1", '.', "qf", '.', Movement::STAY);
+  // q2: la b anterior pasa a ser a; q3: volver al principio
+  machine.add_transition("q2", 'b', "q3", 'a', Movement::LEFT);
+  machine.add_transition("q3", 'a', "q3", 'a', Movement::LEFT);
+  machine.add_transition("q3", 'b', "q3", 'b', Movement::LEFT);
+  machine.add_transition("q3", '.', "q0", '.', Movement::RIGHT);
+  return machine;
+}
+
+MultiTuringMachine MachineFactory::tape_copy(size_t num_tapes) {
+  if (num_tapes < 2) {
+    throw std::invalid_argument("La copia necesita al menos 2 cintas");
+  }
+  MultiTuringMachine machine(num_tapes);
+  declare(machine, {"q0", "q1", "qf"}, "ab", "qf");
+
+  std::vector<Movement> right(num_tapes, Movement::RIGHT);
+  std::vector<Movement> left(num_tapes, Movement::LEFT);
+  std::vector<char> blanks(num_tapes, '.');
+  for (char symbol : {'a', 'b'}) {
+    std::vector<char> read = blanks;
+    read[0] = symbol;
+    std::vector<char> copied(num_tapes, symbol);
+    machine.add_transition("q0", read, "q0", copied, right);
+    machine.add_transition("q1", copied, "q1", copied, left);
+  }
+  machine.add_transition("q0", blanks, "q1", blanks, left);
+  machine.add_transition("q1", blanks, "qf", blanks, right);
+  return machine;
+}
+
+TuringMachine MachineFactory::random_machine(const RandomOptions& options) {
+  TuringMachine machine;
+  size_t per_state = declare_random(machine, options, 1);
+  generate_random(options, 1, per_state,
+                  [&machine](const std::string& from, const std::vector<char>& reads, const std::string& to,
+                             const std::vector<char>& writes, const std::vector<Movement>& moves) {
+                    machine.add_transition(from, reads[0], to, writes[0], moves[0]);
+                  });
+  return machine;
+}
+
+MultiTuringMachine MachineFactory::random_multi_machine(const RandomOptions& options) {
+  MultiTuringMachine machine(options.num_tapes);
+  size_t per_state = declare_random(machine, options, options.num_tapes);
+  generate_random(options, options.num_tapes, per_state,
+                  [&machine](const std::string& from, const std::vector<char>& reads, const std::string& to,
+                             const std::vector<char>& writes, const std::vector<Movement>& moves) {
+                    machine.add_transition(from, reads, to, writes, moves);
+                  });
+  return machine;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "TuringMachine.hpp"
+#include "MultiTuringMachine.hpp"
+
+/**
+ * @brief Construcción de máquinas generadas: familias conocidas y aleatorias
+ *
+ * Las usan mt-gen (para escribirlas con el Parser) y los bancos de pruebas.
+ * Todas usan '.' como símbolo blanco y "qf" (o "H" en Busy Beaver) como único
+ * estado de aceptación. Las aleatorias dependen solo de la semilla: la misma
+ * semilla y los mismos parámetros dan siempre la misma máquina.
+ */
+class MachineFactory {
+public:
+  /**
+   * @brief Parámetros de una máquina aleatoria
+   */
+  struct RandomOptions {
+    uint64_t seed = 1;              // Semilla
+    size_t num_states = 4;          // Estados sin contar qf
+    size_t num_symbols = 2;         // Símbolos de entrada (la cinta añade el blanco)
+    size_t num_tapes = 1;           // Cintas
+    double density = 1.0;           // Probabilidad de definir cada (estado, lectura)
+    double halt_probability = 0.05; // Probabilidad de que una transición vaya a qf
+  };
+
+  static constexpr size_t MAX_RANDOM_TRANSITIONS = 10000000;  // Límite de transiciones aleatorias
+
+  /**
+   * @brief Campeón de Busy Beaver en pasos (H es el estado de parada)
+   * @param num_states Estados: de 2 a 5 (6, 21, 107 y 47.176.870 pasos)
+   * @return Máquina monocinta con entrada vacía y alfabeto de entrada {1}
+   * @throws std::invalid_argument si num_states no está entre 2 y 5
+   */
+  static TuringMachine busy_beaver(int num_states);
+
+  /**
+   * @brief Contador unario: borra el último 1 en cada pasada hasta vaciar la
+   *        cinta (n²/2 pasos para 1^n)
+   */
+  static TuringMachine unary_counter();
+
+  /**
+   * @brief Contador binario: suma 1 al número de la cinta y vuelve al
+   *        principio (unos 3n pasos para 1^n)
+   */
+  static TuringMachine binary_counter();
+
+  /**
+   * @brief Ordenación de palabras sobre {a, b}: intercambia "ba" por "ab" hasta
+   *        que todas las a quedan delante
+   */
+  static TuringMachine sorter();
+
+  /**
+   * @brief Copia la palabra de la cinta 1 (sobre {a, b}) en las demás y
+   *        rebobina todas
+   * @param num_tapes Cintas (al menos 2)
+   * @throws std::invalid_argument si num_tapes < 2
+   */
+  static MultiTuringMachine tape_copy(size_t num_tapes);
+
+  /**
+   * @brief Máquina monocinta aleatoria (options.num_tapes se ignora)
+   * @throws std::invalid_argument si los parámetros no son válidos
+   */
+  static TuringMachine random_machine(const RandomOptions& options);
+
+  /**
+   * @brief Máquina multicinta aleatoria
+   * @throws std::invalid_argument si los parámetros no son válidos
+   */
+  static MultiTuringMachine random_multi_machine(const RandomOptions& options);
+
+  /**
+   * @brief Símbolos de entrada de las máquinas aleatorias, en orden
+   */
+  static const std::string& symbol_pool();
+};
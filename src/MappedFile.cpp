@@ -0,0 +1,103 @@
+#include "MappedFile.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile() : data_(nullptr), size_(0), open_(false) {
+}
+
+MappedFile::MappedFile(const std::string& path) : MappedFile() {
+  open(path);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(other.data_), size_(other.size_), open_(other.open_),
+      last_error_(std::move(other.last_error_)) {
+  other.data_ = nullptr;
+  other.size_ = 0;
+  other.open_ = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    close();
+    data_ = other.data_;
+    size_ = other.size_;
+    open_ = other.open_;
+    last_error_ = std::move(other.last_error_);
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.open_ = false;
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() {
+  close();
+}
+
+bool MappedFile::open(const std::string& path, bool sequential) {
+  close();
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    last_error_ = "No se puede abrir el archivo: " + path + " (" + std::strerror(errno) + ")";
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+    last_error_ = "No es un fichero regular proyectable: " + path;
+    ::close(fd);
+    return false;
+  }
+
+  size_ = static_cast<size_t>(info.st_size);
+  if (size_ > 0) {
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      last_error_ = "No se puede proyectar el archivo: " + path + " (" + std::strerror(errno) + ")";
+      ::close(fd);
+      size_ = 0;
+      return false;
+    }
+    if (sequential) {
+      madvise(addr, size_, MADV_SEQUENTIAL);
+    }
+    data_ = static_cast<const char*>(addr);
+  }
+
+  // La proyección sigue siendo válida tras cerrar el descriptor
+  ::close(fd);
+  open_ = true;
+  last_error_.clear();
+  return true;
+}
+
+void MappedFile::close() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  open_ = false;
+}
+
+bool MappedFile::is_open() const {
+  return open_;
+}
+
+std::string_view MappedFile::view() const {
+  return std::string_view(data_ != nullptr ? data_ : "", size_);
+}
+
+size_t MappedFile::size() const {
+  return size_;
+}
+
+const std::string& MappedFile::get_last_error() const {
+  return last_error_;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Proyección en memoria de solo lectura de un fichero completo
+ *
+ * Envuelve open/mmap/munmap con semántica RAII. Un fichero vacío se considera
+ * abierto correctamente y expone una vista vacía. No es copiable pero sí movible.
+ */
+class MappedFile {
+private:
+  const char* data_;        // Inicio de la proyección (nullptr si vacío o cerrado)
+  size_t size_;             // Tamaño del fichero en bytes
+  bool open_;               // Si el fichero se abrió correctamente
+  std::string last_error_;  // Último error ocurrido
+
+public:
+  /**
+   * @brief Constructor de un fichero sin abrir
+   */
+  MappedFile();
+
+  /**
+   * @brief Constructor que abre y proyecta un fichero
+   * @param path Ruta del fichero
+   */
+  explicit MappedFile(const std::string& path);
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  /**
+   * @brief Destructor: libera la proyección
+   */
+  ~MappedFile();
+
+  /**
+   * @brief Abre y proyecta un fichero (cierra el anterior si lo había)
+   * @param path Ruta del fichero
+   * @param sequential Si indicar al núcleo que el acceso será secuencial
+   * @return true si se pudo proyectar
+   */
+  bool open(const std::string& path, bool sequential = true);
+
+  /**
+   * @brief Libera la proyección actual
+   */
+  void close();
+
+  /**
+   * @brief Verifica si hay un fichero proyectado
+   * @return true si está abierto
+   */
+  bool is_open() const;
+
+  /**
+   * @brief Obtiene el contenido completo del fichero
+   * @return Vista sobre la proyección
+   */
+  std::string_view view() const;
+
+  /**
+   * @brief Obtiene el tamaño del fichero
+   * @return Tamaño en bytes
+   */
+  size_t size() const;
+
+  /**
+   * @brief Obtiene el último error ocurrido
+   * @return Mensaje de error
+   */
+  const std::string& get_last_error() const;
+};
@@ -3,7 +3,7 @@
 
 MultiConfiguration::MultiConfiguration(const std::string& initial_state, 
                                        size_t num_tapes,
-                                       const std::string& input_string, 
+                                       std::string_view input_string, 
                                        char blank_symbol)
     : current_state_(initial_state), 
       tapes_(num_tapes, input_string, blank_symbol),
@@ -33,7 +33,7 @@ const std::string& MultiConfiguration::get_current_state() const {
   return current_state_;
 }
 
-void MultiConfiguration::set_current_state(const std::string& state) {
+void MultiConfiguration::set_current_state(std::string_view state) {
   current_state_ = state;
 }
 
@@ -96,6 +96,14 @@ std::string MultiConfiguration::to_compact_string() const {
     oss << tapes_.get_head_position(i);
   }
   oss << "|";
+
+  // Inicio del contenido de cada cinta (el mismo contenido desplazado es
+  // otra configuración)
+  for (size_t i = 0; i < tapes_.get_num_tapes(); ++i) {
+    if (i > 0) oss << ",";
+    oss << tapes_.get_tape(i).get_content_start();
+  }
+  oss << "|";
   
   // Contenidos de cintas
   for (size_t i = 0; i < tapes_.get_num_tapes(); ++i) {
@@ -112,7 +120,7 @@ bool MultiConfiguration::is_equivalent(const MultiConfiguration& other) const {
   // Dos configuraciones son equivalentes si tienen:
   // 1. El mismo estado actual
   // 2. Las mismas posiciones de cabezales
-  // 3. El mismo contenido en todas las cintas
+  // 3. El mismo contenido en todas las cintas, empezando en las mismas celdas
   
   if (current_state_ != other.current_state_) {
     return false;
@@ -128,7 +136,7 @@ bool MultiConfiguration::is_equivalent(const MultiConfiguration& other) const {
       return false;
     }
     
-    if (tapes_.get_tape_content(i) != other.tapes_.get_tape_content(i)) {
+    if (!tapes_.get_tape(i).has_same_content(other.tapes_.get_tape(i))) {
       return false;
     }
   }
@@ -140,8 +148,8 @@ bool MultiConfiguration::operator==(const MultiConfiguration& other) const {
   return is_equivalent(other);
 }
 
-void MultiConfiguration::reset(const std::string& initial_state, 
-                              const std::string& input_string) {
+void MultiConfiguration::reset(std::string_view initial_state, 
+                              std::string_view input_string) {
   current_state_ = initial_state;
   tapes_.reset(input_string);
   step_count_ = 0;
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include "MultiTape.hpp"
 
 /**
@@ -26,7 +27,7 @@ public:
    */
   MultiConfiguration(const std::string& initial_state, 
                      size_t num_tapes,
-                     const std::string& input_string = "", 
+                     std::string_view input_string = "", 
                      char blank_symbol = '.');
 
   /**
@@ -57,7 +58,7 @@ public:
    * @brief Establece el estado actual de la máquina
    * @param state Nuevo estado
    */
-  void set_current_state(const std::string& state);
+  void set_current_state(std::string_view state);
 
   /**
    * @brief Obtiene una referencia a las cintas
@@ -98,7 +99,7 @@ public:
 
   /**
    * @brief Obtiene una representación compacta de la configuración
-   * Formato: "estado|pos1,pos2,...|contenido1|contenido2|..."
+   * Formato: "estado|pos1,pos2,...|inicio1,inicio2,...|contenido1|contenido2|..."
    * @return String con la representación compacta
    */
   std::string to_compact_string() const;
@@ -122,5 +123,5 @@ public:
    * @param initial_state Nuevo estado inicial
    * @param input_string Nueva cadena de entrada para la primera cinta
    */
-  void reset(const std::string& initial_state, const std::string& input_string = "");
+  void reset(std::string_view initial_state, std::string_view input_string = "");
 };
\ No newline at end of file
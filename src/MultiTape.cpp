@@ -15,7 +15,7 @@ MultiTape::MultiTape(size_t num_tapes, char blank_symbol)
   }
 }
 
-MultiTape::MultiTape(size_t num_tapes, const std::string& input_word, char blank_symbol)
+MultiTape::MultiTape(size_t num_tapes, std::string_view input_word, char blank_symbol)
     : num_tapes_(num_tapes) {
   if (num_tapes == 0) {
     throw std::invalid_argument("El número de cintas debe ser mayor que 0");
@@ -105,7 +105,7 @@ char MultiTape::get_blank_symbol() const {
   return tapes_[0].get_blank_symbol();
 }
 
-void MultiTape::reset(const std::string& input_word) {
+void MultiTape::reset(std::string_view input_word) {
   // Reiniciar la primera cinta con la palabra de entrada
   if (!tapes_.empty()) {
     tapes_[0].reset(input_word);
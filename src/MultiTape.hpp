@@ -3,6 +3,7 @@
 #include "Transition.hpp"
 #include <vector>
 #include <string>
+#include <string_view>
 
 /**
  * @brief Clase que representa múltiples cintas para una Máquina de Turing multicinta
@@ -29,7 +30,7 @@ public:
    * @param input_word Palabra inicial para la primera cinta
    * @param blank_symbol Símbolo blanco para todas las cintas
    */
-  MultiTape(size_t num_tapes, const std::string& input_word, char blank_symbol = '.');
+  MultiTape(size_t num_tapes, std::string_view input_word, char blank_symbol = '.');
 
   /**
    * @brief Constructor de copia
@@ -100,7 +101,7 @@ public:
    * @brief Reinicia todas las cintas
    * @param input_word Nueva palabra para la primera cinta (las demás quedan vacías)
    */
-  void reset(const std::string& input_word = "");
+  void reset(std::string_view input_word = "");
 
   /**
    * @brief Obtiene representación visual de todas las cintas
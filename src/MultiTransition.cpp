@@ -1,15 +1,16 @@
 #include "MultiTransition.hpp"
 #include <stdexcept>
 #include <sstream>
+#include <utility>
 
-MultiTransition::MultiTransition(const std::string& from_state,
-                                 const std::vector<char>& read_symbols,
-                                 const std::string& to_state,
-                                 const std::vector<char>& write_symbols,
-                                 const std::vector<Movement>& movements)
-    : from_state_(from_state), read_symbols_(read_symbols),
-      to_state_(to_state), write_symbols_(write_symbols),
-      movements_(movements) {
+MultiTransition::MultiTransition(std::string from_state,
+                                 std::vector<char> read_symbols,
+                                 std::string to_state,
+                                 std::vector<char> write_symbols,
+                                 std::vector<Movement> movements)
+    : from_state_(std::move(from_state)), read_symbols_(std::move(read_symbols)),
+      to_state_(std::move(to_state)), write_symbols_(std::move(write_symbols)),
+      movements_(std::move(movements)) {
   
   if (!is_well_formed()) {
     throw std::invalid_argument("Transición multicinta mal formada: los vectores deben tener el mismo tamaño");
@@ -41,6 +42,21 @@ MultiTransition& MultiTransition::operator=(const MultiTransition& other) {
   return *this;
 }
 
+MultiTransition::MultiTransition(MultiTransition&& other) noexcept
+    : from_state_(std::move(other.from_state_)), read_symbols_(std::move(other.read_symbols_)),
+      to_state_(std::move(other.to_state_)), write_symbols_(std::move(other.write_symbols_)),
+      movements_(std::move(other.movements_)) {
+}
+
+MultiTransition& MultiTransition::operator=(MultiTransition&& other) noexcept {
+  from_state_ = std::move(other.from_state_);
+  read_symbols_ = std::move(other.read_symbols_);
+  to_state_ = std::move(other.to_state_);
+  write_symbols_ = std::move(other.write_symbols_);
+  movements_ = std::move(other.movements_);
+  return *this;
+}
+
 const std::string& MultiTransition::get_from_state() const {
   return from_state_;
 }
@@ -29,12 +29,15 @@ public:
    * @param to_state Estado destino
    * @param write_symbols Vector de símbolos a escribir (uno por cinta)
    * @param movements Vector de movimientos (uno por cinta)
+   *
+   * Los parámetros se toman por valor y se mueven a los miembros: el parser
+   * entrega vectores temporales y así no se copian.
    */
-  MultiTransition(const std::string& from_state,
-                  const std::vector<char>& read_symbols,
-                  const std::string& to_state,
-                  const std::vector<char>& write_symbols,
-                  const std::vector<Movement>& movements);
+  MultiTransition(std::string from_state,
+                  std::vector<char> read_symbols,
+                  std::string to_state,
+                  std::vector<char> write_symbols,
+                  std::vector<Movement> movements);
 
   /**
    * @brief Constructor por defecto
@@ -59,6 +62,12 @@ public:
    */
   MultiTransition& operator=(const MultiTransition& other);
 
+  /**
+   * @brief Constructor y asignación de movimiento
+   */
+  MultiTransition(MultiTransition&& other) noexcept;
+  MultiTransition& operator=(MultiTransition&& other) noexcept;
+
   // Métodos getter para acceso controlado
   const std::string& get_from_state() const;
   const std::vector<char>& get_read_symbols() const;
@@ -2,6 +2,7 @@
 #include "TuringMachine.hpp"
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 
 MultiTuringMachine::MultiTuringMachine(size_t num_tapes, char blank_symbol)
     : initial_state_(""), blank_symbol_(blank_symbol), num_tapes_(num_tapes) {
@@ -63,6 +64,10 @@ void MultiTuringMachine::set_num_tapes(size_t num_tapes) {
 }
 
 void MultiTuringMachine::add_transition(const MultiTransition& transition) {
+  add_transition(MultiTransition(transition));
+}
+
+void MultiTuringMachine::add_transition(MultiTransition&& transition) {
   // Verificar que el número de cintas coincida
   if (transition.get_num_tapes() != num_tapes_) {
     throw std::invalid_argument("El número de cintas de la transición no coincide con la máquina");
@@ -78,11 +83,14 @@ void MultiTuringMachine::add_transition(const MultiTransition& transition) {
   }
   
   // Crear la clave para el mapa de transiciones
-  std::pair<std::string, std::vector<char>> key = {transition.get_from_state(),
-                                                   transition.get_read_symbols()};
+  const std::vector<char>& read_symbols = transition.get_read_symbols();
+  std::pair<std::string, std::string> key = {transition.get_from_state(),
+                                             std::string(read_symbols.begin(), read_symbols.end())};
   
-  // Verificar si ya existe una transición para este estado y símbolos
-  if (transitions_.find(key) != transitions_.end()) {
+  // Insertar con una sola búsqueda; si ya existía, la transición es duplicada.
+  // try_emplace no mueve la transición si la clave ya está, así que sigue
+  // disponible para el mensaje de error
+  if (!transitions_.try_emplace(std::move(key), std::move(transition)).second) {
     std::ostringstream oss;
     oss << "Ya existe una transición para el estado '" << transition.get_from_state() 
         << "' y símbolos [";
@@ -93,8 +101,6 @@ void MultiTuringMachine::add_transition(const MultiTransition& transition) {
     oss << "]";
     throw std::invalid_argument(oss.str());
   }
-  
-  transitions_[key] = transition;
 }
 
 void MultiTuringMachine::add_transition(const std::string& from_state,
@@ -102,19 +108,18 @@ void MultiTuringMachine::add_transition(const std::string& from_state,
                                        const std::string& to_state,
                                        const std::vector<char>& write_symbols,
                                        const std::vector<Movement>& movements) {
-  MultiTransition transition(from_state, read_symbols, to_state, write_symbols, movements);
-  add_transition(transition);
+  add_transition(MultiTransition(from_state, read_symbols, to_state, write_symbols, movements));
 }
 
 const std::unordered_set<std::string>& MultiTuringMachine::get_states() const {
   return states_;
 }
 
-const std::unordered_set<char>& MultiTuringMachine::get_input_alphabet() const {
+const SymbolSet& MultiTuringMachine::get_input_alphabet() const {
   return input_alphabet_;
 }
 
-const std::unordered_set<char>& MultiTuringMachine::get_tape_alphabet() const {
+const SymbolSet& MultiTuringMachine::get_tape_alphabet() const {
   return tape_alphabet_;
 }
 
@@ -140,7 +145,7 @@ const MultiTransition* MultiTuringMachine::get_transition(const std::string& sta
     return nullptr;
   }
   
-  std::pair<std::string, std::vector<char>> key = {state, symbols};
+  std::pair<std::string, std::string> key = {state, std::string(symbols.begin(), symbols.end())};
   auto it = transitions_.find(key);
   if (it != transitions_.end()) {
     return &(it->second);
@@ -183,13 +188,13 @@ bool MultiTuringMachine::is_valid() const {
   }
   
   // Verificar que el símbolo blanco está en el alfabeto de la cinta
-  if (tape_alphabet_.find(blank_symbol_) == tape_alphabet_.end()) {
+  if (!tape_alphabet_.contains(blank_symbol_)) {
     return false;
   }
   
   // Verificar que el alfabeto de entrada es subconjunto del alfabeto de cinta
   for (char symbol : input_alphabet_) {
-    if (tape_alphabet_.find(symbol) == tape_alphabet_.end()) {
+    if (!tape_alphabet_.contains(symbol)) {
       return false;
     }
     if (symbol == blank_symbol_) {
@@ -197,28 +202,13 @@ bool MultiTuringMachine::is_valid() const {
     }
   }
   
-  // Verificar que todas las transiciones están bien formadas
+  // Verificar el número de cintas de cada transición (set_num_tapes() puede
+  // cambiarlo después de añadirlas). Sus estados y símbolos no hace falta
+  // comprobarlos: add_transition() los añade y solo clear() los elimina
   for (const auto& pair : transitions_) {
-    const MultiTransition& trans = pair.second;
-    
-    // Verificar número de cintas
-    if (trans.get_num_tapes() != num_tapes_) {
+    if (pair.second.get_num_tapes() != num_tapes_) {
       return false;
     }
-    
-    // Verificar estados
-    if (states_.find(trans.get_from_state()) == states_.end() ||
-        states_.find(trans.get_to_state()) == states_.end()) {
-      return false;
-    }
-    
-    // Verificar símbolos
-    for (size_t i = 0; i < num_tapes_; ++i) {
-      if (tape_alphabet_.find(trans.get_read_symbol(i)) == tape_alphabet_.end() ||
-          tape_alphabet_.find(trans.get_write_symbol(i)) == tape_alphabet_.end()) {
-        return false;
-      }
-    }
   }
   
   return true;
@@ -229,20 +219,19 @@ bool MultiTuringMachine::is_accept_state(const std::string& state) const {
 }
 
 bool MultiTuringMachine::is_input_symbol(char symbol) const {
-  return input_alphabet_.find(symbol) != input_alphabet_.end();
+  return input_alphabet_.contains(symbol);
 }
 
 bool MultiTuringMachine::is_tape_symbol(char symbol) const {
-  return tape_alphabet_.find(symbol) != tape_alphabet_.end();
+  return tape_alphabet_.contains(symbol);
 }
 
-bool MultiTuringMachine::is_valid_input_word(const std::string& word) const {
-  for (char symbol : word) {
-    if (!is_input_symbol(symbol)) {
-      return false;
-    }
-  }
-  return true;
+bool MultiTuringMachine::is_valid_input_word(std::string_view word) const {
+  return input_alphabet_.contains_all(word);
+}
+
+size_t MultiTuringMachine::find_invalid_input_symbol(std::string_view word) const {
+  return input_alphabet_.find_first_not_in(word);
 }
 
 std::string MultiTuringMachine::get_info() const {
@@ -306,6 +295,10 @@ void MultiTuringMachine::clear() {
   tape_alphabet_.insert(blank_symbol_);
 }
 
+void MultiTuringMachine::reserve_transitions(size_t count) {
+  transitions_.reserve(count);
+}
+
 size_t MultiTuringMachine::get_transition_count() const {
   return transitions_.size();
 }
@@ -340,8 +333,7 @@ MultiTuringMachine MultiTuringMachine::from_mono_machine(const TuringMachine& mo
   // Convertir transiciones monocinta a multicinta
   std::vector<Transition> mono_transitions = mono_machine.get_all_transitions();
   for (const Transition& mono_trans : mono_transitions) {
-    MultiTransition multi_trans = MultiTransition::from_mono_transition(mono_trans, num_tapes, 0);
-    multi_machine.add_transition(multi_trans);
+    multi_machine.add_transition(MultiTransition::from_mono_transition(mono_trans, num_tapes, 0));
   }
   
   return multi_machine;
@@ -3,18 +3,21 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
+#include <string_view>
+#include "SymbolSet.hpp"
 #include "MultiTransition.hpp"
 
 /**
  * @brief Estructura para crear hash de (estado, símbolos_leídos)
+ *
+ * Los símbolos leídos van en un std::string (uno por cinta) y no en un
+ * std::vector<char>: con pocas cintas caben en el búfer interno del string
+ * y construir la clave no reserva memoria.
  */
 struct StateSymbolsHash {
-  size_t operator()(const std::pair<std::string, std::vector<char>>& p) const {
+  size_t operator()(const std::pair<std::string, std::string>& p) const {
     size_t hash1 = std::hash<std::string>()(p.first);
-    size_t hash2 = 0;
-    for (size_t i = 0; i < p.second.size(); ++i) {
-      hash2 ^= std::hash<char>()(p.second[i]) + 0x9e3779b9 + (hash2 << 6) + (hash2 >> 2);
-    }
+    size_t hash2 = std::hash<std::string>()(p.second);
     return hash1 ^ (hash2 << 1);
   }
 };
@@ -35,15 +38,15 @@ struct StateSymbolsHash {
 class MultiTuringMachine {
 private:
   std::unordered_set<std::string> states_;           // Q: Estados de la máquina
-  std::unordered_set<char> input_alphabet_;          // Σ: Alfabeto de entrada
-  std::unordered_set<char> tape_alphabet_;           // Γ: Alfabeto de la cinta
+  SymbolSet input_alphabet_;                         // Σ: Alfabeto de entrada
+  SymbolSet tape_alphabet_;                          // Γ: Alfabeto de la cinta
   std::string initial_state_;                        // q₀: Estado inicial
   std::unordered_set<std::string> accept_states_;    // F: Estados de aceptación
   char blank_symbol_;                                // ⊔: Símbolo blanco
   size_t num_tapes_;                                 // k: Número de cintas
   
   // δ: Función de transición (estado, símbolos) → transición
-  std::unordered_map<std::pair<std::string, std::vector<char>>, MultiTransition, StateSymbolsHash> transitions_;
+  std::unordered_map<std::pair<std::string, std::string>, MultiTransition, StateSymbolsHash> transitions_;
 
 public:
   /**
@@ -108,6 +111,12 @@ public:
    */
   void add_transition(const MultiTransition& transition);
 
+  /**
+   * @brief Añade una transición moviéndola al mapa (sin copiarla)
+   * @param transition Transición a añadir
+   */
+  void add_transition(MultiTransition&& transition);
+
   /**
    * @brief Añade una transición especificando sus componentes
    * @param from_state Estado origen
@@ -134,13 +143,13 @@ public:
    * @brief Obtiene el alfabeto de entrada
    * @return Alfabeto de entrada
    */
-  const std::unordered_set<char>& get_input_alphabet() const;
+  const SymbolSet& get_input_alphabet() const;
 
   /**
    * @brief Obtiene el alfabeto de la cinta
    * @return Alfabeto de la cinta
    */
-  const std::unordered_set<char>& get_tape_alphabet() const;
+  const SymbolSet& get_tape_alphabet() const;
 
   /**
    * @brief Obtiene el estado inicial
@@ -215,7 +224,14 @@ public:
    * @param word Palabra a verificar
    * @return true si todos los símbolos pertenecen al alfabeto de entrada
    */
-  bool is_valid_input_word(const std::string& word) const;
+  bool is_valid_input_word(std::string_view word) const;
+
+  /**
+   * @brief Busca el primer símbolo de una palabra fuera del alfabeto de entrada
+   * @param word Palabra a verificar
+   * @return Posición del primer símbolo inválido, o SymbolSet::npos si no hay
+   */
+  size_t find_invalid_input_symbol(std::string_view word) const;
 
   // Métodos de información
 
@@ -230,6 +246,12 @@ public:
    */
   void clear();
 
+  /**
+   * @brief Reserva espacio para un número de transiciones
+   * @param count Número de transiciones previsto (evita rehacer la tabla al cargar)
+   */
+  void reserve_transitions(size_t count);
+
   /**
    * @brief Obtiene el número total de transiciones
    * @return Número de transiciones
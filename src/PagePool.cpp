@@ -0,0 +1,31 @@
+#include "PagePool.hpp"
+#include <cstring>
+
+PagePool::~PagePool() {
+  for (uint8_t* page : free_pages_) {
+    delete[] page;
+  }
+}
+
+uint8_t* PagePool::acquire() {
+  if (free_pages_.empty()) {
+    return new uint8_t[PAGE_BYTES]();
+  }
+  uint8_t* page = free_pages_.back();
+  free_pages_.pop_back();
+  std::memset(page, 0, PAGE_BYTES);
+  return page;
+}
+
+void PagePool::release(uint8_t* page) {
+  if (free_pages_.size() < MAX_FREE_PAGES) {
+    free_pages_.push_back(page);
+  } else {
+    delete[] page;
+  }
+}
+
+PagePool& PagePool::local() {
+  thread_local PagePool pool;
+  return pool;
+}
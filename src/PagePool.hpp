@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Páginas de memoria de tamaño fijo reutilizables (cintas paginadas)
+ *
+ * Las cintas piden y devuelven páginas constantemente (al crecer, al volver a
+ * quedar en blanco una página, al copiar configuraciones para la traza o al
+ * reiniciar con otra palabra). El conjunto guarda hasta MAX_FREE_PAGES
+ * páginas devueltas para no pasar por el asignador de memoria en cada caso.
+ *
+ * Cada hilo usa su propio conjunto (local()), así que no hay bloqueos; una
+ * página puede devolverse a un conjunto distinto del que la dio.
+ */
+class PagePool {
+public:
+  static constexpr size_t PAGE_BYTES = 4096;       // Bytes por página
+  static constexpr size_t MAX_FREE_PAGES = 1024;   // Páginas libres conservadas (4 MiB)
+
+private:
+  std::vector<uint8_t*> free_pages_;  // Páginas devueltas, listas para reutilizar
+
+public:
+  PagePool() = default;
+  ~PagePool();
+
+  PagePool(const PagePool&) = delete;
+  PagePool& operator=(const PagePool&) = delete;
+
+  /**
+   * @brief Entrega una página con todos sus bytes a cero
+   */
+  uint8_t* acquire();
+
+  /**
+   * @brief Devuelve una página obtenida con acquire()
+   */
+  void release(uint8_t* page);
+
+  /**
+   * @brief Conjunto del hilo actual
+   */
+  static PagePool& local();
+};
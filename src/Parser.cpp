@@ -1,49 +1,148 @@
 #include "Parser.hpp"
+#include "MappedFile.hpp"
 #include "MultiTuringMachine.hpp"
 #include "MultiTransition.hpp"
-#include <iostream>
-#include <sstream>
+#include <iterator>
+#include <ostream>
 #include <stdexcept>
 #include <algorithm>
 
 // Inicialización de la variable estática
 std::string Parser::last_error_ = "";
 
-std::string Parser::trim(const std::string& str) {
-  size_t start = str.find_first_not_of(" \t\r\n");
-  if (start == std::string::npos) {
-    return "";
+namespace {
+
+// Espacios que delimitan una línea vacía (trim) y los que separan tokens (operator>>)
+bool is_trim_space(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool is_token_space(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+std::string line_prefix(int line_number) {
+  return "Línea " + std::to_string(line_number) + ": ";
+}
+
+/**
+ * @brief Escribe las secciones de una máquina (mono o multicinta) en el formato de fichero
+ *
+ * Estados y transiciones se escriben ordenados para que la salida no dependa
+ * del orden de los contenedores hash.
+ */
+template <typename Machine>
+void write_sections(std::ostream& file, const Machine& machine) {
+  auto write_list = [&file](const auto& items) {
+    bool first = true;
+    for (const auto& item : items) {
+      if (!first) file << " ";
+      file << item;
+      first = false;
+    }
+    file << "\n";
+  };
+
+  std::vector<std::string> states(machine.get_states().begin(), machine.get_states().end());
+  std::sort(states.begin(), states.end());
+  file << "# Estados\n";
+  write_list(states);
+  file << "# Alfabeto de entrada\n";
+  write_list(machine.get_input_alphabet());
+  file << "# Alfabeto de cinta\n";
+  write_list(machine.get_tape_alphabet());
+  file << "# Estado inicial\n";
+  file << machine.get_initial_state() << "\n";
+  file << "# Símbolo blanco\n";
+  file << machine.get_blank_symbol() << "\n";
+
+  std::vector<std::string> accept_states(machine.get_accept_states().begin(),
+                                         machine.get_accept_states().end());
+  std::sort(accept_states.begin(), accept_states.end());
+  file << "# Estados de aceptación\n";
+  write_list(accept_states);
+
+  std::vector<std::string> transitions;
+  for (const auto& transition : machine.get_all_transitions()) {
+    transitions.push_back(transition.to_string());
+  }
+  std::sort(transitions.begin(), transitions.end());
+  file << "# Transiciones\n";
+  for (const std::string& transition : transitions) {
+    file << transition << "\n";
   }
-  size_t end = str.find_last_not_of(" \t\r\n");
-  return str.substr(start, end - start + 1);
 }
 
-std::vector<std::string> Parser::split(const std::string& str) {
-  std::vector<std::string> tokens;
-  std::istringstream iss(str);
-  std::string token;
-  
-  while (iss >> token) {
-    tokens.push_back(token);
+}  // namespace
+
+std::string_view Parser::trim(std::string_view str) {
+  size_t start = 0;
+  while (start < str.size() && is_trim_space(str[start])) {
+    start++;
   }
-  
-  return tokens;
+  size_t end = str.size();
+  while (end > start && is_trim_space(str[end - 1])) {
+    end--;
+  }
+  return str.substr(start, end - start);
 }
 
-bool Parser::is_comment(const std::string& line) {
-  std::string trimmed = trim(line);
-  return !trimmed.empty() && trimmed[0] == '#';
+bool Parser::next_line(std::string_view text, size_t& pos, std::string_view& line) {
+  if (pos >= text.size()) {
+    return false;
+  }
+  size_t end = text.find('\n', pos);
+  if (end == std::string_view::npos) {
+    end = text.size();
+  }
+  line = text.substr(pos, end - pos);
+  pos = end + 1;
+  return true;
 }
 
-bool Parser::is_empty_line(const std::string& line) {
-  return trim(line).empty();
+bool Parser::next_token(std::string_view line, size_t& pos, std::string_view& token) {
+  while (pos < line.size() && is_token_space(line[pos])) {
+    pos++;
+  }
+  if (pos >= line.size()) {
+    return false;
+  }
+  size_t start = pos;
+  while (pos < line.size() && !is_token_space(line[pos])) {
+    pos++;
+  }
+  token = line.substr(start, pos - start);
+  return true;
 }
 
-char Parser::string_to_char(const std::string& str, const std::string& context) {
-  if (str.empty()) {
-    throw std::invalid_argument("Símbolo vacío en " + context);
+size_t Parser::split(std::string_view line, std::string_view* tokens, size_t capacity) {
+  size_t count = 0;
+  size_t pos = 0;
+  std::string_view token;
+  while (next_token(line, pos, token)) {
+    if (count < capacity) {
+      tokens[count] = token;
+    }
+    count++;
   }
-  
+  return count;
+}
+
+bool Parser::next_field(std::string_view list, size_t& pos, std::string_view& field) {
+  // Igual que std::getline(..., ','): una coma final no abre un campo vacío
+  if (pos >= list.size()) {
+    return false;
+  }
+  size_t end = list.find(',', pos);
+  if (end == std::string_view::npos) {
+    end = list.size();
+  }
+  field = list.substr(pos, end - pos);
+  pos = end + 1;
+  return true;
+}
+
+char Parser::string_to_char(std::string_view str, const char* what, int line_number) {
   if (str.length() == 1) {
     return str[0];
   }
@@ -53,164 +152,143 @@ char Parser::string_to_char(const std::string& str, const std::string& context)
     return ' ';
   }
   
-  if (str.length() > 1) {
-    throw std::invalid_argument("Símbolo inválido '" + str + "' en " + context + 
-                               " (debe ser un solo carácter)");
+  std::string context = std::string(what) + " (línea " + std::to_string(line_number) + ")";
+  if (str.empty()) {
+    throw std::invalid_argument("Símbolo vacío en " + context);
   }
-  
-  return str[0];
+  throw std::invalid_argument("Símbolo inválido '" + std::string(str) + "' en " + context + 
+                             " (debe ser un solo carácter)");
 }
 
-Transition Parser::parse_transition(const std::string& line, int line_number) {
-  std::vector<std::string> tokens = split(line);
+Transition Parser::parse_transition(std::string_view line, int line_number) {
+  std::string_view tokens[5];
   
-  if (tokens.size() != 5) {
-    throw std::invalid_argument("Línea " + std::to_string(line_number) + 
-                               ": Transición debe tener 5 elementos: estado_origen símbolo_leído estado_destino símbolo_escrito movimiento");
+  if (split(line, tokens, 5) != 5) {
+    throw std::invalid_argument(line_prefix(line_number) + 
+                               "Transición debe tener 5 elementos: estado_origen símbolo_leído estado_destino símbolo_escrito movimiento");
   }
   
-  std::string from_state = tokens[0];
-  char read_symbol = string_to_char(tokens[1], "símbolo leído (línea " + std::to_string(line_number) + ")");
-  std::string to_state = tokens[2];
-  char write_symbol = string_to_char(tokens[3], "símbolo escrito (línea " + std::to_string(line_number) + ")");
+  char read_symbol = string_to_char(tokens[1], "símbolo leído", line_number);
+  char write_symbol = string_to_char(tokens[3], "símbolo escrito", line_number);
   
   Movement movement;
   try {
-    movement = Transition::char_to_movement(string_to_char(tokens[4], "movimiento (línea " + std::to_string(line_number) + ")"));
+    movement = Transition::char_to_movement(string_to_char(tokens[4], "movimiento", line_number));
   } catch (const std::exception& e) {
-    throw std::invalid_argument("Línea " + std::to_string(line_number) + ": " + std::string(e.what()));
+    throw std::invalid_argument(line_prefix(line_number) + std::string(e.what()));
   }
   
-  return Transition(from_state, read_symbol, to_state, write_symbol, movement);
+  return Transition(std::string(tokens[0]), read_symbol, std::string(tokens[2]), write_symbol, movement);
 }
 
 bool Parser::load_from_file(const std::string& filename, TuringMachine& machine) {
-  std::ifstream file(filename);
-  if (!file.is_open()) {
+  MappedFile file;
+  if (!file.open(filename)) {
     last_error_ = "No se puede abrir el archivo: " + filename;
     return false;
   }
   
-  bool result = load_from_stream(file, machine);
-  file.close();
-  return result;
+  return load_from_buffer(file.view(), machine);
 }
 
 bool Parser::load_from_stream(std::istream& input, TuringMachine& machine) {
+  std::string text((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+  return load_from_buffer(text, machine);
+}
+
+bool Parser::load_from_buffer(std::string_view text, TuringMachine& machine) {
   try {
     machine.clear();
-    std::string line;
+    std::string_view line;
+    size_t pos = 0;
     int line_number = 0;
     int section = 0;  // 0=estados, 1=alfabeto_entrada, 2=alfabeto_cinta, 3=inicial, 4=blanco, 5=aceptación, 6=transiciones
     
-    while (std::getline(input, line)) {
+    while (next_line(text, pos, line)) {
       line_number++;
+      line = trim(line);
       
       // Saltar comentarios y líneas vacías
-      if (is_comment(line) || is_empty_line(line)) {
+      if (line.empty() || line[0] == '#') {
         continue;
       }
       
-      line = trim(line);
+      // Transiciones: la sección más larga, con su propio camino
+      if (section >= 6) {
+        machine.add_transition(parse_transition(line, line_number));
+        continue;
+      }
       
+      size_t token_pos = 0;
+      std::string_view token;
       switch (section) {
         case 0: {  // Estados
-          std::vector<std::string> states = split(line);
-          if (states.empty()) {
-            throw std::invalid_argument("Línea " + std::to_string(line_number) + ": Debe haber al menos un estado");
-          }
-          for (const std::string& state : states) {
-            machine.add_state(state);
+          if (!next_token(line, token_pos, token)) {
+            throw std::invalid_argument(line_prefix(line_number) + "Debe haber al menos un estado");
           }
-          section++;
+          do {
+            machine.add_state(std::string(token));
+          } while (next_token(line, token_pos, token));
           break;
         }
         
         case 1: {  // Alfabeto de entrada
-          std::vector<std::string> symbols = split(line);
-          for (const std::string& symbol_str : symbols) {
-            char symbol = string_to_char(symbol_str, "alfabeto de entrada (línea " + std::to_string(line_number) + ")");
-            machine.add_input_symbol(symbol);
+          while (next_token(line, token_pos, token)) {
+            machine.add_input_symbol(string_to_char(token, "alfabeto de entrada", line_number));
           }
-          section++;
           break;
         }
         
         case 2: {  // Alfabeto de cinta
-          std::vector<std::string> symbols = split(line);
-          for (const std::string& symbol_str : symbols) {
-            char symbol = string_to_char(symbol_str, "alfabeto de cinta (línea " + std::to_string(line_number) + ")");
-            machine.add_tape_symbol(symbol);
+          while (next_token(line, token_pos, token)) {
+            machine.add_tape_symbol(string_to_char(token, "alfabeto de cinta", line_number));
           }
-          section++;
           break;
         }
         
         case 3: {  // Estado inicial
-          std::vector<std::string> tokens = split(line);
-          if (tokens.size() != 1) {
-            throw std::invalid_argument("Línea " + std::to_string(line_number) + ": Debe haber exactamente un estado inicial");
+          if (split(line, &token, 1) != 1) {
+            throw std::invalid_argument(line_prefix(line_number) + "Debe haber exactamente un estado inicial");
           }
           // Validar que el estado inicial está en el conjunto de estados ANTES de asignarlo
+          std::string initial_state(token);
           const auto& states = machine.get_states();
-          if (states.find(tokens[0]) == states.end()) {
-            throw std::invalid_argument("Línea " + std::to_string(line_number) + 
-                                       ": El estado inicial '" + tokens[0] + 
+          if (states.find(initial_state) == states.end()) {
+            throw std::invalid_argument(line_prefix(line_number) + 
+                                       "El estado inicial '" + initial_state + 
                                        "' no está declarado en el conjunto de estados");
           }
-          machine.set_initial_state(tokens[0]);
-          section++;
+          machine.set_initial_state(initial_state);
           break;
         }
         
         case 4: {  // Símbolo blanco
-          std::vector<std::string> tokens = split(line);
-          if (tokens.size() != 1) {
-            throw std::invalid_argument("Línea " + std::to_string(line_number) + ": Debe haber exactamente un símbolo blanco");
+          if (split(line, &token, 1) != 1) {
+            throw std::invalid_argument(line_prefix(line_number) + "Debe haber exactamente un símbolo blanco");
           }
-          char blank_symbol = string_to_char(tokens[0], "símbolo blanco (línea " + std::to_string(line_number) + ")");
+          char blank_symbol = string_to_char(token, "símbolo blanco", line_number);
           // Validar que el símbolo blanco está en el alfabeto de cinta ANTES de asignarlo
-          const auto& tape_alphabet = machine.get_tape_alphabet();
-          if (tape_alphabet.find(blank_symbol) == tape_alphabet.end()) {
-            throw std::invalid_argument("Línea " + std::to_string(line_number) + 
-                                       ": El símbolo blanco '" + std::string(1, blank_symbol) + 
+          if (!machine.is_tape_symbol(blank_symbol)) {
+            throw std::invalid_argument(line_prefix(line_number) + 
+                                       "El símbolo blanco '" + std::string(1, blank_symbol) + 
                                        "' no pertenece al alfabeto de la cinta");
           }
           machine.set_blank_symbol(blank_symbol);
-          section++;
           break;
         }
         
         case 5: {  // Estados de aceptación
-          std::vector<std::string> accept_states = split(line);
-          for (const std::string& state : accept_states) {
-            machine.add_accept_state(state);
+          while (next_token(line, token_pos, token)) {
+            machine.add_accept_state(std::string(token));
           }
-          section++;
           break;
         }
-        
-        case 6: {  // Transiciones
-          try {
-            Transition transition = parse_transition(line, line_number);
-            machine.add_transition(transition);
-          } catch (const std::exception& e) {
-            throw std::invalid_argument(std::string(e.what()));
-          }
-          break;
-        }
-        
-        default:
-          // Continuamos parseando transiciones
-          if (section > 6) {
-            try {
-              Transition transition = parse_transition(line, line_number);
-              machine.add_transition(transition);
-            } catch (const std::exception& e) {
-              throw std::invalid_argument(std::string(e.what()));
-            }
-          }
-          break;
+      }
+      section++;
+      
+      // Las líneas restantes acotan el número de transiciones
+      if (section == 6) {
+        machine.reserve_transitions(std::count(text.begin() + std::min(pos, text.size()), text.end(), '\n') + 1);
       }
     }
     
@@ -234,71 +312,49 @@ bool Parser::load_from_stream(std::istream& input, TuringMachine& machine) {
 }
 
 bool Parser::save_to_file(const std::string& filename, const TuringMachine& machine) {
+  std::ofstream file(filename);
+  if (!file.is_open()) {
+    last_error_ = "No se puede crear el archivo: " + filename;
+    return false;
+  }
+  return save_to_stream(file, machine);
+}
+
+bool Parser::save_to_stream(std::ostream& output, const TuringMachine& machine) {
   try {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-      last_error_ = "No se puede crear el archivo: " + filename;
+    output << "# Definición de Máquina de Turing\n";
+    write_sections(output, machine);
+    if (!output.good()) {
+      last_error_ = "Error al escribir la máquina";
       return false;
     }
+    last_error_ = "";
+    return true;
     
-    file << "# Definición de Máquina de Turing\n";
-    file << "# Estados\n";
-    
-    // Estados
-    bool first = true;
-    for (const std::string& state : machine.get_states()) {
-      if (!first) file << " ";
-      file << state;
-      first = false;
-    }
-    file << "\n";
-    
-    // Alfabeto de entrada
-    file << "# Alfabeto de entrada\n";
-    first = true;
-    for (char symbol : machine.get_input_alphabet()) {
-      if (!first) file << " ";
-      file << symbol;
-      first = false;
-    }
-    file << "\n";
-    
-    // Alfabeto de cinta
-    file << "# Alfabeto de cinta\n";
-    first = true;
-    for (char symbol : machine.get_tape_alphabet()) {
-      if (!first) file << " ";
-      file << symbol;
-      first = false;
-    }
-    file << "\n";
-    
-    // Estado inicial
-    file << "# Estado inicial\n";
-    file << machine.get_initial_state() << "\n";
-    
-    // Símbolo blanco
-    file << "# Símbolo blanco\n";
-    file << machine.get_blank_symbol() << "\n";
-    
-    // Estados de aceptación
-    file << "# Estados de aceptación\n";
-    first = true;
-    for (const std::string& state : machine.get_accept_states()) {
-      if (!first) file << " ";
-      file << state;
-      first = false;
-    }
-    file << "\n";
-    
-    // Transiciones
-    file << "# Transiciones\n";
-    std::vector<Transition> transitions = machine.get_all_transitions();
-    for (const Transition& trans : transitions) {
-      file << trans.to_string() << "\n";
+  } catch (const std::exception& e) {
+    last_error_ = std::string(e.what());
+    return false;
+  }
+}
+
+bool Parser::save_multi_to_file(const std::string& filename, const MultiTuringMachine& machine) {
+  std::ofstream file(filename);
+  if (!file.is_open()) {
+    last_error_ = "No se puede crear el archivo: " + filename;
+    return false;
+  }
+  return save_multi_to_stream(file, machine);
+}
+
+bool Parser::save_multi_to_stream(std::ostream& output, const MultiTuringMachine& machine) {
+  try {
+    output << "# Definición de Máquina de Turing multicinta\n";
+    output << "MULTICINTA " << machine.get_num_tapes() << "\n";
+    write_sections(output, machine);
+    if (!output.good()) {
+      last_error_ = "Error al escribir la máquina";
+      return false;
     }
-    
-    file.close();
     last_error_ = "";
     return true;
     
@@ -318,134 +374,125 @@ std::string Parser::get_last_error() {
 }
 
 bool Parser::load_multi_from_file(const std::string& filename, MultiTuringMachine& machine) {
-  std::ifstream file(filename);
-  if (!file.is_open()) {
+  MappedFile file;
+  if (!file.open(filename)) {
     last_error_ = "No se puede abrir el archivo: " + filename;
     return false;
   }
   
+  return load_multi_from_buffer(file.view(), machine);
+}
+
+bool Parser::load_multi_from_buffer(std::string_view text, MultiTuringMachine& machine) {
   try {
     machine.clear();
-    std::string line;
+    std::string_view line;
+    size_t pos = 0;
     int line_number = 0;
     int section = -1;  // -1=buscar MULTICINTA, 0=estados, 1=alfabeto_entrada, etc.
     size_t num_tapes = 1;
     
-    while (std::getline(file, line)) {
+    while (next_line(text, pos, line)) {
       line_number++;
+      line = trim(line);
       
       // Saltar comentarios y líneas vacías
-      if (is_comment(line) || is_empty_line(line)) {
+      if (line.empty() || line[0] == '#') {
         continue;
       }
       
-      line = trim(line);
+      // Transiciones multicinta
+      if (section >= 6) {
+        machine.add_transition(parse_multi_transition(line, line_number, num_tapes));
+        continue;
+      }
       
-      // Buscar marcador MULTICINTA
-      if (section == -1) {
-        if (line.substr(0, 10) == "MULTICINTA") {
-          std::vector<std::string> tokens = split(line);
-          if (tokens.size() != 2) {
-            throw std::invalid_argument("Línea " + std::to_string(line_number) + 
-                                       ": Formato incorrecto para MULTICINTA. Esperado: MULTICINTA <num_cintas>");
+      size_t token_pos = 0;
+      std::string_view token;
+      switch (section) {
+        case -1: {  // Buscar marcador MULTICINTA
+          if (line.substr(0, 10) != "MULTICINTA") {
+            throw std::invalid_argument(line_prefix(line_number) + 
+                                       "Se esperaba marcador MULTICINTA al inicio del archivo");
           }
-          num_tapes = static_cast<size_t>(std::stoi(tokens[1]));
+          std::string_view tokens[2];
+          if (split(line, tokens, 2) != 2) {
+            throw std::invalid_argument(line_prefix(line_number) + 
+                                       "Formato incorrecto para MULTICINTA. Esperado: MULTICINTA <num_cintas>");
+          }
+          num_tapes = static_cast<size_t>(std::stoi(std::string(tokens[1])));
           machine.set_num_tapes(num_tapes);
-          section = 0;
-          continue;
-        } else {
-          throw std::invalid_argument("Línea " + std::to_string(line_number) + 
-                                     ": Se esperaba marcador MULTICINTA al inicio del archivo");
+          break;
         }
-      }
-      
-      switch (section) {
+        
         case 0: {  // Estados
-          std::vector<std::string> states = split(line);
-          if (states.empty()) {
-            throw std::invalid_argument("Línea " + std::to_string(line_number) + ": Debe haber al menos un estado");
-          }
-          for (const std::string& state : states) {
-            machine.add_state(state);
+          if (!next_token(line, token_pos, token)) {
+            throw std::invalid_argument(line_prefix(line_number) + "Debe haber al menos un estado");
           }
-          section++;
+          do {
+            machine.add_state(std::string(token));
+          } while (next_token(line, token_pos, token));
           break;
         }
         
         case 1: {  // Alfabeto de entrada
-          std::vector<std::string> symbols = split(line);
-          for (const std::string& symbol_str : symbols) {
-            char symbol = string_to_char(symbol_str, "alfabeto de entrada (línea " + std::to_string(line_number) + ")");
-            machine.add_input_symbol(symbol);
+          while (next_token(line, token_pos, token)) {
+            machine.add_input_symbol(string_to_char(token, "alfabeto de entrada", line_number));
           }
-          section++;
           break;
         }
         
         case 2: {  // Alfabeto de cinta
-          std::vector<std::string> symbols = split(line);
-          for (const std::string& symbol_str : symbols) {
-            char symbol = string_to_char(symbol_str, "alfabeto de cinta (línea " + std::to_string(line_number) + ")");
-            machine.add_tape_symbol(symbol);
+          while (next_token(line, token_pos, token)) {
+            machine.add_tape_symbol(string_to_char(token, "alfabeto de cinta", line_number));
           }
-          section++;
           break;
         }
         
         case 3: {  // Estado inicial
-          std::vector<std::string> tokens = split(line);
-          if (tokens.size() != 1) {
-            throw std::invalid_argument("Línea " + std::to_string(line_number) + ": Debe haber exactamente un estado inicial");
+          if (split(line, &token, 1) != 1) {
+            throw std::invalid_argument(line_prefix(line_number) + "Debe haber exactamente un estado inicial");
           }
           // Validar que el estado inicial está en el conjunto de estados ANTES de asignarlo
+          std::string initial_state(token);
           const auto& states = machine.get_states();
-          if (states.find(tokens[0]) == states.end()) {
-            throw std::invalid_argument("Línea " + std::to_string(line_number) + 
-                                       ": El estado inicial '" + tokens[0] + 
+          if (states.find(initial_state) == states.end()) {
+            throw std::invalid_argument(line_prefix(line_number) + 
+                                       "El estado inicial '" + initial_state + 
                                        "' no está declarado en el conjunto de estados");
           }
-          machine.set_initial_state(tokens[0]);
-          section++;
+          machine.set_initial_state(initial_state);
           break;
         }
         
         case 4: {  // Símbolo blanco
-          std::vector<std::string> tokens = split(line);
-          if (tokens.size() != 1) {
-            throw std::invalid_argument("Línea " + std::to_string(line_number) + ": Debe haber exactamente un símbolo blanco");
+          if (split(line, &token, 1) != 1) {
+            throw std::invalid_argument(line_prefix(line_number) + "Debe haber exactamente un símbolo blanco");
           }
-          char blank_symbol = string_to_char(tokens[0], "símbolo blanco (línea " + std::to_string(line_number) + ")");
+          char blank_symbol = string_to_char(token, "símbolo blanco", line_number);
           // Validar que el símbolo blanco está en el alfabeto de cinta ANTES de asignarlo
-          const auto& tape_alphabet = machine.get_tape_alphabet();
-          if (tape_alphabet.find(blank_symbol) == tape_alphabet.end()) {
-            throw std::invalid_argument("Línea " + std::to_string(line_number) + 
-                                       ": El símbolo blanco '" + std::string(1, blank_symbol) + 
+          if (!machine.is_tape_symbol(blank_symbol)) {
+            throw std::invalid_argument(line_prefix(line_number) + 
+                                       "El símbolo blanco '" + std::string(1, blank_symbol) + 
                                        "' no pertenece al alfabeto de la cinta");
           }
           machine.set_blank_symbol(blank_symbol);
-          section++;
           break;
         }
         
         case 5: {  // Estados de aceptación
-          std::vector<std::string> accept_states = split(line);
-          for (const std::string& state : accept_states) {
-            machine.add_accept_state(state);
-          }
-          section++;
-          break;
-        }
-        
-        default: {  // Transiciones multicinta
-          try {
-            MultiTransition transition = parse_multi_transition(line, line_number, num_tapes);
-            machine.add_transition(transition);
-          } catch (const std::exception& e) {
-            throw std::invalid_argument(std::string(e.what()));
+          while (next_token(line, token_pos, token)) {
+            machine.add_accept_state(std::string(token));
           }
           break;
         }
       }
+      section++;
+      
+      // Las líneas restantes acotan el número de transiciones
+      if (section == 6) {
+        machine.reserve_transitions(std::count(text.begin() + std::min(pos, text.size()), text.end(), '\n') + 1);
+      }
     }
     
     // Verificar que hemos parseado al menos las secciones básicas
@@ -459,120 +506,108 @@ bool Parser::load_multi_from_file(const std::string& filename, MultiTuringMachin
     }
     
     last_error_ = "";
-    file.close();
     return true;
     
   } catch (const std::exception& e) {
     last_error_ = std::string(e.what());
-    file.close();
     return false;
   }
 }
 
-MultiTransition Parser::parse_multi_transition(const std::string& line, int line_number, size_t num_tapes) {
-  std::vector<std::string> tokens = split(line);
+MultiTransition Parser::parse_multi_transition(std::string_view line, int line_number, size_t num_tapes) {
+  std::string_view tokens[5];
   
-  if (tokens.size() != 5) {
-    throw std::invalid_argument("Línea " + std::to_string(line_number) + 
-                               ": Transición multicinta debe tener 5 elementos: estado_origen símbolos_leídos estado_destino símbolos_escritos movimientos");
+  if (split(line, tokens, 5) != 5) {
+    throw std::invalid_argument(line_prefix(line_number) + 
+                               "Transición multicinta debe tener 5 elementos: estado_origen símbolos_leídos estado_destino símbolos_escritos movimientos");
   }
   
-  std::string from_state = tokens[0];
-  std::string to_state = tokens[2];
-  
-  // Parsear símbolos leídos (formato: símb1,símb2,...)
-  std::vector<std::string> read_tokens;
-  std::istringstream read_stream(tokens[1]);
-  std::string read_token;
-  while (std::getline(read_stream, read_token, ',')) {
-    read_tokens.push_back(read_token);
-  }
-  
-  if (read_tokens.size() != num_tapes) {
-    throw std::invalid_argument("Línea " + std::to_string(line_number) + 
-                               ": Número de símbolos leídos (" + std::to_string(read_tokens.size()) + 
-                               ") no coincide con número de cintas (" + std::to_string(num_tapes) + ")");
-  }
+  // Cada lista (formato: a,b,...) se cuenta antes de convertir sus campos,
+  // para que un número de cintas incorrecto se informe primero
+  auto count_fields = [](std::string_view list) {
+    size_t count = 0;
+    size_t pos = 0;
+    std::string_view field;
+    while (next_field(list, pos, field)) {
+      count++;
+    }
+    return count;
+  };
+  auto check_count = [&](std::string_view list, const char* what) {
+    size_t count = count_fields(list);
+    if (count != num_tapes) {
+      throw std::invalid_argument(line_prefix(line_number) + "Número de " + what + " (" +
+                                 std::to_string(count) + ") no coincide con número de cintas (" +
+                                 std::to_string(num_tapes) + ")");
+    }
+  };
+  auto parse_symbols = [&](std::string_view list, const char* what, std::vector<char>& symbols) {
+    symbols.reserve(num_tapes);
+    size_t pos = 0;
+    std::string_view field;
+    while (next_field(list, pos, field)) {
+      symbols.push_back(string_to_char(field, what, line_number));
+    }
+  };
   
+  // Parsear símbolos leídos
   std::vector<char> read_symbols;
-  for (const std::string& token : read_tokens) {
-    read_symbols.push_back(string_to_char(token, "símbolo leído (línea " + std::to_string(line_number) + ")"));
-  }
-  
-  // Parsear símbolos escritos (formato: símb1,símb2,...)
-  std::vector<std::string> write_tokens;
-  std::istringstream write_stream(tokens[3]);
-  std::string write_token;
-  while (std::getline(write_stream, write_token, ',')) {
-    write_tokens.push_back(write_token);
-  }
-  
-  if (write_tokens.size() != num_tapes) {
-    throw std::invalid_argument("Línea " + std::to_string(line_number) + 
-                               ": Número de símbolos escritos (" + std::to_string(write_tokens.size()) + 
-                               ") no coincide con número de cintas (" + std::to_string(num_tapes) + ")");
-  }
+  check_count(tokens[1], "símbolos leídos");
+  parse_symbols(tokens[1], "símbolo leído", read_symbols);
   
+  // Parsear símbolos escritos
   std::vector<char> write_symbols;
-  for (const std::string& token : write_tokens) {
-    write_symbols.push_back(string_to_char(token, "símbolo escrito (línea " + std::to_string(line_number) + ")"));
-  }
-  
-  // Parsear movimientos (formato: mov1,mov2,...)
-  std::vector<std::string> move_tokens;
-  std::istringstream move_stream(tokens[4]);
-  std::string move_token;
-  while (std::getline(move_stream, move_token, ',')) {
-    move_tokens.push_back(move_token);
-  }
-  
-  if (move_tokens.size() != num_tapes) {
-    throw std::invalid_argument("Línea " + std::to_string(line_number) + 
-                               ": Número de movimientos (" + std::to_string(move_tokens.size()) + 
-                               ") no coincide con número de cintas (" + std::to_string(num_tapes) + ")");
-  }
+  check_count(tokens[3], "símbolos escritos");
+  parse_symbols(tokens[3], "símbolo escrito", write_symbols);
   
+  // Parsear movimientos
+  check_count(tokens[4], "movimientos");
   std::vector<Movement> movements;
-  for (const std::string& token : move_tokens) {
-    char move_char = string_to_char(token, "movimiento (línea " + std::to_string(line_number) + ")");
+  movements.reserve(num_tapes);
+  size_t pos = 0;
+  std::string_view field;
+  while (next_field(tokens[4], pos, field)) {
+    char move_char = string_to_char(field, "movimiento", line_number);
     try {
       movements.push_back(Transition::char_to_movement(move_char));
     } catch (const std::exception& e) {
-      throw std::invalid_argument("Línea " + std::to_string(line_number) + ": " + std::string(e.what()));
+      throw std::invalid_argument(line_prefix(line_number) + std::string(e.what()));
     }
   }
   
-  return MultiTransition(from_state, read_symbols, to_state, write_symbols, movements);
+  return MultiTransition(std::string(tokens[0]), std::move(read_symbols), std::string(tokens[2]),
+                         std::move(write_symbols), std::move(movements));
+}
+
+bool Parser::is_multi_tape_text(std::string_view text) {
+  // Solo se examina la primera línea significativa (tras comentarios y vacías)
+  std::string_view line;
+  size_t pos = 0;
+  while (next_line(text, pos, line)) {
+    line = trim(line);
+    if (!line.empty() && line[0] != '#') {
+      return line.substr(0, 10) == "MULTICINTA";
+    }
+  }
+  return false;
 }
 
 bool Parser::load_auto_detect(const std::string& filename,
                              TuringMachine& mono_machine,
                              MultiTuringMachine& multi_machine,
                              bool& is_multicinta) {
-  std::ifstream file(filename);
-  if (!file.is_open()) {
+  MappedFile file;
+  if (!file.open(filename)) {
     last_error_ = "No se puede abrir el archivo: " + filename;
     return false;
   }
   
-  // Leer la primera línea no comentario para detectar el tipo
-  std::string line;
-  while (std::getline(file, line)) {
-    if (!is_comment(line) && !is_empty_line(line)) {
-      line = trim(line);
-      if (line.substr(0, 10) == "MULTICINTA") {
-        is_multicinta = true;
-        file.close();
-        return load_multi_from_file(filename, multi_machine);
-      } else {
-        is_multicinta = false;
-        file.close();
-        return load_from_file(filename, mono_machine);
-      }
-    }
+  // El tipo se decide por la cabecera y el mismo buffer se parsea una sola vez;
+  // un fichero sin líneas significativas lo rechaza el parser monocinta
+  std::string_view text = file.view();
+  is_multicinta = is_multi_tape_text(text);
+  if (is_multicinta) {
+    return load_multi_from_buffer(text, multi_machine);
   }
-  
-  file.close();
-  last_error_ = "No se pudo determinar el tipo de máquina";
-  return false;
-}
\ No newline at end of file
+  return load_from_buffer(text, mono_machine);
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <fstream>
+#include <string_view>
 #include <vector>
 #include "TuringMachine.hpp"
 #include "MultiTuringMachine.hpp"
@@ -17,36 +18,55 @@
  * símbolo_blanco
  * estados_aceptación_separados_por_espacios
  * transiciones (una por línea): estado_origen símbolo_leído estado_destino símbolo_escrito movimiento
+ *
+ * Los archivos se proyectan en memoria y se recorren en una sola pasada: líneas
+ * y tokens son vistas sobre el texto, sin copias intermedias, y los mensajes de
+ * error solo se construyen cuando hay un error.
  */
 class Parser {
 private:
   /**
    * @brief Elimina espacios en blanco al inicio y final de una cadena
    * @param str Cadena a procesar
-   * @return Cadena sin espacios al inicio y final
+   * @return Vista sin espacios al inicio y final (sin copiar)
    */
-  static std::string trim(const std::string& str);
+  static std::string_view trim(std::string_view str);
 
   /**
-   * @brief Divide una cadena en tokens usando espacios como separadores
-   * @param str Cadena a dividir
-   * @return Vector de tokens
+   * @brief Extrae la siguiente línea de un texto (sin el salto de línea)
+   * @param text Texto completo
+   * @param pos Posición actual; se avanza tras la línea
+   * @param line Salida: vista de la línea
+   * @return false si no quedan líneas
    */
-  static std::vector<std::string> split(const std::string& str);
+  static bool next_line(std::string_view text, size_t& pos, std::string_view& line);
 
   /**
-   * @brief Verifica si una línea es un comentario (empieza con #)
-   * @param line Línea a verificar
-   * @return true si es comentario
+   * @brief Extrae el siguiente token separado por espacios de una línea
+   * @param line Línea a recorrer
+   * @param pos Posición actual; se avanza tras el token
+   * @param token Salida: vista del token
+   * @return false si no quedan tokens
    */
-  static bool is_comment(const std::string& line);
+  static bool next_token(std::string_view line, size_t& pos, std::string_view& token);
 
   /**
-   * @brief Verifica si una línea está vacía (solo espacios)
-   * @param line Línea a verificar
-   * @return true si está vacía
+   * @brief Divide una línea en tokens separados por espacios, sin reservar memoria
+   * @param line Línea a dividir
+   * @param tokens Salida: vistas de los primeros tokens
+   * @param capacity Número máximo de tokens que se guardan
+   * @return Número total de tokens de la línea (puede superar capacity)
    */
-  static bool is_empty_line(const std::string& line);
+  static size_t split(std::string_view line, std::string_view* tokens, size_t capacity);
+
+  /**
+   * @brief Divide una lista separada por comas en campos (como getline con ',')
+   * @param list Lista a dividir
+   * @param pos Posición actual; se avanza tras el campo
+   * @param field Salida: vista del campo
+   * @return false si no quedan campos
+   */
+  static bool next_field(std::string_view list, size_t& pos, std::string_view& field);
 
   /**
    * @brief Parsea una línea de transición monocinta
@@ -54,7 +74,7 @@ private:
    * @param line_number Número de línea (para errores)
    * @return Transición parseada
    */
-  static Transition parse_transition(const std::string& line, int line_number);
+  static Transition parse_transition(std::string_view line, int line_number);
 
   /**
    * @brief Parsea una línea de transición multicinta
@@ -63,15 +83,25 @@ private:
    * @param num_tapes Número de cintas esperado
    * @return Transición multicinta parseada
    */
-  static MultiTransition parse_multi_transition(const std::string& line, int line_number, size_t num_tapes);
+  static MultiTransition parse_multi_transition(std::string_view line, int line_number, size_t num_tapes);
 
   /**
-   * @brief Convierte un string de un carácter a char, manejando casos especiales
-   * @param str String a convertir
-   * @param context Contexto para mensajes de error
+   * @brief Convierte un token de un carácter a char, manejando casos especiales
+   * @param str Token a convertir
+   * @param what Elemento que se está leyendo (para errores)
+   * @param line_number Número de línea (para errores)
    * @return Carácter convertido
+   *
+   * El contexto "<what> (línea N)" solo se construye si hay que lanzar un error.
    */
-  static char string_to_char(const std::string& str, const std::string& context);
+  static char string_to_char(std::string_view str, const char* what, int line_number);
+
+  /**
+   * @brief Detecta si un texto es una máquina multicinta
+   * @param text Contenido del archivo
+   * @return true si la primera línea significativa es el marcador MULTICINTA
+   */
+  static bool is_multi_tape_text(std::string_view text);
 
 public:
   /**
@@ -92,6 +122,11 @@ public:
 
   /**
    * @brief Detecta automáticamente el tipo de máquina y carga la apropiada
+   *
+   * El archivo se proyecta una sola vez: el tipo se decide por el marcador
+   * MULTICINTA de la primera línea significativa y el mismo buffer se parsea
+   * con el cargador que corresponde (sin reintentos ni segundas lecturas).
+   *
    * @param filename Ruta del archivo a cargar
    * @param mono_machine Máquina monocinta (se usa si es el tipo correcto)
    * @param multi_machine Máquina multicinta (se usa si es el tipo correcto)
@@ -111,6 +146,22 @@ public:
    */
   static bool load_from_stream(std::istream& input, TuringMachine& machine);
 
+  /**
+   * @brief Carga una máquina de Turing desde un texto en memoria
+   * @param text Contenido completo del archivo
+   * @param machine Máquina de Turing donde cargar la definición
+   * @return true si la carga fue exitosa
+   */
+  static bool load_from_buffer(std::string_view text, TuringMachine& machine);
+
+  /**
+   * @brief Carga una máquina de Turing multicinta desde un texto en memoria
+   * @param text Contenido completo del archivo
+   * @param machine Máquina de Turing multicinta donde cargar la definición
+   * @return true si la carga fue exitosa
+   */
+  static bool load_multi_from_buffer(std::string_view text, MultiTuringMachine& machine);
+
   /**
    * @brief Guarda una máquina de Turing en un archivo
    * @param filename Ruta del archivo donde guardar
@@ -119,6 +170,30 @@ public:
    */
   static bool save_to_file(const std::string& filename, const TuringMachine& machine);
 
+  /**
+   * @brief Escribe una máquina de Turing en un flujo, en el formato de fichero
+   * @param output Flujo de salida
+   * @param machine Máquina de Turing a guardar
+   * @return true si la escritura fue exitosa
+   */
+  static bool save_to_stream(std::ostream& output, const TuringMachine& machine);
+
+  /**
+   * @brief Guarda una máquina de Turing multicinta en un archivo
+   * @param filename Ruta del archivo donde guardar
+   * @param machine Máquina multicinta a guardar
+   * @return true si el guardado fue exitoso
+   */
+  static bool save_multi_to_file(const std::string& filename, const MultiTuringMachine& machine);
+
+  /**
+   * @brief Escribe una máquina multicinta en un flujo (con el marcador MULTICINTA)
+   * @param output Flujo de salida
+   * @param machine Máquina multicinta a guardar
+   * @return true si la escritura fue exitosa
+   */
+  static bool save_multi_to_stream(std::ostream& output, const MultiTuringMachine& machine);
+
   /**
    * @brief Valida el formato de un archivo antes de parsearlo
    * @param filename Ruta del archivo a validar
@@ -0,0 +1,223 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+
+char movement_char(Movement movement) {
+  switch (movement) {
+    case Movement::LEFT:
+      return 'L';
+    case Movement::RIGHT:
+      return 'R';
+    default:
+      return 'S';
+  }
+}
+
+/**
+ * @brief Índices de los contadores no nulos, de mayor a menor, como mucho top
+ */
+std::vector<uint32_t> top_indices(const std::vector<uint64_t>& counters, size_t top) {
+  std::vector<uint32_t> indices;
+  for (uint32_t i = 0; i < counters.size(); ++i) {
+    if (counters[i] > 0) {
+      indices.push_back(i);
+    }
+  }
+  auto by_hits = [&counters](uint32_t a, uint32_t b) {
+    return counters[a] != counters[b] ? counters[a] > counters[b] : a < b;
+  };
+  size_t count = std::min(top, indices.size());
+  std::partial_sort(indices.begin(), indices.begin() + count, indices.end(), by_hits);
+  indices.resize(count);
+  return indices;
+}
+
+}  // namespace
+
+Profiler::Profiler(const CompiledMachine* machine, bool collect_stacks)
+    : machine_(machine),
+      transition_hits_(machine->get_transition_count(), 0),
+      state_hits_(machine->get_num_states(), 0),
+      tapes_(machine->get_num_tapes()),
+      steps_(0), runs_(0),
+      collect_stacks_(collect_stacks) {
+  if (collect_stacks_) {
+    path_index_.assign(machine->get_num_states(), -1);
+  }
+}
+
+void Profiler::begin_run(uint32_t initial_state) {
+  runs_++;
+  if (!collect_stacks_) {
+    return;
+  }
+  for (uint32_t node : path_) {
+    path_index_[nodes_[node].state] = -1;
+  }
+  path_.clear();
+  path_.push_back(child_node(NO_NODE, initial_state));
+  path_index_[initial_state] = 0;
+}
+
+uint32_t Profiler::child_node(uint32_t parent, uint32_t state) {
+  uint64_t key = (static_cast<uint64_t>(parent) << 32) | state;
+  auto it = children_.find(key);
+  if (it != children_.end()) {
+    return it->second;
+  }
+  uint32_t node = static_cast<uint32_t>(nodes_.size());
+  nodes_.push_back(StackNode{parent, state, 0});
+  children_.emplace(key, node);
+  return node;
+}
+
+void Profiler::enter_state(uint32_t state) {
+  int32_t index = path_index_[state];
+  if (index >= 0) {
+    // Bucle: se vuelve al marco del estado (un bucle sobre sí mismo no cambia nada)
+    while (path_.size() > static_cast<size_t>(index) + 1) {
+      path_index_[nodes_[path_.back()].state] = -1;
+      path_.pop_back();
+    }
+    return;
+  }
+  if (path_.size() >= MAX_STACK_DEPTH) {
+    // Pila llena: el nuevo estado sustituye al marco superior
+    path_index_[nodes_[path_.back()].state] = -1;
+    path_.pop_back();
+  }
+  uint32_t parent = path_.empty() ? NO_NODE : path_.back();
+  path_index_[state] = static_cast<int32_t>(path_.size());
+  path_.push_back(child_node(parent, state));
+}
+
+void Profiler::grow(TapeCounters& counters, int position) {
+  if (counters.visits.empty()) {
+    counters.visits.assign(64, 0);
+    counters.origin = position - 32;
+    return;
+  }
+  // Se duplica el tamaño hacia el lado que se ha quedado corto
+  size_t size = counters.visits.size();
+  int64_t first = counters.origin;
+  int64_t last = first + static_cast<int64_t>(size);
+  int64_t new_first = first;
+  int64_t new_last = last;
+  if (position < first) {
+    new_first = std::min<int64_t>(position, first - static_cast<int64_t>(size));
+  } else {
+    new_last = std::max<int64_t>(static_cast<int64_t>(position) + 1, last + static_cast<int64_t>(size));
+  }
+  std::vector<uint64_t> visits(static_cast<size_t>(new_last - new_first), 0);
+  std::copy(counters.visits.begin(), counters.visits.end(), visits.begin() + (first - new_first));
+  counters.visits.swap(visits);
+  counters.origin = static_cast<int>(new_first);
+}
+
+std::string Profiler::describe_transition(uint32_t transition) const {
+  size_t num_tapes = machine_->get_num_tapes();
+  const char* reads = machine_->get_read_symbols(transition);
+  const char* writes = machine_->get_write_symbols(transition);
+  std::string text(machine_->get_state_name(machine_->get_from_state(transition)));
+  std::string read_list, write_list, move_list;
+  for (size_t i = 0; i < num_tapes; ++i) {
+    if (i > 0) {
+      read_list += ',';
+      write_list += ',';
+      move_list += ',';
+    }
+    read_list += reads[i];
+    write_list += writes[i];
+    move_list += movement_char(machine_->get_movement(transition, i));
+  }
+  text += " " + read_list + " -> ";
+  text += machine_->get_state_name(machine_->get_to_state(transition));
+  text += " " + write_list + " " + move_list;
+  return text;
+}
+
+void Profiler::print_report(std::ostream& out, size_t top) const {
+  auto percent = [this](uint64_t hits) {
+    return steps_ > 0 ? 100.0 * static_cast<double>(hits) / static_cast<double>(steps_) : 0.0;
+  };
+  size_t used_transitions = static_cast<size_t>(
+      std::count_if(transition_hits_.begin(), transition_hits_.end(), [](uint64_t h) { return h > 0; }));
+
+  out << "=== Perfil de ejecución ===\n";
+  out << "Palabras simuladas: " << runs_ << ", pasos: " << steps_ << "\n";
+  out << "Transiciones usadas: " << used_transitions << " de " << transition_hits_.size() << "\n";
+
+  out << "\nTransiciones más usadas:\n";
+  out << std::setw(14) << "pasos" << std::setw(9) << "%" << "   transición\n";
+  for (uint32_t t : top_indices(transition_hits_, top)) {
+    out << std::setw(14) << transition_hits_[t] << std::setw(8) << std::fixed << std::setprecision(2)
+        << percent(transition_hits_[t]) << "%   " << describe_transition(t) << "\n";
+  }
+
+  out << "\nEstados más visitados:\n";
+  out << std::setw(14) << "pasos" << std::setw(9) << "%" << "   estado\n";
+  for (uint32_t s : top_indices(state_hits_, top)) {
+    out << std::setw(14) << state_hits_[s] << std::setw(8) << std::fixed << std::setprecision(2)
+        << percent(state_hits_[s]) << "%   " << machine_->get_state_name(s) << "\n";
+  }
+
+  for (size_t i = 0; i < tapes_.size(); ++i) {
+    const TapeCounters& counters = tapes_[i];
+    out << "\nCinta " << (i + 1) << ":";
+    if (!counters.touched) {
+      out << " sin pasos\n";
+      continue;
+    }
+    size_t distinct = static_cast<size_t>(
+        std::count_if(counters.visits.begin(), counters.visits.end(), [](uint64_t v) { return v > 0; }));
+    out << " " << distinct << " celdas visitadas (posiciones " << counters.min_position << ".."
+        << counters.max_position << "), recorrido del cabezal: " << counters.travel << " celdas ("
+        << std::fixed << std::setprecision(2)
+        << (steps_ > 0 ? static_cast<double>(counters.travel) / static_cast<double>(steps_) : 0.0)
+        << " por paso)\n";
+    out << "  Celdas más visitadas:";
+    for (uint32_t c : top_indices(counters.visits, std::min<size_t>(top, 5))) {
+      out << " " << (counters.origin + static_cast<int64_t>(c)) << " (" << counters.visits[c] << ")";
+    }
+    out << "\n";
+  }
+  out << std::defaultfloat;
+}
+
+bool Profiler::write_collapsed(const std::string& path) {
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    last_error_ = "No se puede crear el archivo: " + path;
+    return false;
+  }
+
+  std::vector<uint32_t> frames;
+  std::string line;
+  for (uint32_t node = 0; node < nodes_.size(); ++node) {
+    if (nodes_[node].hits == 0) {
+      continue;
+    }
+    frames.clear();
+    for (uint32_t n = node; n != NO_NODE; n = nodes_[n].parent) {
+      frames.push_back(nodes_[n].state);
+    }
+    line.clear();
+    for (size_t i = frames.size(); i-- > 0;) {
+      // ';' y ' ' separan marcos y contador en el formato colapsado
+      std::string name(machine_->get_state_name(frames[i]));
+      std::replace(name.begin(), name.end(), ';', '_');
+      line += name;
+      line += i > 0 ? ';' : ' ';
+    }
+    file << line << nodes_[node].hits << "\n";
+  }
+
+  if (!file.good()) {
+    last_error_ = "Error al escribir el archivo: " + path;
+    return false;
+  }
+  return true;
+}
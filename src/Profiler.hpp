@@ -0,0 +1,161 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "CompiledMachine.hpp"
+
+/**
+ * @brief Perfil de ejecución de una máquina compilada (mt-sim --profile)
+ *
+ * Acumula, sobre todas las palabras simuladas:
+ * - Pasos por transición y por estado, en vectores indexados por los
+ *   identificadores de la forma compilada (sin mapas de cadenas).
+ * - Visitas a cada celda de cada cinta y recorrido total del cabezal.
+ * - Opcionalmente, pilas colapsadas para herramientas de flame graph: la pila
+ *   de un paso es el camino de estados desde el inicial con los bucles
+ *   colapsados (un estado repetido no se apila dos veces: volver a un estado
+ *   del camino lo recorta hasta él). Los pasos se cuentan en la pila del
+ *   estado desde el que se dan.
+ *
+ * El simulador llama a begin_run() al empezar cada palabra y a record_step() y
+ * record_cell() en cada paso; ambas son en línea y solo incrementan contadores.
+ */
+class Profiler {
+public:
+  static constexpr size_t MAX_STACK_DEPTH = 64;  // Profundidad máxima de las pilas colapsadas
+
+private:
+  /**
+   * @brief Contadores de una cinta
+   */
+  struct TapeCounters {
+    std::vector<uint64_t> visits;  // Visitas por celda, desde la posición origin
+    int origin = 0;                // Posición de visits[0]
+    uint64_t travel = 0;           // Celdas recorridas por el cabezal
+    int min_position = 0;          // Posición mínima visitada
+    int max_position = 0;          // Posición máxima visitada
+    bool touched = false;          // Si se visitó alguna celda
+  };
+
+  /**
+   * @brief Nodo del árbol de pilas colapsadas
+   */
+  struct StackNode {
+    uint32_t parent;  // Nodo padre (NO_NODE en las raíces)
+    uint32_t state;   // Estado de este marco
+    uint64_t hits;    // Pasos dados con esta pila exacta
+  };
+
+  static constexpr uint32_t NO_NODE = 0xFFFFFFFFu;
+
+  const CompiledMachine* machine_;           // Máquina perfilada
+  std::vector<uint64_t> transition_hits_;    // Pasos por transición
+  std::vector<uint64_t> state_hits_;         // Pasos dados desde cada estado
+  std::vector<TapeCounters> tapes_;          // Contadores por cinta
+  uint64_t steps_;                           // Pasos totales
+  uint64_t runs_;                            // Palabras simuladas
+
+  bool collect_stacks_;                      // Si se construyen las pilas colapsadas
+  std::vector<StackNode> nodes_;             // Árbol de pilas
+  std::unordered_map<uint64_t, uint32_t> children_;  // (padre, estado) -> nodo
+  std::vector<uint32_t> path_;               // Nodos del camino actual (raíz primero)
+  std::vector<int32_t> path_index_;          // Posición de cada estado en path_ (-1 si no está)
+  std::string last_error_;                   // Último error ocurrido
+
+  /**
+   * @brief Amplía el vector de visitas de una cinta para incluir una posición
+   */
+  static void grow(TapeCounters& counters, int position);
+
+  /**
+   * @brief Obtiene (o crea) el nodo hijo de parent para un estado
+   */
+  uint32_t child_node(uint32_t parent, uint32_t state);
+
+  /**
+   * @brief Actualiza el camino de la pila al entrar en un estado
+   */
+  void enter_state(uint32_t state);
+
+  /**
+   * @brief Texto de una transición: "q0 a -> q1 b R" (listas con comas si es multicinta)
+   */
+  std::string describe_transition(uint32_t transition) const;
+
+public:
+  /**
+   * @brief Constructor del perfil
+   * @param machine Máquina compilada (debe sobrevivir al perfil)
+   * @param collect_stacks Si construir las pilas colapsadas (write_collapsed)
+   */
+  Profiler(const CompiledMachine* machine, bool collect_stacks);
+
+  /**
+   * @brief Empieza la simulación de una palabra
+   * @param initial_state Estado inicial
+   */
+  void begin_run(uint32_t initial_state);
+
+  /**
+   * @brief Registra un paso dado desde un estado con una transición
+   * @param state Estado antes del paso
+   * @param transition Transición aplicada
+   */
+  void record_step(uint32_t state, uint32_t transition) {
+    transition_hits_[transition]++;
+    state_hits_[state]++;
+    steps_++;
+    if (collect_stacks_) {
+      nodes_[path_.back()].hits++;
+      enter_state(machine_->get_to_state(transition));
+    }
+  }
+
+  /**
+   * @brief Registra la celda bajo un cabezal en un paso y su movimiento
+   * @param tape Índice de la cinta
+   * @param position Posición del cabezal antes de moverse
+   * @param movement Movimiento que se va a aplicar
+   */
+  void record_cell(size_t tape, int position, Movement movement) {
+    TapeCounters& counters = tapes_[tape];
+    int64_t index = static_cast<int64_t>(position) - counters.origin;
+    if (index < 0 || index >= static_cast<int64_t>(counters.visits.size())) {
+      grow(counters, position);
+      index = static_cast<int64_t>(position) - counters.origin;
+    }
+    counters.visits[static_cast<size_t>(index)]++;
+    if (!counters.touched || position < counters.min_position) {
+      counters.min_position = position;
+    }
+    if (!counters.touched || position > counters.max_position) {
+      counters.max_position = position;
+    }
+    counters.touched = true;
+    if (movement != Movement::STAY) {
+      counters.travel++;
+    }
+  }
+
+  /**
+   * @brief Imprime el informe: transiciones y estados más usados y cintas
+   * @param out Flujo de salida
+   * @param top Número de entradas de cada clasificación
+   */
+  void print_report(std::ostream& out, size_t top) const;
+
+  /**
+   * @brief Escribe las pilas colapsadas ("q0;q1;q2 pasos" por línea)
+   * @param path Fichero de salida
+   * @return true si se pudo escribir
+   */
+  bool write_collapsed(const std::string& path);
+
+  uint64_t get_steps() const { return steps_; }
+  uint64_t get_runs() const { return runs_; }
+  uint64_t get_transition_hits(uint32_t transition) const { return transition_hits_[transition]; }
+  uint64_t get_state_hits(uint32_t state) const { return state_hits_[state]; }
+  const std::string& get_last_error() const { return last_error_; }
+};
@@ -0,0 +1,262 @@
+#include "Protocol.hpp"
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+Protocol::Encoder::Encoder() : frame_start_(0) {
+}
+
+void Protocol::Encoder::begin() {
+  frame_start_ = data_.size();
+  put_u32(0);  // Hueco para la longitud
+}
+
+void Protocol::Encoder::put_u8(uint8_t value) {
+  data_.push_back(static_cast<char>(value));
+}
+
+void Protocol::Encoder::put_u16(uint16_t value) {
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  data_.insert(data_.end(), bytes, bytes + sizeof(value));
+}
+
+void Protocol::Encoder::put_u32(uint32_t value) {
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  data_.insert(data_.end(), bytes, bytes + sizeof(value));
+}
+
+void Protocol::Encoder::put_u64(uint64_t value) {
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  data_.insert(data_.end(), bytes, bytes + sizeof(value));
+}
+
+void Protocol::Encoder::put_i64(int64_t value) {
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  data_.insert(data_.end(), bytes, bytes + sizeof(value));
+}
+
+void Protocol::Encoder::put_string(std::string_view text) {
+  put_u32(static_cast<uint32_t>(text.size()));
+  data_.insert(data_.end(), text.begin(), text.end());
+}
+
+void Protocol::Encoder::finish() {
+  uint32_t length = static_cast<uint32_t>(data_.size() - frame_start_ - sizeof(uint32_t));
+  std::memcpy(data_.data() + frame_start_, &length, sizeof(length));
+}
+
+const std::vector<char>& Protocol::Encoder::data() const {
+  return data_;
+}
+
+size_t Protocol::Encoder::size() const {
+  return data_.size();
+}
+
+void Protocol::Encoder::clear() {
+  data_.clear();
+  frame_start_ = 0;
+}
+
+Protocol::Decoder::Decoder(const char* data, size_t size)
+    : data_(data), size_(size), offset_(0), ok_(true) {
+}
+
+bool Protocol::Decoder::take(void* out, size_t count) {
+  if (!ok_ || size_ - offset_ < count) {
+    ok_ = false;
+    std::memset(out, 0, count);
+    return false;
+  }
+  std::memcpy(out, data_ + offset_, count);
+  offset_ += count;
+  return true;
+}
+
+uint8_t Protocol::Decoder::get_u8() {
+  uint8_t value;
+  take(&value, sizeof(value));
+  return value;
+}
+
+uint16_t Protocol::Decoder::get_u16() {
+  uint16_t value;
+  take(&value, sizeof(value));
+  return value;
+}
+
+uint32_t Protocol::Decoder::get_u32() {
+  uint32_t value;
+  take(&value, sizeof(value));
+  return value;
+}
+
+uint64_t Protocol::Decoder::get_u64() {
+  uint64_t value;
+  take(&value, sizeof(value));
+  return value;
+}
+
+int64_t Protocol::Decoder::get_i64() {
+  int64_t value;
+  take(&value, sizeof(value));
+  return value;
+}
+
+std::string Protocol::Decoder::get_string() {
+  uint32_t length = get_u32();
+  if (!ok_ || size_ - offset_ < length) {
+    ok_ = false;
+    return std::string();
+  }
+  std::string text(data_ + offset_, length);
+  offset_ += length;
+  return text;
+}
+
+bool Protocol::Decoder::ok() const {
+  return ok_;
+}
+
+bool Protocol::Decoder::at_end() const {
+  return offset_ == size_;
+}
+
+void Protocol::encode_request(Encoder& encoder, const Request& request) {
+  encoder.begin();
+  encoder.put_u8(REQUEST_SIMULATE);
+  encoder.put_u8(VERSION);
+  encoder.put_string(request.machine);
+  encoder.put_u64(request.max_steps);
+  encoder.put_u8(request.include_tape ? OPTION_INCLUDE_TAPE : 0);
+  encoder.put_u32(static_cast<uint32_t>(request.words.size()));
+  for (const std::string& word : request.words) {
+    encoder.put_string(word);
+  }
+  encoder.finish();
+}
+
+bool Protocol::decode_request(const std::vector<char>& payload, Request& request,
+                              std::string& error) {
+  Decoder decoder(payload.data(), payload.size());
+  uint8_t type = decoder.get_u8();
+  uint8_t version = decoder.get_u8();
+  if (!decoder.ok() || type != REQUEST_SIMULATE) {
+    error = "Tipo de petición desconocido";
+    return false;
+  }
+  if (version != VERSION) {
+    error = "Versión de protocolo no soportada: " + std::to_string(version);
+    return false;
+  }
+
+  request.machine = decoder.get_string();
+  request.max_steps = decoder.get_u64();
+  request.include_tape = (decoder.get_u8() & OPTION_INCLUDE_TAPE) != 0;
+  uint32_t num_words = decoder.get_u32();
+  request.words.clear();
+  // Cada palabra ocupa al menos su longitud: acota la reserva ante tramas falsas
+  if (decoder.ok() && num_words <= payload.size() / sizeof(uint32_t)) {
+    request.words.reserve(num_words);
+  }
+  for (uint32_t i = 0; i < num_words && decoder.ok(); ++i) {
+    request.words.push_back(decoder.get_string());
+  }
+
+  if (!decoder.ok() || !decoder.at_end()) {
+    error = "Petición mal formada";
+    return false;
+  }
+  return true;
+}
+
+bool Protocol::decode_response(const std::vector<char>& payload, Response& response) {
+  Decoder decoder(payload.data(), payload.size());
+  response = Response();
+  response.type = decoder.get_u8();
+
+  switch (response.type) {
+    case RESPONSE_RESULT: {
+      response.index = decoder.get_u32();
+      uint8_t result = decoder.get_u8();
+      if (result > static_cast<uint8_t>(SimulationResult::TIMEOUT)) {
+        return false;
+      }
+      response.result = static_cast<SimulationResult>(result);
+      response.steps = decoder.get_u64();
+      uint16_t num_tapes = decoder.get_u16();
+      for (uint16_t i = 0; i < num_tapes && decoder.ok(); ++i) {
+        TapeResult tape;
+        tape.head = decoder.get_i64();
+        tape.content = decoder.get_string();
+        response.tapes.push_back(std::move(tape));
+      }
+      break;
+    }
+    case RESPONSE_END:
+      response.index = decoder.get_u32();
+      break;
+    case RESPONSE_ERROR:
+      response.message = decoder.get_string();
+      break;
+    default:
+      return false;
+  }
+  return decoder.ok() && decoder.at_end();
+}
+
+void Protocol::encode_error(Encoder& encoder, std::string_view message) {
+  encoder.begin();
+  encoder.put_u8(RESPONSE_ERROR);
+  encoder.put_string(message);
+  encoder.finish();
+}
+
+bool Protocol::write_all(int fd, const char* data, size_t size) {
+  size_t written = 0;
+  while (written < size) {
+    ssize_t count = ::write(fd, data + written, size - written);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    written += static_cast<size_t>(count);
+  }
+  return true;
+}
+
+namespace {
+
+bool read_exact(int fd, char* data, size_t size) {
+  size_t done = 0;
+  while (done < size) {
+    ssize_t count = ::read(fd, data + done, size - done);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    if (count == 0) {
+      return false;  // Fin de fichero
+    }
+    done += static_cast<size_t>(count);
+  }
+  return true;
+}
+
+}  // namespace
+
+bool Protocol::read_frame(int fd, std::vector<char>& payload) {
+  uint32_t length = 0;
+  if (!read_exact(fd, reinterpret_cast<char*>(&length), sizeof(length))) {
+    return false;
+  }
+  if (length > MAX_FRAME_SIZE) {
+    return false;
+  }
+  payload.resize(length);
+  return length == 0 || read_exact(fd, payload.data(), length);
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Simulator.hpp"
+
+/**
+ * @brief Protocolo binario del modo servidor (--serve)
+ *
+ * Cada mensaje es una trama: longitud de la carga (u32) seguida de la carga.
+ * Los enteros van en el orden de bytes del anfitrión (cliente y servidor
+ * comparten máquina al hablar por un socket Unix).
+ *
+ * Petición (cliente -> servidor):
+ *   tipo (u8 = REQUEST_SIMULATE), versión (u8), máquina (u32 longitud + bytes),
+ *   límite de pasos (u64, 0 = sin límite), opciones (u8, bit 0 = incluir cintas),
+ *   número de palabras (u32) y por palabra longitud (u32) + bytes.
+ *
+ * Respuesta (servidor -> cliente), una trama por palabra y una de cierre:
+ *   RESPONSE_RESULT: tipo (u8), índice (u32), resultado (u8), pasos (u64),
+ *     número de cintas (u16) y por cinta cabezal (i64) + longitud (u32) + bytes.
+ *   RESPONSE_END:    tipo (u8), número de resultados enviados (u32).
+ *   RESPONSE_ERROR:  tipo (u8), mensaje (u32 longitud + bytes). Termina la petición.
+ *
+ * Una conexión puede enviar varias peticiones seguidas; cada una se responde
+ * por completo antes de leer la siguiente.
+ */
+class Protocol {
+public:
+  static constexpr uint8_t VERSION = 1;
+  static constexpr uint8_t REQUEST_SIMULATE = 1;
+  static constexpr uint8_t RESPONSE_RESULT = 1;
+  static constexpr uint8_t RESPONSE_END = 2;
+  static constexpr uint8_t RESPONSE_ERROR = 3;
+  static constexpr uint8_t OPTION_INCLUDE_TAPE = 1;
+  static constexpr uint32_t MAX_FRAME_SIZE = 64u << 20;  // 64 MiB
+
+  /**
+   * @brief Petición de simulación de un lote de palabras
+   */
+  struct Request {
+    std::string machine;              // Identificador (ruta) de la máquina
+    uint64_t max_steps = 1000;        // Límite de pasos (de 1 al límite del servidor)
+    bool include_tape = true;         // Si devolver el contenido final de las cintas
+    std::vector<std::string> words;   // Palabras a simular
+  };
+
+  /**
+   * @brief Contenido final de una cinta en una respuesta
+   */
+  struct TapeResult {
+    int64_t head;          // Posición del cabezal
+    std::string content;   // Contenido de la cinta
+  };
+
+  /**
+   * @brief Trama de respuesta decodificada
+   */
+  struct Response {
+    uint8_t type = RESPONSE_ERROR;          // RESPONSE_RESULT, RESPONSE_END o RESPONSE_ERROR
+    uint32_t index = 0;                     // Índice de la palabra (RESULT) o total (END)
+    SimulationResult result = SimulationResult::ERROR;
+    uint64_t steps = 0;                     // Pasos ejecutados
+    std::vector<TapeResult> tapes;          // Cintas finales (si se pidieron)
+    std::string message;                    // Mensaje de error (ERROR)
+  };
+
+  /**
+   * @brief Constructor incremental de la carga de una trama
+   *
+   * Reserva al principio el hueco de la longitud, que se rellena en finish().
+   * Varias tramas pueden acumularse en el mismo buffer antes de enviarlas.
+   */
+  class Encoder {
+  private:
+    std::vector<char> data_;  // Tramas acumuladas
+    size_t frame_start_;      // Inicio de la trama en curso
+
+  public:
+    Encoder();
+
+    void begin();
+    void put_u8(uint8_t value);
+    void put_u16(uint16_t value);
+    void put_u32(uint32_t value);
+    void put_u64(uint64_t value);
+    void put_i64(int64_t value);
+    void put_string(std::string_view text);
+
+    /**
+     * @brief Cierra la trama en curso escribiendo su longitud
+     */
+    void finish();
+
+    const std::vector<char>& data() const;
+    size_t size() const;
+    void clear();
+  };
+
+  /**
+   * @brief Lector de la carga de una trama con comprobación de límites
+   */
+  class Decoder {
+  private:
+    const char* data_;  // Carga de la trama
+    size_t size_;       // Tamaño de la carga
+    size_t offset_;     // Posición de lectura
+    bool ok_;           // false tras intentar leer más allá del final
+
+    bool take(void* out, size_t count);
+
+  public:
+    Decoder(const char* data, size_t size);
+
+    uint8_t get_u8();
+    uint16_t get_u16();
+    uint32_t get_u32();
+    uint64_t get_u64();
+    int64_t get_i64();
+    std::string get_string();
+
+    /**
+     * @brief Verifica que todas las lecturas estuvieron dentro de la carga
+     * @return true si no hubo lecturas fuera de límites
+     */
+    bool ok() const;
+
+    /**
+     * @brief Verifica si se consumió toda la carga
+     * @return true si no quedan bytes
+     */
+    bool at_end() const;
+  };
+
+  /**
+   * @brief Añade una petición como trama al codificador
+   * @param encoder Codificador de destino
+   * @param request Petición a codificar
+   */
+  static void encode_request(Encoder& encoder, const Request& request);
+
+  /**
+   * @brief Decodifica la carga de una trama de petición
+   * @param payload Carga de la trama
+   * @param request Salida: petición decodificada
+   * @param error Salida: motivo del rechazo
+   * @return true si la petición es válida
+   */
+  static bool decode_request(const std::vector<char>& payload, Request& request,
+                             std::string& error);
+
+  /**
+   * @brief Decodifica la carga de una trama de respuesta
+   * @param payload Carga de la trama
+   * @param response Salida: respuesta decodificada
+   * @return true si la trama es válida
+   */
+  static bool decode_response(const std::vector<char>& payload, Response& response);
+
+  /**
+   * @brief Añade una trama de error al codificador
+   * @param encoder Codificador de destino
+   * @param message Mensaje de error
+   */
+  static void encode_error(Encoder& encoder, std::string_view message);
+
+  /**
+   * @brief Escribe todos los bytes en un descriptor (reintenta escrituras parciales)
+   * @param fd Descriptor de destino
+   * @param data Bytes a escribir
+   * @param size Número de bytes
+   * @return true si se escribió todo
+   */
+  static bool write_all(int fd, const char* data, size_t size);
+
+  /**
+   * @brief Lee una trama completa de un descriptor bloqueante
+   * @param fd Descriptor de origen
+   * @param payload Salida: carga de la trama
+   * @return true si se leyó una trama; false en fin de fichero, error o trama demasiado grande
+   */
+  static bool read_frame(int fd, std::vector<char>& payload);
+};
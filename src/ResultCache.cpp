@@ -0,0 +1,234 @@
+#include "ResultCache.hpp"
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+const char CACHE_MAGIC[4] = {'M', 'T', 'R', 'C'};
+
+template <typename T>
+bool read_value(std::istream& in, T& value) {
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+template <typename T>
+void write_value(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace
+
+ResultCache::ResultCache(size_t capacity)
+    : capacity_(capacity), disk_enabled_(false), disk_stale_(false), machine_hash_(0),
+      hits_(0), disk_hits_(0), misses_(0) {
+}
+
+uint64_t ResultCache::hash_bytes(std::string_view data, uint64_t seed) {
+  uint64_t hash = seed;
+  for (char c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+uint64_t ResultCache::digest_tape(const Tape& tape, uint64_t seed) {
+  int64_t head = tape.get_head_position();
+  uint64_t hash = hash_bytes(std::string_view(reinterpret_cast<const char*>(&head), sizeof(head)), seed);
+  tape.for_each_content_chunk([&hash](std::string_view chunk) { hash = hash_bytes(chunk, hash); });
+  return hash;
+}
+
+bool ResultCache::is_proven(const CachedResult& value) {
+  return value.result != SimulationResult::INFINITE || value.proof != InfiniteProof::NONE;
+}
+
+bool ResultCache::is_valid_for(const CachedResult& value, size_t max_steps) {
+  switch (value.result) {
+    case SimulationResult::ACCEPTED:
+    case SimulationResult::REJECTED:
+      return max_steps == 0 || value.steps < max_steps;
+    case SimulationResult::INFINITE:
+      if (value.proof == InfiniteProof::NONE) {
+        return max_steps == value.steps;
+      }
+      return max_steps == 0 || value.steps <= max_steps;
+    default:
+      return false;
+  }
+}
+
+bool ResultCache::open_disk(const std::string& path, uint64_t machine_hash) {
+  disk_enabled_ = true;
+  disk_path_ = path;
+  disk_stale_ = false;
+  machine_hash_ = machine_hash;
+  disk_.clear();
+
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) {
+    return true;  // Se creará al guardar
+  }
+
+  char magic[4];
+  uint32_t version = 0;
+  if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 ||
+      !read_value(in, version) || version > FILE_VERSION) {
+    last_error_ = "Fichero de caché con formato desconocido: " + path;
+    disk_enabled_ = false;
+    return false;
+  }
+  if (version < FILE_VERSION) {
+    // Registros de una versión anterior: se descartan y el fichero se
+    // reescribe en el próximo guardado
+    disk_stale_ = true;
+    return true;
+  }
+
+  std::string word;
+  while (true) {
+    uint64_t record_machine = 0;
+    uint32_t length = 0;
+    if (!read_value(in, record_machine) || !read_value(in, length)) {
+      break;
+    }
+    word.resize(length);
+    uint8_t result = 0;
+    uint8_t proof = 0;
+    CachedResult value{};
+    if (!in.read(&word[0], length) || !read_value(in, result) || !read_value(in, proof) ||
+        !read_value(in, value.steps) || !read_value(in, value.tape_digest)) {
+      break;  // Registro truncado (p. ej. ejecución interrumpida): se ignora
+    }
+    value.result = static_cast<SimulationResult>(result);
+    value.proof = static_cast<InfiniteProof>(proof);
+    if (record_machine != machine_hash_ || !is_proven(value)) {
+      continue;  // Otra máquina, o un límite de pasos guardado por versiones anteriores
+    }
+    uint64_t hash = hash_bytes(word);
+    disk_[hash] = Entry{hash, word, value};
+  }
+  return true;
+}
+
+bool ResultCache::save_disk() {
+  if (!disk_enabled_ || pending_.empty()) {
+    return true;
+  }
+
+  bool exists = !disk_stale_ && static_cast<bool>(std::ifstream(disk_path_, std::ios::binary));
+  std::ofstream out(disk_path_, std::ios::binary | (exists ? std::ios::app : std::ios::trunc));
+  if (!out.is_open()) {
+    last_error_ = "No se puede escribir el fichero de caché: " + disk_path_;
+    return false;
+  }
+  disk_stale_ = false;
+  if (!exists) {
+    out.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    write_value(out, FILE_VERSION);
+  }
+
+  for (uint64_t hash : pending_) {
+    auto it = disk_.find(hash);
+    if (it == disk_.end()) {
+      continue;
+    }
+    const Entry& entry = it->second;
+    write_value(out, machine_hash_);
+    write_value(out, static_cast<uint32_t>(entry.word.size()));
+    out.write(entry.word.data(), static_cast<std::streamsize>(entry.word.size()));
+    write_value(out, static_cast<uint8_t>(entry.value.result));
+    write_value(out, static_cast<uint8_t>(entry.value.proof));
+    write_value(out, entry.value.steps);
+    write_value(out, entry.value.tape_digest);
+  }
+  pending_.clear();
+
+  if (!out) {
+    last_error_ = "Error al escribir el fichero de caché: " + disk_path_;
+    return false;
+  }
+  return true;
+}
+
+void ResultCache::insert_memory(uint64_t hash, std::string_view word, const CachedResult& value) {
+  if (capacity_ == 0) {
+    return;
+  }
+
+  auto it = index_.find(hash);
+  if (it != index_.end()) {
+    // Misma huella (misma palabra o colisión): se reemplaza la entrada
+    it->second->word.assign(word.data(), word.size());
+    it->second->value = value;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return;
+  }
+
+  if (lru_.size() >= capacity_) {
+    index_.erase(lru_.back().hash);
+    lru_.pop_back();
+  }
+  lru_.push_front(Entry{hash, std::string(word), value});
+  index_[hash] = lru_.begin();
+}
+
+bool ResultCache::lookup(std::string_view word, size_t max_steps, CachedResult& out) {
+  uint64_t hash = hash_bytes(word);
+
+  auto it = index_.find(hash);
+  if (it != index_.end() && it->second->word == word && is_valid_for(it->second->value, max_steps)) {
+    lru_.splice(lru_.begin(), lru_, it->second);
+    out = it->second->value;
+    hits_++;
+    return true;
+  }
+
+  if (disk_enabled_ && !disk_.empty()) {
+    auto disk_it = disk_.find(hash);
+    if (disk_it != disk_.end() && disk_it->second.word == word &&
+        is_valid_for(disk_it->second.value, max_steps)) {
+      out = disk_it->second.value;
+      insert_memory(hash, word, out);
+      hits_++;
+      disk_hits_++;
+      return true;
+    }
+  }
+
+  misses_++;
+  return false;
+}
+
+void ResultCache::store(std::string_view word, const CachedResult& value) {
+  uint64_t hash = hash_bytes(word);
+  insert_memory(hash, word, value);
+  if (disk_enabled_ && is_proven(value)) {
+    disk_[hash] = Entry{hash, std::string(word), value};
+    pending_.push_back(hash);
+  }
+}
+
+uint64_t ResultCache::get_hits() const {
+  return hits_;
+}
+
+uint64_t ResultCache::get_disk_hits() const {
+  return disk_hits_;
+}
+
+uint64_t ResultCache::get_misses() const {
+  return misses_;
+}
+
+size_t ResultCache::get_disk_entries() const {
+  return disk_.size();
+}
+
+size_t ResultCache::get_pending_entries() const {
+  return pending_.size();
+}
+
+const std::string& ResultCache::get_last_error() const {
+  return last_error_;
+}
@@ -0,0 +1,146 @@
+#pragma once
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Simulator.hpp"
+
+/**
+ * @brief Resultado memorizado de una palabra
+ */
+struct CachedResult {
+  SimulationResult result;  // Resultado de la simulación
+  uint64_t steps;           // Pasos ejecutados
+  uint64_t tape_digest;     // Huella del contenido final de las cintas
+  InfiniteProof proof;      // Prueba del resultado INFINITE (NONE = límite de pasos)
+};
+
+/**
+ * @brief Caché de resultados para palabras repetidas de una máquina
+ *
+ * Nivel en memoria: LRU acotada por número de entradas, indexada por la huella
+ * (FNV-1a de 64 bits) de la palabra. Se guarda también la palabra para descartar
+ * colisiones de huella.
+ *
+ * Nivel en disco (opcional): fichero de registros que sobrevive entre
+ * ejecuciones, indexado por (huella del fichero de la máquina, palabra). Al
+ * cargarlo solo se conservan los registros de la máquina actual; los resultados
+ * nuevos se añaden al final del fichero al guardar, sin reescribir los demás.
+ * Al disco solo van veredictos probados: un INFINITE por límite de pasos
+ * depende de --max-steps y se queda en memoria.
+ *
+ * Un resultado memorizado solo se usa si la simulación con el límite de pasos
+ * actual habría terminado igual (ver is_valid_for()).
+ *
+ * Formato del fichero: cabecera "MTRC" + versión (u32) y, por registro: huella
+ * de máquina (u64), longitud de la palabra (u32), bytes de la palabra,
+ * resultado (u8), prueba de INFINITE (u8), pasos (u64) y huella de cinta (u64).
+ */
+class ResultCache {
+private:
+  struct Entry {
+    uint64_t hash;        // Huella de la palabra
+    std::string word;     // Palabra (para descartar colisiones)
+    CachedResult value;   // Resultado memorizado
+  };
+
+  size_t capacity_;                                                   // Máximo de entradas en memoria
+  std::list<Entry> lru_;                                              // Más reciente al principio
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;   // Huella -> entrada
+
+  bool disk_enabled_;                                        // Si hay nivel en disco
+  std::string disk_path_;                                    // Fichero del nivel en disco
+  bool disk_stale_;                                          // Si el fichero es de una versión anterior y se reescribe
+  uint64_t machine_hash_;                                    // Huella del fichero de la máquina
+  std::unordered_map<uint64_t, Entry> disk_;                 // Registros del disco por huella
+  std::vector<uint64_t> pending_;                            // Huellas de resultados nuevos sin guardar
+
+  uint64_t hits_;         // Aciertos (memoria + disco)
+  uint64_t disk_hits_;    // Aciertos servidos por el nivel en disco
+  uint64_t misses_;       // Fallos
+  std::string last_error_;
+
+  void insert_memory(uint64_t hash, std::string_view word, const CachedResult& value);
+
+  /**
+   * @brief Indica si el resultado no depende del límite de pasos (va al disco)
+   */
+  static bool is_proven(const CachedResult& value);
+
+public:
+  // 3: las claves de configuración incluyen el inicio del contenido; las
+  // pruebas de configuración repetida de versiones anteriores no valen
+  static constexpr uint32_t FILE_VERSION = 3;
+
+  /**
+   * @brief Constructor de la caché
+   * @param capacity Número máximo de entradas en memoria (0 = sin nivel en memoria)
+   */
+  explicit ResultCache(size_t capacity);
+
+  /**
+   * @brief Activa el nivel en disco cargando los registros de la máquina dada
+   * @param path Fichero de la caché (se crea al guardar si no existe)
+   * @param machine_hash Huella del fichero de la máquina
+   * @return true si se pudo leer (un fichero inexistente no es error)
+   */
+  bool open_disk(const std::string& path, uint64_t machine_hash);
+
+  /**
+   * @brief Añade al fichero de disco los resultados nuevos
+   * @return true si se pudo escribir
+   */
+  bool save_disk();
+
+  /**
+   * @brief Busca el resultado memorizado de una palabra
+   * @param word Palabra a buscar
+   * @param max_steps Límite de pasos de la simulación actual (0 = sin límite)
+   * @param out Salida: resultado memorizado
+   * @return true si hubo acierto válido para ese límite
+   */
+  bool lookup(std::string_view word, size_t max_steps, CachedResult& out);
+
+  /**
+   * @brief Indica si un resultado memorizado es el que daría una simulación
+   *        con el límite de pasos indicado
+   *
+   * ACCEPT y REJECT en el paso s necesitan un límite mayor que s; un bucle
+   * probado en el paso s, un límite de al menos s; un INFINITE por límite de
+   * pasos, exactamente el mismo límite.
+   */
+  static bool is_valid_for(const CachedResult& value, size_t max_steps);
+
+  /**
+   * @brief Memoriza el resultado de una palabra recién simulada (en disco solo
+   *        si es un veredicto probado)
+   * @param word Palabra simulada
+   * @param value Resultado a memorizar
+   */
+  void store(std::string_view word, const CachedResult& value);
+
+  uint64_t get_hits() const;
+  uint64_t get_disk_hits() const;
+  uint64_t get_misses() const;
+  size_t get_disk_entries() const;
+  size_t get_pending_entries() const;
+  const std::string& get_last_error() const;
+
+  /**
+   * @brief Huella FNV-1a de 64 bits de una secuencia de bytes
+   * @param data Bytes a resumir
+   * @param seed Valor inicial (permite encadenar varias llamadas)
+   * @return Huella
+   */
+  static uint64_t hash_bytes(std::string_view data, uint64_t seed = 14695981039346656037ULL);
+
+  /**
+   * @brief Huella del contenido final de una cinta (cabezal y contenido)
+   * @param tape Cinta a resumir
+   * @param seed Valor inicial (para encadenar varias cintas)
+   * @return Huella
+   */
+  static uint64_t digest_tape(const Tape& tape, uint64_t seed = 14695981039346656037ULL);
+};
@@ -0,0 +1,283 @@
+#include "ResultWriter.hpp"
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+ResultWriter::ResultWriter(OutputFormat format, bool include_tape, int fd,
+                           size_t buffer_size)
+    : format_(format), include_tape_(include_tape), fd_(fd),
+      buffer_(buffer_size > 0 ? buffer_size : DEFAULT_BUFFER_SIZE),
+      used_(0), header_written_(false) {
+}
+
+ResultWriter::~ResultWriter() {
+  flush();
+}
+
+void ResultWriter::flush() {
+  size_t written = 0;
+  while (written < used_) {
+    ssize_t count = ::write(fd_, buffer_.data() + written, used_ - written);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;  // Destino cerrado (p. ej. tubería): se descarta el resto
+    }
+    written += static_cast<size_t>(count);
+  }
+  used_ = 0;
+}
+
+void ResultWriter::append_raw(const void* data, size_t size) {
+  if (used_ + size > buffer_.size()) {
+    flush();
+    if (size > buffer_.size()) {
+      buffer_.resize(size);
+    }
+  }
+  std::memcpy(buffer_.data() + used_, data, size);
+  used_ += size;
+}
+
+void ResultWriter::append(std::string_view data) {
+  append_raw(data.data(), data.size());
+}
+
+void ResultWriter::append_unsigned(uint64_t value) {
+  char digits[20];
+  size_t length = 0;
+  do {
+    digits[sizeof(digits) - 1 - length] = static_cast<char>('0' + value % 10);
+    value /= 10;
+    length++;
+  } while (value != 0);
+  append_raw(digits + sizeof(digits) - length, length);
+}
+
+void ResultWriter::append_signed(int64_t value) {
+  if (value < 0) {
+    append("-");
+    append_unsigned(static_cast<uint64_t>(-(value + 1)) + 1);
+  } else {
+    append_unsigned(static_cast<uint64_t>(value));
+  }
+}
+
+void ResultWriter::append_json_string(std::string_view text) {
+  append("\"");
+  append_json_escaped(text);
+  append("\"");
+}
+
+void ResultWriter::append_json_escaped(std::string_view text) {
+  static const char hex[] = "0123456789abcdef";
+  size_t run_start = 0;
+  for (size_t i = 0; i < text.size(); ++i) {
+    unsigned char c = static_cast<unsigned char>(text[i]);
+    if (c >= 0x20 && c != '"' && c != '\\') {
+      continue;
+    }
+    append(text.substr(run_start, i - run_start));
+    if (c == '"' || c == '\\') {
+      char escaped[2] = {'\\', static_cast<char>(c)};
+      append_raw(escaped, 2);
+    } else {
+      char escaped[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0x0F]};
+      append_raw(escaped, 6);
+    }
+    run_start = i + 1;
+  }
+  append(text.substr(run_start));
+}
+
+void ResultWriter::append_hex(uint64_t value) {
+  static const char hex[] = "0123456789abcdef";
+  char digits[16];
+  for (int i = 15; i >= 0; --i) {
+    digits[i] = hex[value & 0x0F];
+    value >>= 4;
+  }
+  append_raw(digits, sizeof(digits));
+}
+
+void ResultWriter::append_binary_header() {
+  if (!header_written_) {
+    append("MTRB");
+    uint32_t version = BINARY_VERSION;
+    append_raw(&version, sizeof(version));
+    header_written_ = true;
+  }
+}
+
+std::string ResultWriter::digest_to_string(uint64_t value) {
+  static const char hex[] = "0123456789abcdef";
+  std::string text(16, '0');
+  for (int i = 15; i >= 0; --i) {
+    text[i] = hex[value & 0x0F];
+    value >>= 4;
+  }
+  return text;
+}
+
+void ResultWriter::write_record(size_t index, SimulationResult result, size_t steps,
+                                const Configuration* config) {
+  tapes_.clear();
+  if (config != nullptr) {
+    tapes_.push_back(&config->get_tape());
+  }
+  write_tapes_record(index, result, steps);
+}
+
+void ResultWriter::write_record(size_t index, SimulationResult result, size_t steps,
+                                const MultiConfiguration* config) {
+  tapes_.clear();
+  if (config != nullptr) {
+    const MultiTape& tapes = config->get_tapes();
+    for (size_t i = 0; i < tapes.get_num_tapes(); ++i) {
+      tapes_.push_back(&tapes.get_tape(i));
+    }
+  }
+  write_tapes_record(index, result, steps);
+}
+
+void ResultWriter::write_tapes_record(size_t index, SimulationResult result, size_t steps) {
+  if (!include_tape_) {
+    tapes_.clear();
+  }
+
+  switch (format_) {
+    case OutputFormat::JSONL: {
+      append("{\"index\":");
+      append_unsigned(index);
+      append(",\"result\":\"");
+      append(Simulator::result_to_string(result));
+      append("\",\"steps\":");
+      append_unsigned(steps);
+      if (include_tape_) {
+        append(",\"heads\":[");
+        for (size_t i = 0; i < tapes_.size(); ++i) {
+          if (i > 0) append(",");
+          append_signed(tapes_[i]->get_head_position());
+        }
+        append("],\"tapes\":[");
+        for (size_t i = 0; i < tapes_.size(); ++i) {
+          if (i > 0) append(",");
+          // El contenido pasa por trozos: una cinta enorme no se copia entera
+          append("\"");
+          tapes_[i]->for_each_content_chunk([this](std::string_view chunk) { append_json_escaped(chunk); });
+          append("\"");
+        }
+        append("]");
+      }
+      append("}\n");
+      break;
+    }
+
+    case OutputFormat::TSV: {
+      append_unsigned(index);
+      append("\t");
+      append(Simulator::result_to_string(result));
+      append("\t");
+      append_unsigned(steps);
+      for (const Tape* tape : tapes_) {
+        append("\t");
+        append_signed(tape->get_head_position());
+        append("\t");
+        tape->for_each_content_chunk([this](std::string_view chunk) { append(chunk); });
+      }
+      append("\n");
+      break;
+    }
+
+    case OutputFormat::BINARY: {
+      append_binary_header();
+      uint64_t index64 = index;
+      uint8_t result8 = static_cast<uint8_t>(result);
+      uint64_t steps64 = steps;
+      uint16_t num_tapes = static_cast<uint16_t>(tapes_.size());
+      append_raw(&index64, sizeof(index64));
+      append_raw(&result8, sizeof(result8));
+      append_raw(&steps64, sizeof(steps64));
+      append_raw(&num_tapes, sizeof(num_tapes));
+      for (const Tape* tape : tapes_) {
+        int64_t head = tape->get_head_position();
+        uint32_t length = static_cast<uint32_t>(tape->get_content_size());
+        append_raw(&head, sizeof(head));
+        append_raw(&length, sizeof(length));
+        tape->for_each_content_chunk([this](std::string_view chunk) { append(chunk); });
+      }
+      break;
+    }
+
+    case OutputFormat::TEXT:
+      // El formato de texto lo imprime main directamente
+      break;
+  }
+}
+
+void ResultWriter::write_digest_record(size_t index, SimulationResult result, size_t steps,
+                                       uint64_t tape_digest) {
+  if (!include_tape_) {
+    tapes_.clear();
+    write_tapes_record(index, result, steps);
+    return;
+  }
+
+  switch (format_) {
+    case OutputFormat::JSONL:
+      append("{\"index\":");
+      append_unsigned(index);
+      append(",\"result\":\"");
+      append(Simulator::result_to_string(result));
+      append("\",\"steps\":");
+      append_unsigned(steps);
+      append(",\"tape_digest\":\"");
+      append_hex(tape_digest);
+      append("\"}\n");
+      break;
+
+    case OutputFormat::TSV:
+      append_unsigned(index);
+      append("\t");
+      append(Simulator::result_to_string(result));
+      append("\t");
+      append_unsigned(steps);
+      append("\t");
+      append_hex(tape_digest);
+      append("\n");
+      break;
+
+    case OutputFormat::BINARY: {
+      append_binary_header();
+      uint64_t index64 = index;
+      uint8_t result8 = static_cast<uint8_t>(result);
+      uint64_t steps64 = steps;
+      uint16_t mark = BINARY_DIGEST_MARK;
+      append_raw(&index64, sizeof(index64));
+      append_raw(&result8, sizeof(result8));
+      append_raw(&steps64, sizeof(steps64));
+      append_raw(&mark, sizeof(mark));
+      append_raw(&tape_digest, sizeof(tape_digest));
+      break;
+    }
+
+    case OutputFormat::TEXT:
+      break;
+  }
+}
+
+bool ResultWriter::parse_format(const std::string& name, OutputFormat& format) {
+  if (name == "text") {
+    format = OutputFormat::TEXT;
+  } else if (name == "jsonl") {
+    format = OutputFormat::JSONL;
+  } else if (name == "tsv") {
+    format = OutputFormat::TSV;
+  } else if (name == "binary") {
+    format = OutputFormat::BINARY;
+  } else {
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Configuration.hpp"
+#include "MultiConfiguration.hpp"
+#include "Simulator.hpp"
+
+/**
+ * @brief Formatos de salida de resultados
+ */
+enum class OutputFormat {
+  TEXT,    // Salida legible original (ACCEPT + "Cinta final: ...")
+  JSONL,   // Un objeto JSON por línea
+  TSV,     // Columnas separadas por tabuladores
+  BINARY   // Registros binarios de tamaño variable
+};
+
+/**
+ * @brief Escritor de resultados por lotes con buffer propio
+ *
+ * Escribe un registro por palabra (índice, resultado, pasos y, opcionalmente,
+ * el contenido final de cada cinta con la posición del cabezal) en un buffer
+ * de usuario que solo se vuelca al descriptor cuando se llena.
+ *
+ * Formatos:
+ * - JSONL: {"index":0,"result":"ACCEPT","steps":12,"heads":[4],"tapes":["XXYY"]}
+ * - TSV:   índice, resultado, pasos y, por cinta, cabezal y contenido
+ * - BINARY: cabecera "MTRB" + versión (u32) y, por registro: índice (u64),
+ *   resultado (u8), pasos (u64), número de cintas (u16) y por cinta cabezal
+ *   (i64), longitud (u32) y bytes. Enteros en el orden de bytes del anfitrión.
+ *
+ * El formato TEXT no pasa por esta clase: lo sigue imprimiendo main.
+ */
+class ResultWriter {
+private:
+  OutputFormat format_;       // Formato de salida
+  bool include_tape_;         // Si incluir el contenido final de las cintas
+  int fd_;                    // Descriptor de destino
+  std::vector<char> buffer_;  // Buffer de salida
+  size_t used_;               // Bytes ocupados del buffer
+  bool header_written_;       // Si ya se escribió la cabecera binaria
+
+  std::vector<const Tape*> tapes_;  // Cintas del registro en curso (reutilizado)
+
+  void append(std::string_view data);
+  void append_raw(const void* data, size_t size);
+  void append_unsigned(uint64_t value);
+  void append_signed(int64_t value);
+  void append_json_string(std::string_view text);
+  void append_json_escaped(std::string_view text);
+  void append_hex(uint64_t value);
+  void append_binary_header();
+
+  /**
+   * @brief Escribe un registro con las cintas cargadas en tapes_
+   */
+  void write_tapes_record(size_t index, SimulationResult result, size_t steps);
+
+public:
+  static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;  // 1 MiB
+  static constexpr uint32_t BINARY_VERSION = 1;
+  static constexpr uint16_t BINARY_DIGEST_MARK = 0xFFFF;  // Registro con huella en vez de cintas
+
+  /**
+   * @brief Formatea una huella como 16 dígitos hexadecimales
+   * @param value Huella
+   * @return Texto hexadecimal
+   */
+  static std::string digest_to_string(uint64_t value);
+
+  /**
+   * @brief Constructor del escritor
+   * @param format Formato de salida (no TEXT)
+   * @param include_tape Si incluir el contenido final de las cintas
+   * @param fd Descriptor de destino (por defecto la salida estándar)
+   * @param buffer_size Tamaño del buffer de salida
+   */
+  ResultWriter(OutputFormat format, bool include_tape, int fd = 1,
+               size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+  ResultWriter(const ResultWriter&) = delete;
+  ResultWriter& operator=(const ResultWriter&) = delete;
+
+  /**
+   * @brief Destructor: vuelca lo que quede en el buffer
+   */
+  ~ResultWriter();
+
+  /**
+   * @brief Escribe el registro de una palabra simulada en una máquina monocinta
+   * @param index Índice de la palabra (desde 0)
+   * @param result Resultado de la simulación
+   * @param steps Pasos ejecutados
+   * @param config Configuración final (nullptr si la palabra no se simuló)
+   */
+  void write_record(size_t index, SimulationResult result, size_t steps,
+                    const Configuration* config);
+
+  /**
+   * @brief Escribe el registro de una palabra simulada en una máquina multicinta
+   * @param index Índice de la palabra (desde 0)
+   * @param result Resultado de la simulación
+   * @param steps Pasos ejecutados
+   * @param config Configuración final (nullptr si la palabra no se simuló)
+   */
+  void write_record(size_t index, SimulationResult result, size_t steps,
+                    const MultiConfiguration* config);
+
+  /**
+   * @brief Escribe el registro de una palabra con la huella de las cintas
+   *
+   * Usado con la caché de resultados, que solo memoriza la huella del
+   * contenido final. En JSONL se emite el campo "tape_digest", en TSV una
+   * columna con la huella y en binario el número de cintas 0xFFFF seguido de
+   * la huella (u64). Con --no-tape se omite la huella.
+   *
+   * @param index Índice de la palabra (desde 0)
+   * @param result Resultado de la simulación
+   * @param steps Pasos ejecutados
+   * @param tape_digest Huella del contenido final de las cintas
+   */
+  void write_digest_record(size_t index, SimulationResult result, size_t steps,
+                           uint64_t tape_digest);
+
+  /**
+   * @brief Vuelca el buffer al descriptor
+   */
+  void flush();
+
+  /**
+   * @brief Convierte el nombre de un formato en su valor
+   * @param name Nombre ("text", "jsonl", "tsv" o "binary")
+   * @param format Salida: formato reconocido
+   * @return true si el nombre es válido
+   */
+  static bool parse_format(const std::string& name, OutputFormat& format);
+};
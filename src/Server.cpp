@@ -0,0 +1,429 @@
+#include "Server.hpp"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Parser.hpp"
+#include "Simulator.hpp"
+
+MachineRegistry::LoadResult MachineRegistry::load(const std::string& id) {
+  LoadResult result;
+  auto loaded = std::make_shared<LoadedMachine>();
+  if (CompiledMachine::is_image_file(id)) {
+    if (!loaded->compiled.load_image(id)) {
+      result.error = loaded->compiled.get_last_error();
+      return result;
+    }
+  } else {
+    TuringMachine machine;
+    MultiTuringMachine multi_machine(1);
+    bool is_multi_tape = false;
+    {
+      std::lock_guard<std::mutex> lock(parser_mutex_);
+      try {
+        if (!Parser::load_auto_detect(id, machine, multi_machine, is_multi_tape)) {
+          result.error = Parser::get_last_error();
+          return result;
+        }
+      } catch (const std::exception& e) {
+        result.error = e.what();
+        return result;
+      }
+    }
+    bool compiled = is_multi_tape ? loaded->compiled.compile(multi_machine)
+                                  : loaded->compiled.compile(machine);
+    if (!compiled) {
+      result.error = loaded->compiled.get_last_error();
+      return result;
+    }
+  }
+  result.machine = loaded;
+  return result;
+}
+
+void MachineRegistry::evict() {
+  while (machines_.size() > MAX_MACHINES) {
+    auto oldest = machines_.begin();
+    for (auto it = machines_.begin(); it != machines_.end(); ++it) {
+      if (it->second.last_use < oldest->second.last_use) {
+        oldest = it;
+      }
+    }
+    machines_.erase(oldest);
+  }
+}
+
+std::shared_ptr<const LoadedMachine> MachineRegistry::get(const std::string& id,
+                                                          std::string& error) {
+  struct stat info;
+  if (stat(id.c_str(), &info) != 0) {
+    error = "No se puede abrir el archivo: " + id;
+    return nullptr;
+  }
+  int64_t mtime_ns = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+
+  std::shared_future<LoadResult> result;
+  std::promise<LoadResult> promise;
+  uint64_t generation = 0;  // Distinto de 0 si la carga esta petición
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = machines_[id];
+    if (!entry.result.valid() || entry.mtime_ns != mtime_ns || entry.size != info.st_size ||
+        entry.inode != static_cast<uint64_t>(info.st_ino)) {
+      // Nueva o el fichero cambió: la carga esta petición
+      entry.result = promise.get_future().share();
+      entry.mtime_ns = mtime_ns;
+      entry.size = static_cast<int64_t>(info.st_size);
+      entry.inode = static_cast<uint64_t>(info.st_ino);
+      entry.generation = generation = ++use_clock_;
+    }
+    entry.last_use = ++use_clock_;
+    result = entry.result;
+    evict();
+  }
+
+  if (generation != 0) {
+    LoadResult loaded = load(id);
+    if (loaded.machine == nullptr) {
+      // Un error no se recuerda: la siguiente petición lo vuelve a intentar
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = machines_.find(id);
+      if (it != machines_.end() && it->second.generation == generation) {
+        machines_.erase(it);
+      }
+    }
+    promise.set_value(std::move(loaded));
+  }
+
+  const LoadResult& loaded = result.get();
+  if (loaded.machine == nullptr) {
+    error = loaded.error;
+  }
+  return loaded.machine;
+}
+
+size_t MachineRegistry::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return machines_.size();
+}
+
+Server::Server(const std::string& socket_path, size_t num_workers, size_t max_connections)
+    : socket_path_(socket_path),
+      num_workers_(num_workers > 0 ? num_workers : 1),
+      max_connections_(max_connections > 0 ? max_connections : 1),
+      listen_fd_(-1), active_(0), stopping_(false), max_steps_limit_(DEFAULT_MAX_STEPS_LIMIT),
+      idle_timeout_ms_(DEFAULT_IDLE_TIMEOUT_S * 1000), requests_served_(0), words_served_(0) {
+}
+
+Server::~Server() {
+  stop();
+}
+
+bool Server::start() {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (socket_path_.size() >= sizeof(address.sun_path)) {
+    last_error_ = "Ruta de socket demasiado larga: " + socket_path_;
+    return false;
+  }
+  std::memcpy(address.sun_path, socket_path_.c_str(), socket_path_.size() + 1);
+
+  listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (listen_fd_ < 0) {
+    last_error_ = std::string("No se puede crear el socket: ") + std::strerror(errno);
+    return false;
+  }
+
+  // Un socket abandonado por un servidor anterior se reemplaza; uno activo no
+  struct stat info;
+  if (::stat(socket_path_.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+    int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    bool in_use = probe >= 0 &&
+                  ::connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+    if (probe >= 0) {
+      ::close(probe);
+    }
+    if (in_use) {
+      last_error_ = "Ya hay un servidor escuchando en " + socket_path_;
+      ::close(listen_fd_);
+      listen_fd_ = -1;
+      return false;
+    }
+    ::unlink(socket_path_.c_str());
+  }
+
+  if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+      ::listen(listen_fd_, SOMAXCONN) < 0) {
+    last_error_ = "No se puede escuchar en " + socket_path_ + ": " + std::strerror(errno);
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+    return false;
+  }
+
+  for (size_t i = 0; i < num_workers_; ++i) {
+    workers_.emplace_back(&Server::worker_loop, this);
+  }
+  return true;
+}
+
+void Server::run(const volatile std::sig_atomic_t* stop_flag) {
+  pollfd listener{listen_fd_, POLLIN, 0};
+  while (!*stop_flag && !stopping_) {
+    int ready = ::poll(&listener, 1, POLL_INTERVAL_MS);
+    if (ready <= 0) {
+      continue;  // Tiempo agotado o señal: se vuelve a comprobar la parada
+    }
+
+    int client = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (client < 0) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (active_ + pending_.size() >= max_connections_) {
+      lock.unlock();
+      reject_connection(client, "Servidor ocupado: límite de conexiones alcanzado");
+      continue;
+    }
+    pending_.push_back(client);
+    lock.unlock();
+    cv_.notify_one();
+  }
+  stop();
+}
+
+void Server::stop() {
+  if (stopping_.exchange(true)) {
+    return;
+  }
+
+  if (listen_fd_ >= 0) {
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+    ::unlink(socket_path_.c_str());
+  }
+
+  // Las peticiones en curso terminan en el siguiente punto de comprobación
+  {
+    std::lock_guard<std::mutex> lock(running_mutex_);
+    for (CancellationToken* token : running_) {
+      token->cancel();
+    }
+  }
+
+  cv_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+
+  // Conexiones que no llegó a recoger ningún hilo
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (int fd : pending_) {
+    reject_connection(fd, "Servidor detenido");
+  }
+  pending_.clear();
+}
+
+void Server::worker_loop() {
+  while (true) {
+    int fd;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      fd = pending_.front();
+      pending_.pop_front();
+      active_++;
+    }
+
+    handle_connection(fd);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_--;
+  }
+}
+
+void Server::handle_connection(int fd) {
+  // Una trama empezada debe llegar completa en un tiempo razonable, y un
+  // cliente que no lee las respuestas no bloquea el envío para siempre
+  timeval timeout{IO_TIMEOUT_S, 0};
+  ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+  std::vector<char> payload;
+  Protocol::Request request;
+  Protocol::Encoder out;
+
+  int idle_ms = 0;
+  while (!stopping_) {
+    // Entre peticiones se espera por intervalos para notar la parada; una
+    // conexión inactiva demasiado tiempo se cierra para liberar el hilo
+    pollfd client{fd, POLLIN, 0};
+    int ready = ::poll(&client, 1, POLL_INTERVAL_MS);
+    if (ready == 0 || (ready < 0 && errno == EINTR)) {
+      idle_ms += POLL_INTERVAL_MS;
+      if (idle_ms >= idle_timeout_ms_) {
+        break;
+      }
+      continue;
+    }
+    idle_ms = 0;
+    if (ready < 0 || !Protocol::read_frame(fd, payload)) {
+      break;  // Cliente desconectado, error o trama demasiado grande
+    }
+
+    std::string error;
+    if (!Protocol::decode_request(payload, request, error)) {
+      out.clear();
+      Protocol::encode_error(out, error);
+      Protocol::write_all(fd, out.data().data(), out.size());
+      break;
+    }
+
+    if (!handle_request(fd, request, out)) {
+      break;
+    }
+    requests_served_++;
+  }
+  ::close(fd);
+}
+
+bool Server::handle_request(int fd, const Protocol::Request& request, Protocol::Encoder& out) {
+  out.clear();
+
+  std::string error;
+  std::shared_ptr<const LoadedMachine> loaded = registry_.get(request.machine, error);
+  if (!loaded) {
+    Protocol::encode_error(out, "[Error carga] " + error);
+    return Protocol::write_all(fd, out.data().data(), out.size());
+  }
+
+  // Sin límite (0) o por encima del del servidor, una palabra que no para
+  // retendría el hilo y su memoria indefinidamente
+  if (request.max_steps == 0 || request.max_steps > max_steps_limit_) {
+    Protocol::encode_error(out, "[Error] max_steps debe estar entre 1 y " + std::to_string(max_steps_limit_));
+    return Protocol::write_all(fd, out.data().data(), out.size());
+  }
+  size_t max_steps = static_cast<size_t>(request.max_steps);
+
+  // Cancelación de la petición, visible para stop() mientras está en curso
+  CancellationToken cancellation;
+  {
+    std::lock_guard<std::mutex> lock(running_mutex_);
+    if (stopping_) {
+      cancellation.cancel();
+    }
+    running_.insert(&cancellation);
+  }
+  struct Unregister {
+    Server* server;
+    CancellationToken* token;
+    ~Unregister() {
+      std::lock_guard<std::mutex> lock(server->running_mutex_);
+      server->running_.erase(token);
+    }
+  } unregister{this, &cancellation};
+
+  // Simuladores propios de la petición: la máquina compilada se comparte
+  const CompiledMachine& compiled = loaded->compiled;
+  bool is_multi_tape = compiled.is_multi_tape();
+  std::unique_ptr<Simulator> simulator;
+  std::unique_ptr<MultiSimulator> multi_simulator;
+  if (is_multi_tape) {
+    multi_simulator = std::make_unique<MultiSimulator>(&compiled);
+    multi_simulator->set_cancellation_token(&cancellation);
+  } else {
+    simulator = std::make_unique<Simulator>(&compiled);
+    simulator->set_cancellation_token(&cancellation);
+  }
+
+  for (size_t index = 0; index < request.words.size(); ++index) {
+    const std::string& word = request.words[index];
+    SimulationResult result = SimulationResult::REJECTED;
+    size_t steps = 0;
+    bool simulated = false;
+
+    // Como en la línea de comandos, una palabra fuera del alfabeto se rechaza
+    if (compiled.is_valid_input_word(word)) {
+      try {
+        if (is_multi_tape) {
+          result = multi_simulator->simulate_validated(word, false, max_steps);
+          steps = multi_simulator->get_step_count();
+        } else {
+          result = simulator->simulate_validated(word, false, max_steps);
+          steps = simulator->get_step_count();
+        }
+        simulated = true;
+      } catch (const std::exception&) {
+        result = SimulationResult::ERROR;
+      }
+    }
+
+    out.begin();
+    out.put_u8(Protocol::RESPONSE_RESULT);
+    out.put_u32(static_cast<uint32_t>(index));
+    out.put_u8(static_cast<uint8_t>(result));
+    out.put_u64(steps);
+    if (simulated && request.include_tape) {
+      if (is_multi_tape) {
+        const MultiTape& tapes = multi_simulator->get_current_configuration().get_tapes();
+        out.put_u16(static_cast<uint16_t>(tapes.get_num_tapes()));
+        for (size_t i = 0; i < tapes.get_num_tapes(); ++i) {
+          out.put_i64(tapes.get_tape(i).get_head_position());
+          out.put_string(tapes.get_tape(i).get_content());
+        }
+      } else {
+        const Tape& tape = simulator->get_current_configuration().get_tape();
+        out.put_u16(1);
+        out.put_i64(tape.get_head_position());
+        out.put_string(tape.get_content());
+      }
+    } else {
+      out.put_u16(0);
+    }
+    out.finish();
+    words_served_++;
+
+    // Los resultados se envían por bloques mientras se sigue simulando
+    if (out.size() >= FLUSH_THRESHOLD) {
+      if (!Protocol::write_all(fd, out.data().data(), out.size())) {
+        return false;
+      }
+      out.clear();
+    }
+  }
+
+  out.begin();
+  out.put_u8(Protocol::RESPONSE_END);
+  out.put_u32(static_cast<uint32_t>(request.words.size()));
+  out.finish();
+  bool sent = Protocol::write_all(fd, out.data().data(), out.size());
+  out.clear();
+  return sent;
+}
+
+void Server::reject_connection(int fd, const std::string& message) {
+  Protocol::Encoder out;
+  Protocol::encode_error(out, message);
+  Protocol::write_all(fd, out.data().data(), out.size());
+  ::close(fd);
+}
+
+uint64_t Server::get_requests_served() const {
+  return requests_served_;
+}
+
+uint64_t Server::get_words_served() const {
+  return words_served_;
+}
+
+const std::string& Server::get_last_error() const {
+  return last_error_;
+}
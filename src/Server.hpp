@@ -0,0 +1,214 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <csignal>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "CancellationToken.hpp"
+#include "CompiledMachine.hpp"
+#include "Protocol.hpp"
+
+/**
+ * @brief Máquina cargada y compilada, lista para simular (monocinta o multicinta)
+ *
+ * Es inmutable una vez registrada: cada petición crea su propio simulador
+ * sobre ella, así que varios hilos pueden usarla a la vez.
+ */
+struct LoadedMachine {
+  CompiledMachine compiled;  // Forma compilada (desde texto o imagen .tmb)
+};
+
+/**
+ * @brief Registro de máquinas cargadas, indexado por la ruta del fichero
+ *
+ * La primera petición que nombra una máquina la carga (con el Parser o, si es
+ * una imagen .tmb, proyectándola) y la compila; las siguientes reutilizan la
+ * forma compilada en memoria. La carga se hace fuera del cerrojo del
+ * registro: las peticiones de la misma máquina esperan a su std::shared_future
+ * y las de otras máquinas no esperan. Cada entrada recuerda la fecha de
+ * modificación, el tamaño y el nodo del fichero, y se vuelve a cargar si
+ * cambian. Con más de MAX_MACHINES entradas se descarta la usada hace más
+ * tiempo (las peticiones en curso conservan su máquina).
+ */
+class MachineRegistry {
+public:
+  static constexpr size_t MAX_MACHINES = 64;  // Máquinas en memoria como mucho
+
+private:
+  /**
+   * @brief Resultado de una carga: la máquina o el error
+   */
+  struct LoadResult {
+    std::shared_ptr<const LoadedMachine> machine;
+    std::string error;
+  };
+
+  /**
+   * @brief Máquina registrada (o en carga) y el fichero del que salió
+   */
+  struct Entry {
+    std::shared_future<LoadResult> result;  // Se cumple al terminar la carga
+    int64_t mtime_ns = 0;                   // Fecha de modificación del fichero
+    int64_t size = 0;                       // Tamaño del fichero
+    uint64_t inode = 0;                     // Nodo del fichero (detecta reemplazos)
+    uint64_t last_use = 0;                  // Orden de último uso (para descartar)
+    uint64_t generation = 0;                // Carga que la creó (para borrarla si falla)
+  };
+
+  std::mutex mutex_;                               // Protege machines_ y use_clock_
+  std::mutex parser_mutex_;                        // Serializa el Parser (usa estado estático)
+  std::unordered_map<std::string, Entry> machines_;
+  uint64_t use_clock_ = 0;                         // Contador de usos
+
+  /**
+   * @brief Carga y compila una máquina (sin el cerrojo del registro)
+   */
+  LoadResult load(const std::string& id);
+
+  /**
+   * @brief Descarta la entrada usada hace más tiempo si sobran (con mutex_)
+   */
+  void evict();
+
+public:
+  /**
+   * @brief Obtiene una máquina, cargándola si aún no está registrada
+   * @param id Ruta del fichero de la máquina
+   * @param error Salida: mensaje de error si no se pudo cargar
+   * @return Máquina cargada o nullptr si hubo error
+   */
+  std::shared_ptr<const LoadedMachine> get(const std::string& id, std::string& error);
+
+  /**
+   * @brief Número de máquinas registradas
+   */
+  size_t size();
+};
+
+/**
+ * @brief Servidor de simulaciones sobre un socket Unix (mt-sim --serve)
+ *
+ * Un hilo acepta conexiones y las encola; un conjunto fijo de hilos de trabajo
+ * atiende cada conexión (varias peticiones seguidas) y envía un resultado por
+ * palabra según Protocol. Si ya hay max_connections conexiones atendidas o en
+ * cola, las nuevas se rechazan con un error. Al detenerse deja de aceptar,
+ * cancela las peticiones en curso (sus palabras pendientes terminan con
+ * TIMEOUT), rechaza las conexiones en cola y borra el socket.
+ *
+ * Ningún cliente puede retener un hilo indefinidamente: cada petición tiene
+ * un límite de pasos obligatorio y acotado por el servidor, una conexión sin
+ * peticiones durante idle_timeout se cierra, y leer o enviar una trama tiene
+ * un plazo de IO_TIMEOUT_S.
+ */
+class Server {
+private:
+  std::string socket_path_;   // Ruta del socket
+  size_t num_workers_;        // Hilos de trabajo
+  size_t max_connections_;    // Máximo de conexiones atendidas + en cola
+  int listen_fd_;             // Socket de escucha (-1 si cerrado)
+
+  MachineRegistry registry_;                 // Máquinas cargadas
+  std::mutex mutex_;                         // Protege pending_ y active_
+  std::condition_variable cv_;               // Aviso de conexión nueva o parada
+  std::deque<int> pending_;                  // Conexiones en espera de un hilo
+  size_t active_;                            // Conexiones atendidas ahora mismo
+  std::atomic<bool> stopping_;               // Parada en curso
+  size_t max_steps_limit_;                   // Límite de pasos máximo de una petición
+  int idle_timeout_ms_;                      // Espera máxima entre peticiones de una conexión
+  std::mutex running_mutex_;                 // Protege running_
+  std::unordered_set<CancellationToken*> running_;  // Cancelación de las peticiones en curso
+  std::vector<std::thread> workers_;         // Hilos de trabajo
+
+  std::atomic<uint64_t> requests_served_;    // Peticiones atendidas
+  std::atomic<uint64_t> words_served_;       // Palabras simuladas
+  std::string last_error_;                   // Último error ocurrido
+
+  /**
+   * @brief Bucle de un hilo de trabajo
+   */
+  void worker_loop();
+
+  /**
+   * @brief Atiende todas las peticiones de una conexión y la cierra
+   * @param fd Descriptor de la conexión
+   */
+  void handle_connection(int fd);
+
+  /**
+   * @brief Simula las palabras de una petición y envía los resultados
+   * @param fd Descriptor de la conexión
+   * @param request Petición decodificada
+   * @param out Codificador reutilizado para las tramas de respuesta
+   * @return false si falló la escritura (la conexión debe cerrarse)
+   */
+  bool handle_request(int fd, const Protocol::Request& request, Protocol::Encoder& out);
+
+  /**
+   * @brief Envía un error y cierra una conexión que no se va a atender
+   * @param fd Descriptor de la conexión
+   * @param message Mensaje de error
+   */
+  static void reject_connection(int fd, const std::string& message);
+
+public:
+  static constexpr size_t FLUSH_THRESHOLD = 64 * 1024;  // Bytes de respuesta antes de enviar
+  static constexpr int POLL_INTERVAL_MS = 200;          // Espera máxima entre comprobaciones de parada
+  static constexpr int IO_TIMEOUT_S = 30;               // Espera máxima a mitad de una trama (lectura o envío)
+  static constexpr size_t DEFAULT_MAX_STEPS_LIMIT = 100000000;  // Límite de pasos máximo por defecto
+  static constexpr int DEFAULT_IDLE_TIMEOUT_S = 300;    // Espera entre peticiones por defecto
+
+  /**
+   * @brief Constructor del servidor
+   * @param socket_path Ruta del socket Unix
+   * @param num_workers Número de hilos de trabajo
+   * @param max_connections Máximo de conexiones atendidas o en cola
+   */
+  Server(const std::string& socket_path, size_t num_workers, size_t max_connections);
+
+  Server(const Server&) = delete;
+  Server& operator=(const Server&) = delete;
+
+  /**
+   * @brief Destructor: detiene el servidor si sigue activo
+   */
+  ~Server();
+
+  /**
+   * @brief Límite de pasos máximo que puede pedir una petición (antes de start())
+   */
+  void set_max_steps_limit(size_t limit) { max_steps_limit_ = limit > 0 ? limit : 1; }
+
+  /**
+   * @brief Segundos sin peticiones tras los que se cierra una conexión (antes de start())
+   */
+  void set_idle_timeout(int seconds) { idle_timeout_ms_ = (seconds > 0 ? seconds : 1) * 1000; }
+
+  /**
+   * @brief Crea el socket y arranca los hilos de trabajo
+   * @return true si el socket quedó escuchando
+   */
+  bool start();
+
+  /**
+   * @brief Acepta conexiones hasta que stop_flag se activa y luego se detiene
+   * @param stop_flag Indicador activado por el manejador de señales
+   */
+  void run(const volatile std::sig_atomic_t* stop_flag);
+
+  /**
+   * @brief Detiene el servidor ordenadamente (idempotente)
+   */
+  void stop();
+
+  uint64_t get_requests_served() const;
+  uint64_t get_words_served() const;
+  const std::string& get_last_error() const;
+};
@@ -0,0 +1,123 @@
+#include "SimulationGenerator.hpp"
+#include <algorithm>
+
+SimulationGenerator::SimulationGenerator(Simulator* simulator)
+    : SimulationGenerator(SimulatorHandle(simulator)) {
+}
+
+SimulationGenerator::SimulationGenerator(MultiSimulator* simulator)
+    : SimulationGenerator(SimulatorHandle(simulator)) {
+}
+
+SimulationGenerator::SimulationGenerator(const SimulatorHandle& simulator)
+    : simulator_(simulator), yield_every_(0), raw_steps_(false), watch_writes_(false),
+      watch_boundaries_(false), slice_start_(simulator.step_count()), finished_(false) {
+  for (size_t i = 0; i < simulator_.num_tapes(); ++i) {
+    min_head_.push_back(simulator_.tape(i).get_head_position());
+  }
+  max_head_ = min_head_;
+  head_before_.resize(simulator_.num_tapes());
+  symbol_before_.resize(simulator_.num_tapes());
+}
+
+std::optional<SimulationResult> SimulationGenerator::advance() {
+  if (!raw_steps_) {
+    return simulator_.run(1);
+  }
+  if (simulator_.is_accepting()) {
+    return SimulationResult::ACCEPTED;
+  }
+  if (!simulator_.step()) {
+    return SimulationResult::REJECTED;
+  }
+  return std::nullopt;
+}
+
+SimulationEvent& SimulationGenerator::emit(SimulationEventKind kind) {
+  pending_.emplace_back();
+  SimulationEvent& event = pending_.back();
+  event.kind = kind;
+  event.step = simulator_.step_count();
+  return event;
+}
+
+std::optional<SimulationResult> SimulationGenerator::step_with_events() {
+  size_t step = simulator_.step_count();
+  uint32_t state = simulator_.state_id();
+  if (watch_writes_) {
+    for (size_t i = 0; i < simulator_.num_tapes(); ++i) {
+      head_before_[i] = simulator_.tape(i).get_head_position();
+      symbol_before_[i] = simulator_.tape(i).read();
+    }
+  }
+
+  std::optional<SimulationResult> result = advance();
+  if (simulator_.step_count() == step) {
+    return result;  // Terminó sin dar el paso
+  }
+
+  if (!watched_states_.empty() && simulator_.state_id() != state &&
+      std::find(watched_states_.begin(), watched_states_.end(), simulator_.state()) != watched_states_.end()) {
+    emit(SimulationEventKind::STATE_ENTERED).state = simulator_.state_id();
+  }
+  if (watch_writes_) {
+    for (size_t i = 0; i < simulator_.num_tapes(); ++i) {
+      char symbol = simulator_.tape(i).read_at(head_before_[i]);
+      if (symbol != symbol_before_[i]) {
+        SimulationEvent& event = emit(SimulationEventKind::CELL_WRITTEN);
+        event.tape = i;
+        event.position = head_before_[i];
+        event.symbol = symbol;
+      }
+    }
+  }
+  if (watch_boundaries_) {
+    for (size_t i = 0; i < simulator_.num_tapes(); ++i) {
+      int head = simulator_.tape(i).get_head_position();
+      if (head < min_head_[i] || head > max_head_[i]) {
+        min_head_[i] = std::min(min_head_[i], head);
+        max_head_[i] = std::max(max_head_[i], head);
+        SimulationEvent& event = emit(SimulationEventKind::BOUNDARY_CROSSED);
+        event.tape = i;
+        event.position = head;
+      }
+    }
+  }
+  return result;
+}
+
+bool SimulationGenerator::next() {
+  if (pending_.empty()) {
+    if (finished_) {
+      return false;
+    }
+    std::optional<SimulationResult> result;
+    if (!watches_steps()) {
+      // Sin eventos por paso, el tramo entero en una llamada
+      size_t elapsed = simulator_.step_count() - slice_start_;
+      result = simulator_.run(yield_every_ == 0 ? 0 : yield_every_ > elapsed ? yield_every_ - elapsed : 1);
+      if (!result.has_value()) {
+        emit(SimulationEventKind::SLICE);
+        slice_start_ = simulator_.step_count();
+      }
+    } else {
+      while (pending_.empty()) {
+        result = step_with_events();
+        if (result.has_value()) {
+          break;
+        }
+        if (yield_every_ > 0 && simulator_.step_count() - slice_start_ >= yield_every_) {
+          emit(SimulationEventKind::SLICE);
+          slice_start_ = simulator_.step_count();
+        }
+      }
+    }
+    if (result.has_value()) {
+      finished_ = true;
+      emit(SimulationEventKind::FINISHED).result = result.value();
+    }
+  }
+  event_ = pending_.front();
+  pending_.pop_front();
+  return true;
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Simulator.hpp"
+#include "SimulatorHandle.hpp"
+
+/**
+ * @brief Tipo de evento de una simulación
+ */
+enum class SimulationEventKind {
+  SLICE,             // Se dieron los pasos de un tramo (set_yield_every)
+  STATE_ENTERED,     // Un paso llevó a uno de los estados vigilados
+  CELL_WRITTEN,      // Un paso cambió el símbolo de una celda
+  BOUNDARY_CROSSED,  // Un cabezal llegó a una celda más allá de las ya visitadas
+  FINISHED           // La simulación terminó (result)
+};
+
+/**
+ * @brief Evento entregado por SimulationGenerator::next()
+ */
+struct SimulationEvent {
+  SimulationEventKind kind = SimulationEventKind::SLICE;
+  size_t step = 0;          // Pasos dados al producirse
+  size_t tape = 0;          // Cinta (CELL_WRITTEN, BOUNDARY_CROSSED)
+  int position = 0;         // Celda escrita o nueva posición del cabezal
+  char symbol = '\0';       // Símbolo escrito (CELL_WRITTEN)
+  uint32_t state = 0;       // Estado alcanzado (STATE_ENTERED)
+  SimulationResult result = SimulationResult::ERROR;  // Resultado (FINISHED)
+};
+
+/**
+ * @brief Generador de eventos sobre una simulación en curso
+ *
+ * Sustituye al bucle de simulate() por una simulación que se avanza desde
+ * fuera: cada next() ejecuta pasos hasta el siguiente evento y lo deja en
+ * get_event(), así que un solo hilo puede llevar muchas simulaciones a la vez
+ * (un planificador, un depurador o un visualizador) sin callbacks ni hilos.
+ * Es el equivalente a una corrutina que hace co_yield de cada evento, escrito
+ * a mano porque el proyecto compila con C++17.
+ *
+ * El simulador se prepara antes con start() o restore_checkpoint(). Sin
+ * eventos de paso vigilados, los tramos se ejecutan con run(presupuesto) a
+ * plena velocidad; con alguno, paso a paso con run(1), que conserva la
+ * detección de bucles, el límite de pasos y las interrupciones. Con
+ * set_raw_steps() los pasos son los de step(), sin detección ni límite, como
+ * los da el depurador. Los eventos de un mismo paso se entregan en el orden
+ * de SimulationEventKind, con su SLICE al final; el último es siempre
+ * FINISHED y después next() devuelve false.
+ *
+ * @code
+ *   simulator.start(word, false, max_steps);
+ *   SimulationGenerator generator(&simulator);
+ *   generator.watch_state("q_accept");
+ *   while (generator.next()) {
+ *     const SimulationEvent& event = generator.get_event();
+ *     ...
+ *   }
+ * @endcode
+ */
+class SimulationGenerator {
+private:
+  SimulatorHandle simulator_;               // Simulador de cualquiera de los dos tipos
+  size_t yield_every_;                      // Pasos por tramo (0 = sin eventos SLICE)
+  bool raw_steps_;                          // Si se avanza con step() en vez de run(1)
+  std::vector<std::string> watched_states_; // Estados de STATE_ENTERED
+  bool watch_writes_;                       // Si se emite CELL_WRITTEN
+  bool watch_boundaries_;                   // Si se emite BOUNDARY_CROSSED
+  std::vector<int> min_head_;               // Celda más a la izquierda visitada por cinta
+  std::vector<int> max_head_;               // Celda más a la derecha visitada por cinta
+  std::vector<int> head_before_;            // Cabezales antes del paso en curso
+  std::vector<char> symbol_before_;         // Símbolos bajo ellos antes del paso
+  std::deque<SimulationEvent> pending_;     // Eventos producidos y aún no entregados
+  SimulationEvent event_;                   // Último evento entregado
+  size_t slice_start_;                      // Paso en que empezó el tramo actual
+  bool finished_;                           // Si ya se produjo FINISHED
+
+  /**
+   * @brief Indica si hay que dar los pasos de uno en uno
+   */
+  bool watches_steps() const { return raw_steps_ || !watched_states_.empty() || watch_writes_ || watch_boundaries_; }
+
+  /**
+   * @brief Da un paso con run(1) o, con set_raw_steps(), con step()
+   * @return Resultado si la simulación terminó
+   */
+  std::optional<SimulationResult> advance();
+
+  /**
+   * @brief Da un paso y encola sus eventos
+   * @return Resultado si la simulación terminó
+   */
+  std::optional<SimulationResult> step_with_events();
+
+  /**
+   * @brief Encola un evento con el paso actual
+   */
+  SimulationEvent& emit(SimulationEventKind kind);
+
+public:
+  /**
+   * @brief Constructor sobre un simulador monocinta ya preparado
+   * @param simulator Simulador (debe sobrevivir al generador)
+   */
+  explicit SimulationGenerator(Simulator* simulator);
+
+  /**
+   * @brief Constructor sobre un simulador multicinta ya preparado
+   * @param simulator Simulador (debe sobrevivir al generador)
+   */
+  explicit SimulationGenerator(MultiSimulator* simulator);
+
+  /**
+   * @brief Constructor sobre cualquiera de los dos simuladores ya preparado
+   * @param simulator Simulador (debe sobrevivir al generador)
+   */
+  explicit SimulationGenerator(const SimulatorHandle& simulator);
+
+  /**
+   * @brief Emite SLICE cada tantos pasos
+   * @param steps Pasos por tramo (0 = hasta el siguiente evento o el final)
+   */
+  void set_yield_every(size_t steps) { yield_every_ = steps; }
+
+  /**
+   * @brief Avanza con step(): sin detección de bucles ni límite de pasos; la
+   *        simulación termina en ACCEPT al llegar a un estado de aceptación y
+   *        en REJECT sin transición aplicable
+   */
+  void set_raw_steps(bool enable = true) { raw_steps_ = enable; }
+
+  /**
+   * @brief Emite STATE_ENTERED cuando un paso cambia al estado indicado
+   */
+  void watch_state(std::string_view state) { watched_states_.emplace_back(state); }
+
+  /**
+   * @brief Emite CELL_WRITTEN cuando un paso cambia el símbolo de una celda
+   */
+  void watch_writes(bool enable = true) { watch_writes_ = enable; }
+
+  /**
+   * @brief Emite BOUNDARY_CROSSED cuando un cabezal llega a una celda en la que
+   *        no ha estado desde que se creó el generador
+   */
+  void watch_boundaries(bool enable = true) { watch_boundaries_ = enable; }
+
+  /**
+   * @brief Avanza la simulación hasta el siguiente evento
+   * @return false si ya se entregó FINISHED
+   */
+  bool next();
+
+  /**
+   * @brief Último evento entregado por next()
+   */
+  const SimulationEvent& get_event() const { return event_; }
+
+  /**
+   * @brief Indica si la simulación ya terminó
+   */
+  bool is_finished() const { return finished_; }
+};
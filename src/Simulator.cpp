@@ -1,12 +1,40 @@
 #include "Simulator.hpp"
+#include "Checkpoint.hpp"
+#include "DeciderPipeline.hpp"
+#include "Profiler.hpp"
+#include "ResultCache.hpp"
 #include <iostream>
 #include <sstream>
+#include <utility>
 
 Simulator::Simulator(const TuringMachine* machine)
-    : machine_(machine), current_config_("", "", '.'), 
-      trace_enabled_(false), max_steps_(1000), last_error_("") {
-  if (machine_ == nullptr) {
+    : machine_(nullptr), current_config_("", "", '.'), current_state_id_(0),
+      trace_enabled_(false), max_steps_(1000), last_error_(""), profiler_(nullptr),
+      deadline_(std::chrono::steady_clock::time_point::max()), cancellation_(nullptr),
+      infinite_proof_(InfiniteProof::NONE), deciders_(nullptr), decided_(false) {
+  if (machine == nullptr) {
     last_error_ = "La máquina de Turing no puede ser nullptr";
+    return;
+  }
+  owned_machine_ = std::make_unique<CompiledMachine>();
+  if (owned_machine_->compile(*machine)) {
+    machine_ = owned_machine_.get();
+  } else {
+    last_error_ = owned_machine_->get_last_error();
+  }
+}
+
+Simulator::Simulator(const CompiledMachine* machine)
+    : machine_(machine), current_config_("", "", '.'), current_state_id_(0),
+      trace_enabled_(false), max_steps_(1000), last_error_(""), profiler_(nullptr),
+      deadline_(std::chrono::steady_clock::time_point::max()), cancellation_(nullptr),
+      infinite_proof_(InfiniteProof::NONE), deciders_(nullptr), decided_(false) {
+  if (machine_ == nullptr || !machine_->is_loaded()) {
+    last_error_ = "La máquina de Turing no puede ser nullptr";
+    machine_ = nullptr;
+  } else if (machine_->get_num_tapes() != 1) {
+    last_error_ = "La máquina compilada no es monocinta";
+    machine_ = nullptr;
   }
 }
 
@@ -14,25 +42,39 @@ Simulator::~Simulator() {
   // Destructor por defecto
 }
 
-SimulationResult Simulator::simulate(const std::string& input_word, 
+SimulationResult Simulator::simulate(std::string_view input_word, 
                                     bool enable_trace, 
                                     size_t max_steps) {
-  // Verificar que la máquina sea válida
-  if (machine_ == nullptr) {
-    last_error_ = "No hay máquina de Turing asignada";
-    return SimulationResult::ERROR;
-  }
-  
-  if (!machine_->is_valid()) {
-    last_error_ = "La máquina de Turing no es válida";
+  if (!start(input_word, enable_trace, max_steps)) {
     return SimulationResult::ERROR;
   }
-  
+  return *run();
+}
+
+bool Simulator::start(std::string_view input_word, bool enable_trace, size_t max_steps) {
   // Verificar que la palabra de entrada sea válida
-  if (!machine_->is_valid_input_word(input_word)) {
+  if (machine_ != nullptr && !machine_->is_valid_input_word(input_word)) {
     last_error_ = "La palabra de entrada contiene símbolos no válidos";
+    return false;
+  }
+  return start_validated(input_word, enable_trace, max_steps);
+}
+
+SimulationResult Simulator::simulate_validated(std::string_view input_word, bool enable_trace, size_t max_steps) {
+  if (!start_validated(input_word, enable_trace, max_steps)) {
     return SimulationResult::ERROR;
   }
+  return *run();
+}
+
+bool Simulator::start_validated(std::string_view input_word, bool enable_trace, size_t max_steps) {
+  // Verificar que la máquina sea válida (se validó al compilarla)
+  if (machine_ == nullptr) {
+    if (last_error_.empty()) {
+      last_error_ = "No hay máquina de Turing asignada";
+    }
+    return false;
+  }
   
   // Configurar la simulación
   trace_enabled_ = enable_trace;
@@ -44,32 +86,68 @@ SimulationResult Simulator::simulate(const std::string& input_word,
   // Añadir configuración inicial a la traza
   add_to_trace();
   mark_configuration_as_visited();
-  
-  // Bucle principal de simulación
+  cycle_detector_.reset(current_config_.get_tape());
+
+  // Decisores de no parada antes del primer paso
+  if (deciders_ != nullptr) {
+    DeciderCertificate certificate;
+    if (deciders_->decide(input_word, certificate)) {
+      decided_ = true;
+      infinite_proof_ = certificate.proof;
+      infinite_certificate_ = std::move(certificate.detail);
+    }
+  }
+  return true;
+}
+
+std::optional<SimulationResult> Simulator::run(size_t step_budget) {
+  if (machine_ == nullptr) {
+    return SimulationResult::ERROR;
+  }
+  if (decided_) {
+    return SimulationResult::INFINITE;
+  }
+
+  // Bucle principal de simulación; cada vuelta da como mucho un paso, así que
+  // pararse al principio de una vuelta y seguir en otra llamada es equivalente
+  size_t first_step = current_config_.get_step_count();
   while (true) {
+    if (step_budget > 0 && current_config_.get_step_count() - first_step >= step_budget) {
+      return std::nullopt;
+    }
+
     // Verificar límite de pasos
     if (max_steps_ > 0 && current_config_.get_step_count() >= max_steps_) {
       return SimulationResult::INFINITE;
     }
+
+    // Plazo de reloj y cancelación, solo cada INTERRUPT_CHECK_INTERVAL pasos
+    if ((current_config_.get_step_count() & (Simulator::INTERRUPT_CHECK_INTERVAL - 1)) == 0 &&
+        is_interrupted()) {
+      return SimulationResult::TIMEOUT;
+    }
     
     // Verificar si estamos en un estado de aceptación
     if (is_accepting_state()) {
       return SimulationResult::ACCEPTED;
     }
     
-    // Verificar si hay transición aplicable
-    if (!has_applicable_transition()) {
-      return SimulationResult::REJECTED;
-    }
-    
-    // Ejecutar un paso
+    // Ejecutar un paso; sin transición aplicable la palabra se rechaza (la
+    // máquina ya se comprobó antes del bucle, así que step() solo falla por eso)
     if (!step()) {
-      last_error_ = "Error al ejecutar paso de simulación";
-      return SimulationResult::ERROR;
+      return SimulationResult::REJECTED;
     }
     
     // Verificar bucle infinito por configuraciones repetidas
     if (is_configuration_visited()) {
+      infinite_proof_ = InfiniteProof::REPEATED_CONFIGURATION;
+      return SimulationResult::INFINITE;
+    }
+
+    // Verificar bucle infinito por ciclos trasladados (solo mira algo en los
+    // récords del cabezal)
+    if (cycle_detector_.observe(current_config_.get_tape(), current_state_id_)) {
+      infinite_proof_ = InfiniteProof::TRANSLATED_CYCLE;
       return SimulationResult::INFINITE;
     }
     
@@ -85,20 +163,24 @@ bool Simulator::step() {
   }
   
   // Obtener transición aplicable
-  std::string current_state = current_config_.get_current_state();
   char current_symbol = current_config_.get_tape().read();
-  
-  const Transition* transition = machine_->get_transition(current_state, current_symbol);
-  if (transition == nullptr) {
+  uint32_t transition = machine_->find_transition(current_state_id_, &current_symbol);
+  if (transition == CompiledMachine::NO_TRANSITION) {
     return false;
   }
   
+  Movement movement = machine_->get_movement(transition, 0);
+  if (profiler_ != nullptr) {
+    profiler_->record_step(current_state_id_, transition);
+    profiler_->record_cell(0, current_config_.get_tape().get_head_position(), movement);
+  }
+  
   // Aplicar la transición
   // 1. Escribir el nuevo símbolo en la cinta
-  current_config_.get_tape().write(transition->get_write_symbol());
+  current_config_.get_tape().write(machine_->get_write_symbols(transition)[0]);
   
   // 2. Mover el cabezal
-  switch (transition->get_movement()) {
+  switch (movement) {
     case Movement::LEFT:
       current_config_.get_tape().move_left();
       break;
@@ -111,7 +193,8 @@ bool Simulator::step() {
   }
   
   // 3. Cambiar al nuevo estado
-  current_config_.set_current_state(transition->get_to_state());
+  current_state_id_ = machine_->get_to_state(transition);
+  current_config_.set_current_state(machine_->get_state_name(current_state_id_));
   
   // 4. Incrementar contador de pasos
   current_config_.increment_step_count();
@@ -119,23 +202,96 @@ bool Simulator::step() {
   return true;
 }
 
-void Simulator::reset(const std::string& input_word) {
+void Simulator::reset(std::string_view input_word) {
   if (machine_ != nullptr) {
-    current_config_.reset(machine_->get_initial_state(), input_word);
+    current_state_id_ = machine_->get_initial_state();
+    // Ancho de celda según el alfabeto de cinta (no cambia entre palabras)
+    const SymbolSet& alphabet = machine_->get_tape_alphabet();
+    current_config_.get_tape().set_alphabet(std::string(alphabet.begin(), alphabet.end()));
+    current_config_.reset(machine_->get_state_name(current_state_id_), input_word);
     current_config_.get_tape().set_head_position(0);  // Cabezal en posición inicial
+    if (profiler_ != nullptr) {
+      profiler_->begin_run(current_state_id_);
+    }
+#ifdef TAPE_STATS
+    if (tape_stats_ != nullptr) {
+      current_config_.get_tape().set_stats(tape_stats_);
+    }
+#endif
   }
   
   trace_.clear();
   visited_configurations_.clear();
+  restored_visited_.clear();
+  infinite_proof_ = InfiniteProof::NONE;
+  infinite_certificate_.clear();
+  decided_ = false;
   last_error_ = "";
 }
 
+void Simulator::save_checkpoint(Checkpoint& checkpoint) const {
+  const Tape& tape = current_config_.get_tape();
+  checkpoint.max_steps = max_steps_;
+  checkpoint.state = current_state_id_;
+  checkpoint.steps = current_config_.get_step_count();
+  checkpoint.tapes.assign(1, Checkpoint::TapeImage{tape.get_head_position(), tape.get_content_start(),
+                                                   tape.get_content()});
+  checkpoint.visited.assign(restored_visited_.begin(), restored_visited_.end());
+  for (const std::string& key : visited_configurations_) {
+    checkpoint.visited.push_back(ResultCache::hash_bytes(key));
+  }
+  cycle_detector_.save_state(checkpoint);
+}
+
+bool Simulator::restore_checkpoint(const Checkpoint& checkpoint) {
+  if (machine_ == nullptr) {
+    if (last_error_.empty()) {
+      last_error_ = "No hay máquina de Turing asignada";
+    }
+    return false;
+  }
+  if (checkpoint.state >= machine_->get_num_states() || checkpoint.tapes.size() != 1) {
+    last_error_ = "El punto de control no corresponde a esta máquina";
+    return false;
+  }
+
+  reset();
+  trace_enabled_ = false;
+  max_steps_ = checkpoint.max_steps;
+  current_state_id_ = checkpoint.state;
+  current_config_.set_current_state(machine_->get_state_name(current_state_id_));
+  const Checkpoint::TapeImage& image = checkpoint.tapes[0];
+  current_config_.get_tape().load(static_cast<int>(image.start), image.content,
+                                  static_cast<int>(image.head));
+  current_config_.set_step_count(checkpoint.steps);
+  restored_visited_.insert(checkpoint.visited.begin(), checkpoint.visited.end());
+  if (checkpoint.has_cycle_detector) {
+    cycle_detector_.restore_state(checkpoint);
+  } else {
+    cycle_detector_.reset(current_config_.get_tape());
+  }
+  return true;
+}
+
+bool Simulator::set_configuration(const Configuration& config) {
+  uint32_t state = machine_ != nullptr ? machine_->find_state(config.get_current_state())
+                                       : CompiledMachine::NO_TRANSITION;
+  if (state == CompiledMachine::NO_TRANSITION) {
+    last_error_ = "La configuración no corresponde a esta máquina";
+    return false;
+  }
+  current_config_ = config;
+  current_state_id_ = state;
+  cycle_detector_.reset(current_config_.get_tape());
+  return true;
+}
+
 bool Simulator::is_accepting_state() const {
   if (machine_ == nullptr) {
     return false;
   }
   
-  return machine_->is_accept_state(current_config_.get_current_state());
+  return machine_->is_accept_state(current_state_id_);
 }
 
 bool Simulator::has_applicable_transition() const {
@@ -143,10 +299,9 @@ bool Simulator::has_applicable_transition() const {
     return false;
   }
   
-  std::string current_state = current_config_.get_current_state();
   char current_symbol = current_config_.get_tape().read();
-  
-  return machine_->get_transition(current_state, current_symbol) != nullptr;
+  return machine_->find_transition(current_state_id_, &current_symbol) !=
+         CompiledMachine::NO_TRANSITION;
 }
 
 const Configuration& Simulator::get_current_configuration() const {
@@ -169,6 +324,37 @@ void Simulator::set_max_steps(size_t max_steps) {
   max_steps_ = max_steps;
 }
 
+void Simulator::set_deadline(std::chrono::steady_clock::time_point deadline) {
+  deadline_ = deadline;
+}
+
+void Simulator::set_cancellation_token(const CancellationToken* token) {
+  cancellation_ = token;
+}
+
+void Simulator::set_profiler(Profiler* profiler) {
+  profiler_ = profiler;
+}
+
+void Simulator::set_deciders(DeciderPipeline* deciders) {
+  deciders_ = deciders;
+}
+
+bool Simulator::set_tape_file(const std::string& path) {
+  std::string error;
+  if (!current_config_.get_tape().map_file(path, error)) {
+    last_error_ = error;
+    return false;
+  }
+  return true;
+}
+
+#ifdef TAPE_STATS
+void Simulator::set_tape_stats(TapeStats* stats) {
+  tape_stats_ = stats;
+}
+#endif
+
 std::string Simulator::get_last_error() const {
   return last_error_;
 }
@@ -183,11 +369,30 @@ std::string Simulator::result_to_string(SimulationResult result) {
       return "INFINITE";
     case SimulationResult::ERROR:
       return "ERROR";
+    case SimulationResult::TIMEOUT:
+      return "TIMEOUT";
     default:
       return "UNKNOWN";
   }
 }
 
+std::string Simulator::proof_to_string(InfiniteProof proof) {
+  switch (proof) {
+    case InfiniteProof::REPEATED_CONFIGURATION:
+      return "configuración repetida";
+    case InfiniteProof::TRANSLATED_CYCLE:
+      return "ciclo trasladado";
+    case InfiniteProof::BACKWARD_REASONING:
+      return "razonamiento hacia atrás";
+    case InfiniteProof::CLOSED_TAPE_LANGUAGE:
+      return "lenguaje de cinta cerrado";
+    case InfiniteProof::BOUNCER:
+      return "rebote";
+    default:
+      return "límite de pasos";
+  }
+}
+
 void Simulator::print_trace(bool show_tape_details) const {
   std::cout << "=== Traza de Ejecución ===\n";
   for (size_t i = 0; i < trace_.size(); ++i) {
@@ -203,7 +408,15 @@ void Simulator::print_current_configuration(bool show_tape_details) const {
 }
 
 bool Simulator::is_infinite_loop_detected() const {
-  return is_configuration_visited();
+  return infinite_proof_ != InfiniteProof::NONE;
+}
+
+InfiniteProof Simulator::get_infinite_proof() const {
+  return infinite_proof_;
+}
+
+const std::string& Simulator::get_infinite_certificate() const {
+  return infinite_certificate_;
 }
 
 void Simulator::add_to_trace() {
@@ -218,7 +431,11 @@ std::string Simulator::get_configuration_key() const {
 
 bool Simulator::is_configuration_visited() const {
   std::string key = get_configuration_key();
-  return visited_configurations_.find(key) != visited_configurations_.end();
+  if (visited_configurations_.find(key) != visited_configurations_.end()) {
+    return true;
+  }
+  return !restored_visited_.empty() &&
+         restored_visited_.find(ResultCache::hash_bytes(key)) != restored_visited_.end();
 }
 
 void Simulator::mark_configuration_as_visited() {
@@ -229,44 +446,73 @@ void Simulator::mark_configuration_as_visited() {
 // ===== IMPLEMENTACIÓN DE MULTISIMULATOR =====
 
 MultiSimulator::MultiSimulator(const MultiTuringMachine* machine)
-    : machine_(machine), current_config_("", 1, "", '.'), 
-      trace_enabled_(false), max_steps_(1000), last_error_("") {
-  if (machine_ == nullptr) {
+    : machine_(nullptr), current_config_("", 1, "", '.'), current_state_id_(0),
+      trace_enabled_(false), max_steps_(1000), last_error_(""), profiler_(nullptr),
+      deadline_(std::chrono::steady_clock::time_point::max()), cancellation_(nullptr),
+      infinite_proof_(InfiniteProof::NONE) {
+  if (machine == nullptr) {
     last_error_ = "La máquina de Turing multicinta no puede ser nullptr";
-  } else {
-    // Inicializar configuración con el número correcto de cintas
-    current_config_ = MultiConfiguration(
-      machine_->get_initial_state(),
-      machine_->get_num_tapes(),
-      "",
-      machine_->get_blank_symbol()
-    );
+    return;
+  }
+  owned_machine_ = std::make_unique<CompiledMachine>();
+  if (!owned_machine_->compile(*machine)) {
+    last_error_ = owned_machine_->get_last_error();
+    return;
   }
+  machine_ = owned_machine_.get();
+  reset();
+}
+
+MultiSimulator::MultiSimulator(const CompiledMachine* machine)
+    : machine_(machine), current_config_("", 1, "", '.'), current_state_id_(0),
+      trace_enabled_(false), max_steps_(1000), last_error_(""), profiler_(nullptr),
+      deadline_(std::chrono::steady_clock::time_point::max()), cancellation_(nullptr),
+      infinite_proof_(InfiniteProof::NONE) {
+  if (machine_ == nullptr || !machine_->is_loaded()) {
+    last_error_ = "La máquina de Turing multicinta no puede ser nullptr";
+    machine_ = nullptr;
+    return;
+  }
+  reset();
 }
 
 MultiSimulator::~MultiSimulator() {
   // Destructor por defecto
 }
 
-SimulationResult MultiSimulator::simulate(const std::string& input_word, 
+SimulationResult MultiSimulator::simulate(std::string_view input_word, 
                                          bool enable_trace, 
                                          size_t max_steps) {
-  // Verificar que la máquina sea válida
-  if (machine_ == nullptr) {
-    last_error_ = "No hay máquina de Turing multicinta asignada";
-    return SimulationResult::ERROR;
-  }
-  
-  if (!machine_->is_valid()) {
-    last_error_ = "La máquina de Turing multicinta no es válida";
+  if (!start(input_word, enable_trace, max_steps)) {
     return SimulationResult::ERROR;
   }
-  
+  return *run();
+}
+
+bool MultiSimulator::start(std::string_view input_word, bool enable_trace, size_t max_steps) {
   // Verificar que la palabra de entrada sea válida
-  if (!machine_->is_valid_input_word(input_word)) {
+  if (machine_ != nullptr && !machine_->is_valid_input_word(input_word)) {
     last_error_ = "La palabra de entrada contiene símbolos no válidos";
+    return false;
+  }
+  return start_validated(input_word, enable_trace, max_steps);
+}
+
+SimulationResult MultiSimulator::simulate_validated(std::string_view input_word, bool enable_trace, size_t max_steps) {
+  if (!start_validated(input_word, enable_trace, max_steps)) {
     return SimulationResult::ERROR;
   }
+  return *run();
+}
+
+bool MultiSimulator::start_validated(std::string_view input_word, bool enable_trace, size_t max_steps) {
+  // Verificar que la máquina sea válida (se validó al compilarla)
+  if (machine_ == nullptr) {
+    if (last_error_.empty()) {
+      last_error_ = "No hay máquina de Turing multicinta asignada";
+    }
+    return false;
+  }
   
   // Configurar la simulación
   trace_enabled_ = enable_trace;
@@ -278,32 +524,47 @@ SimulationResult MultiSimulator::simulate(const std::string& input_word,
   // Añadir configuración inicial a la traza
   add_to_trace();
   mark_configuration_as_visited();
-  
-  // Bucle principal de simulación
+  return true;
+}
+
+std::optional<SimulationResult> MultiSimulator::run(size_t step_budget) {
+  if (machine_ == nullptr) {
+    return SimulationResult::ERROR;
+  }
+
+  // Bucle principal de simulación; cada vuelta da como mucho un paso, así que
+  // pararse al principio de una vuelta y seguir en otra llamada es equivalente
+  size_t first_step = current_config_.get_step_count();
   while (true) {
+    if (step_budget > 0 && current_config_.get_step_count() - first_step >= step_budget) {
+      return std::nullopt;
+    }
+
     // Verificar límite de pasos
     if (max_steps_ > 0 && current_config_.get_step_count() >= max_steps_) {
       return SimulationResult::INFINITE;
     }
+
+    // Plazo de reloj y cancelación, solo cada INTERRUPT_CHECK_INTERVAL pasos
+    if ((current_config_.get_step_count() & (Simulator::INTERRUPT_CHECK_INTERVAL - 1)) == 0 &&
+        is_interrupted()) {
+      return SimulationResult::TIMEOUT;
+    }
     
     // Verificar si estamos en un estado de aceptación
     if (is_accepting_state()) {
       return SimulationResult::ACCEPTED;
     }
     
-    // Verificar si hay transición aplicable
-    if (!has_applicable_transition()) {
-      return SimulationResult::REJECTED;
-    }
-    
-    // Ejecutar un paso
+    // Ejecutar un paso; sin transición aplicable la palabra se rechaza (la
+    // máquina ya se comprobó antes del bucle, así que step() solo falla por eso)
     if (!step()) {
-      last_error_ = "Error al ejecutar paso de simulación multicinta";
-      return SimulationResult::ERROR;
+      return SimulationResult::REJECTED;
     }
     
     // Verificar bucle infinito por configuraciones repetidas
     if (is_configuration_visited()) {
+      infinite_proof_ = InfiniteProof::REPEATED_CONFIGURATION;
       return SimulationResult::INFINITE;
     }
     
@@ -318,35 +579,37 @@ bool MultiSimulator::step() {
     return false;
   }
   
-  // Obtener símbolos actuales de todas las cintas
-  std::vector<char> current_symbols;
-  size_t num_tapes = current_config_.get_tapes().get_num_tapes();
-  
-  for (size_t i = 0; i < num_tapes; ++i) {
-    current_symbols.push_back(current_config_.get_tapes().read(i));
+  // Obtener transición aplicable según los símbolos de todas las cintas
+  read_current_symbols();
+  uint32_t transition = machine_->find_transition(current_state_id_, current_symbols_.data());
+  if (transition == CompiledMachine::NO_TRANSITION) {
+    return false;
   }
   
-  // Obtener transición aplicable
-  std::string current_state = current_config_.get_current_state();
-  const MultiTransition* transition = machine_->get_transition(current_state, current_symbols);
-  
-  if (transition == nullptr) {
-    return false;
+  size_t num_tapes = current_symbols_.size();
+  if (profiler_ != nullptr) {
+    profiler_->record_step(current_state_id_, transition);
+    for (size_t i = 0; i < num_tapes; ++i) {
+      profiler_->record_cell(i, current_config_.get_tapes().get_tape(i).get_head_position(),
+                             machine_->get_movement(transition, i));
+    }
   }
   
   // Aplicar la transición
   // 1. Escribir los nuevos símbolos en todas las cintas
+  const char* write_symbols = machine_->get_write_symbols(transition);
   for (size_t i = 0; i < num_tapes; ++i) {
-    current_config_.get_tapes().write(i, transition->get_write_symbols()[i]);
+    current_config_.get_tapes().write(i, write_symbols[i]);
   }
   
   // 2. Mover todos los cabezales
   for (size_t i = 0; i < num_tapes; ++i) {
-    current_config_.get_tapes().move(i, transition->get_movements()[i]);
+    current_config_.get_tapes().move(i, machine_->get_movement(transition, i));
   }
   
   // 3. Cambiar al nuevo estado
-  current_config_.set_current_state(transition->get_to_state());
+  current_state_id_ = machine_->get_to_state(transition);
+  current_config_.set_current_state(machine_->get_state_name(current_state_id_));
   
   // 4. Incrementar contador de pasos
   current_config_.increment_step_count();
@@ -354,7 +617,15 @@ bool MultiSimulator::step() {
   return true;
 }
 
-void MultiSimulator::reset(const std::string& input_word) {
+void MultiSimulator::read_current_symbols() const {
+  size_t num_tapes = current_config_.get_tapes().get_num_tapes();
+  current_symbols_.resize(num_tapes);
+  for (size_t i = 0; i < num_tapes; ++i) {
+    current_symbols_[i] = current_config_.get_tapes().read(i);
+  }
+}
+
+void MultiSimulator::reset(std::string_view input_word) {
   if (machine_ == nullptr) {
     return;
   }
@@ -362,19 +633,95 @@ void MultiSimulator::reset(const std::string& input_word) {
   // Limpiar datos de simulación anterior
   trace_.clear();
   visited_configurations_.clear();
+  restored_visited_.clear();
+  infinite_proof_ = InfiniteProof::NONE;
   last_error_.clear();
   
   // Crear nueva configuración inicial
+  current_state_id_ = machine_->get_initial_state();
   current_config_ = MultiConfiguration(
-    machine_->get_initial_state(),
+    std::string(machine_->get_state_name(current_state_id_)),
     machine_->get_num_tapes(),
     input_word,
     machine_->get_blank_symbol()
   );
+  const SymbolSet& alphabet = machine_->get_tape_alphabet();
+  std::string symbols(alphabet.begin(), alphabet.end());
+  for (size_t i = 0; i < machine_->get_num_tapes(); ++i) {
+    current_config_.get_tapes().get_tape(i).set_alphabet(symbols);
+  }
+  if (profiler_ != nullptr) {
+    profiler_->begin_run(current_state_id_);
+  }
+#ifdef TAPE_STATS
+  // La configuración es nueva: sus cintas se enlazan de nuevo
+  if (tape_stats_ != nullptr) {
+    for (size_t i = 0; i < machine_->get_num_tapes(); ++i) {
+      current_config_.get_tapes().get_tape(i).set_stats(&tape_stats_[i]);
+    }
+  }
+#endif
+}
+
+void MultiSimulator::save_checkpoint(Checkpoint& checkpoint) const {
+  const MultiTape& tapes = current_config_.get_tapes();
+  checkpoint.max_steps = max_steps_;
+  checkpoint.state = current_state_id_;
+  checkpoint.steps = current_config_.get_step_count();
+  checkpoint.tapes.clear();
+  for (size_t i = 0; i < tapes.get_num_tapes(); ++i) {
+    const Tape& tape = tapes.get_tape(i);
+    checkpoint.tapes.push_back(Checkpoint::TapeImage{tape.get_head_position(), tape.get_content_start(),
+                                                     tape.get_content()});
+  }
+  checkpoint.visited.assign(restored_visited_.begin(), restored_visited_.end());
+  for (const std::string& key : visited_configurations_) {
+    checkpoint.visited.push_back(ResultCache::hash_bytes(key));
+  }
+}
+
+bool MultiSimulator::restore_checkpoint(const Checkpoint& checkpoint) {
+  if (machine_ == nullptr) {
+    if (last_error_.empty()) {
+      last_error_ = "No hay máquina de Turing multicinta asignada";
+    }
+    return false;
+  }
+  if (checkpoint.state >= machine_->get_num_states() ||
+      checkpoint.tapes.size() != machine_->get_num_tapes()) {
+    last_error_ = "El punto de control no corresponde a esta máquina";
+    return false;
+  }
+
+  reset();
+  trace_enabled_ = false;
+  max_steps_ = checkpoint.max_steps;
+  current_state_id_ = checkpoint.state;
+  current_config_.set_current_state(machine_->get_state_name(current_state_id_));
+  for (size_t i = 0; i < checkpoint.tapes.size(); ++i) {
+    const Checkpoint::TapeImage& image = checkpoint.tapes[i];
+    current_config_.get_tapes().get_tape(i).load(static_cast<int>(image.start), image.content,
+                                                 static_cast<int>(image.head));
+  }
+  current_config_.set_step_count(checkpoint.steps);
+  restored_visited_.insert(checkpoint.visited.begin(), checkpoint.visited.end());
+  return true;
+}
+
+bool MultiSimulator::set_configuration(const MultiConfiguration& config) {
+  uint32_t state = machine_ != nullptr ? machine_->find_state(config.get_current_state())
+                                       : CompiledMachine::NO_TRANSITION;
+  if (state == CompiledMachine::NO_TRANSITION) {
+    last_error_ = "La configuración no corresponde a esta máquina";
+    return false;
+  }
+  current_config_ = config;
+  current_state_id_ = state;
+  return true;
 }
 
 bool MultiSimulator::is_accepting_state() const {
-  return machine_->is_accept_state(current_config_.get_current_state());
+  return machine_ != nullptr && machine_->is_accept_state(current_state_id_);
 }
 
 bool MultiSimulator::has_applicable_transition() const {
@@ -382,15 +729,9 @@ bool MultiSimulator::has_applicable_transition() const {
     return false;
   }
   
-  // Obtener símbolos actuales de todas las cintas
-  std::vector<char> current_symbols;
-  size_t num_tapes = current_config_.get_tapes().get_num_tapes();
-  
-  for (size_t i = 0; i < num_tapes; ++i) {
-    current_symbols.push_back(current_config_.get_tapes().read(i));
-  }
-  
-  return machine_->get_transition(current_config_.get_current_state(), current_symbols) != nullptr;
+  read_current_symbols();
+  return machine_->find_transition(current_state_id_, current_symbols_.data()) !=
+         CompiledMachine::NO_TRANSITION;
 }
 
 const MultiConfiguration& MultiSimulator::get_current_configuration() const {
@@ -413,6 +754,38 @@ void MultiSimulator::set_max_steps(size_t max_steps) {
   max_steps_ = max_steps;
 }
 
+void MultiSimulator::set_deadline(std::chrono::steady_clock::time_point deadline) {
+  deadline_ = deadline;
+}
+
+void MultiSimulator::set_cancellation_token(const CancellationToken* token) {
+  cancellation_ = token;
+}
+
+void MultiSimulator::set_profiler(Profiler* profiler) {
+  profiler_ = profiler;
+}
+
+bool MultiSimulator::set_tape_file(const std::string& path) {
+  // Las cintas de la configuración actual se conservan al reiniciar (la
+  // asignación mantiene el respaldo de cada cinta)
+  MultiTape& tapes = current_config_.get_tapes();
+  for (size_t i = 0; i < tapes.get_num_tapes(); ++i) {
+    std::string error;
+    if (!tapes.get_tape(i).map_file(path + "." + std::to_string(i + 1), error)) {
+      last_error_ = error;
+      return false;
+    }
+  }
+  return true;
+}
+
+#ifdef TAPE_STATS
+void MultiSimulator::set_tape_stats(TapeStats* stats) {
+  tape_stats_ = stats;
+}
+#endif
+
 std::string MultiSimulator::get_last_error() const {
   return last_error_;
 }
@@ -435,7 +808,11 @@ void MultiSimulator::print_current_configuration(bool show_tape_details) const {
 }
 
 bool MultiSimulator::is_infinite_loop_detected() const {
-  return is_configuration_visited();
+  return infinite_proof_ != InfiniteProof::NONE;
+}
+
+InfiniteProof MultiSimulator::get_infinite_proof() const {
+  return infinite_proof_;
 }
 
 void MultiSimulator::add_to_trace() {
@@ -450,7 +827,11 @@ std::string MultiSimulator::get_configuration_key() const {
 
 bool MultiSimulator::is_configuration_visited() const {
   std::string key = get_configuration_key();
-  return visited_configurations_.find(key) != visited_configurations_.end();
+  if (visited_configurations_.find(key) != visited_configurations_.end()) {
+    return true;
+  }
+  return !restored_visited_.empty() &&
+         restored_visited_.find(ResultCache::hash_bytes(key)) != restored_visited_.end();
 }
 
 void MultiSimulator::mark_configuration_as_visited() {
@@ -1,11 +1,25 @@
 #pragma once
+#include <chrono>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_set>
+#include "CompiledMachine.hpp"
 #include "TuringMachine.hpp"
 #include "Configuration.hpp"
 #include "MultiTuringMachine.hpp"
 #include "MultiConfiguration.hpp"
+#include "CancellationToken.hpp"
+#include "TranslatedCycleDetector.hpp"
+#ifdef TAPE_STATS
+#include "TapeStats.hpp"
+#endif
+
+class Profiler;
+class DeciderPipeline;
+struct Checkpoint;
 
 /**
  * @brief Enumeración para los posibles resultados de la simulación
@@ -14,7 +28,20 @@ enum class SimulationResult {
   ACCEPTED,    // La palabra fue aceptada
   REJECTED,    // La palabra fue rechazada (estado no de aceptación)
   INFINITE,    // La simulación alcanzó el límite de pasos (posible bucle infinito)
-  ERROR        // Error durante la simulación
+  ERROR,       // Error durante la simulación
+  TIMEOUT      // Se agotó el plazo de tiempo o se canceló la simulación
+};
+
+/**
+ * @brief Prueba de que una simulación con resultado INFINITE no se detiene
+ */
+enum class InfiniteProof {
+  NONE,                    // Sin prueba: se alcanzó el límite de pasos
+  REPEATED_CONFIGURATION,  // Se repitió exactamente una configuración
+  TRANSLATED_CYCLE,        // El mismo estado y segmento se repiten desplazados con blancos por delante
+  BACKWARD_REASONING,      // Ninguna parada es alcanzable tras cierto paso (DeciderPipeline)
+  CLOSED_TAPE_LANGUAGE,    // Un lenguaje de cinta cerrado no contiene paradas (DeciderPipeline)
+  BOUNCER                  // La cinta crece en un bloque repetido en cada pasada (DeciderPipeline)
 };
 
 /**
@@ -23,27 +50,62 @@ enum class SimulationResult {
  * El simulador ejecuta la máquina paso a paso y puede detectar:
  * - Aceptación (estado final de aceptación)
  * - Rechazo (estado final no de aceptación)
- * - Bucles infinitos (mediante límite de pasos o detección de configuraciones repetidas)
+ * - Bucles infinitos (mediante límite de pasos, detección de configuraciones
+ *   repetidas o de ciclos trasladados con TranslatedCycleDetector)
+ *
+ * Además del límite de pasos, la simulación puede detenerse por un plazo de
+ * reloj (set_deadline) o por un CancellationToken; ambos se consultan cada
+ * INTERRUPT_CHECK_INTERVAL pasos y dan SimulationResult::TIMEOUT.
+ *
+ * Internamente simula sobre la forma compilada de la máquina (CompiledMachine):
+ * estados como enteros y transiciones en una tabla indexada.
  */
 class Simulator {
+public:
+  static constexpr size_t INTERRUPT_CHECK_INTERVAL = 1024;  // Pasos entre consultas de plazo y cancelación (potencia de 2)
+
 private:
-  const TuringMachine* machine_;     // Máquina de Turing a simular
+  std::unique_ptr<CompiledMachine> owned_machine_;  // Compilada por el propio simulador
+  const CompiledMachine* machine_;   // Máquina compilada a simular
   Configuration current_config_;     // Configuración actual
+  uint32_t current_state_id_;        // Identificador del estado actual
   std::vector<Configuration> trace_; // Traza de ejecución (solo si está habilitada)
   bool trace_enabled_;               // Si la traza está habilitada
   size_t max_steps_;                 // Límite máximo de pasos (0 = sin límite)
   std::string last_error_;           // Último error ocurrido
+  Profiler* profiler_;               // Perfil de ejecución (nullptr = desactivado)
+  std::chrono::steady_clock::time_point deadline_;  // Plazo de reloj (max() = sin plazo)
+  const CancellationToken* cancellation_;           // Cancelación externa (nullptr = ninguna)
+#ifdef TAPE_STATS
+  TapeStats* tape_stats_ = nullptr;  // Estadísticas de la cinta (nullptr = desactivadas)
+#endif
   
   // Para detección de bucles infinitos
   std::unordered_set<std::string> visited_configurations_;
+  std::unordered_set<uint64_t> restored_visited_;  // Huellas de las visitadas antes de reanudar
+  TranslatedCycleDetector cycle_detector_;  // Ciclos trasladados
+  InfiniteProof infinite_proof_;            // Prueba del último INFINITE
+  std::string infinite_certificate_;        // Certificado del decisor que lo demostró
+  DeciderPipeline* deciders_;               // Decisores previos (nullptr = ninguno)
+  bool decided_;                            // Si los decisores ya resolvieron la palabra
 
 public:
   /**
    * @brief Constructor del simulador
+   *
+   * La máquina se compila al construir el simulador: los cambios posteriores
+   * en su definición no se reflejan en la simulación.
+   *
    * @param machine Puntero a la máquina de Turing a simular
    */
   explicit Simulator(const TuringMachine* machine);
 
+  /**
+   * @brief Constructor del simulador sobre una máquina ya compilada
+   * @param machine Máquina compilada monocinta (debe sobrevivir al simulador)
+   */
+  explicit Simulator(const CompiledMachine* machine);
+
   /**
    * @brief Destructor
    */
@@ -56,10 +118,59 @@ public:
    * @param max_steps Límite máximo de pasos (0 = sin límite)
    * @return Resultado de la simulación
    */
-  SimulationResult simulate(const std::string& input_word, 
+  SimulationResult simulate(std::string_view input_word, 
                            bool enable_trace = false, 
                            size_t max_steps = 1000);
 
+  /**
+   * @brief Prepara una simulación sin ejecutar ningún paso (simulate() es
+   *        start() seguido de run())
+   * @param input_word Palabra de entrada
+   * @param enable_trace Si habilitar la traza de ejecución
+   * @param max_steps Límite máximo de pasos (0 = sin límite)
+   * @return false si no se puede simular (ver get_last_error())
+   */
+  bool start(std::string_view input_word, bool enable_trace = false, size_t max_steps = 1000);
+
+  /**
+   * @brief start() y simulate() para una palabra que el llamante ya comprobó
+   *        contra el alfabeto de entrada: no la vuelven a recorrer
+   */
+  bool start_validated(std::string_view input_word, bool enable_trace, size_t max_steps);
+  SimulationResult simulate_validated(std::string_view input_word, bool enable_trace, size_t max_steps);
+
+  /**
+   * @brief Continúa la simulación preparada con start() o restore_checkpoint()
+   * @param step_budget Pasos como máximo en esta llamada (0 = hasta terminar)
+   * @return Resultado si la simulación terminó; vacío si se agotó step_budget
+   *         y puede continuarse con otra llamada
+   */
+  std::optional<SimulationResult> run(size_t step_budget = 0);
+
+  /**
+   * @brief Guarda en un punto de control el estado de la simulación en curso
+   *        (estado, pasos, límite, cintas y configuraciones visitadas)
+   * @param checkpoint Punto de control a completar (la palabra, su índice y
+   *                   la huella de la máquina los pone quien lo escribe)
+   */
+  void save_checkpoint(Checkpoint& checkpoint) const;
+
+  /**
+   * @brief Restaura una simulación desde un punto de control para seguirla
+   *        con run(); la traza queda deshabilitada
+   * @param checkpoint Punto de control de esta misma máquina
+   * @return false si no corresponde a la máquina (ver get_last_error())
+   */
+  bool restore_checkpoint(const Checkpoint& checkpoint);
+
+  /**
+   * @brief Sustituye la configuración actual (el depurador la usa para volver
+   *        a una configuración guardada)
+   * @param config Configuración de esta misma máquina
+   * @return false si su estado no existe en la máquina
+   */
+  bool set_configuration(const Configuration& config);
+
   /**
    * @brief Ejecuta un solo paso de la simulación
    * @return true si se pudo ejecutar el paso, false si no hay transición aplicable
@@ -70,7 +181,7 @@ public:
    * @brief Reinicia el simulador con una nueva palabra de entrada
    * @param input_word Nueva palabra de entrada
    */
-  void reset(const std::string& input_word = "");
+  void reset(std::string_view input_word = "");
 
   /**
    * @brief Verifica si la configuración actual es de aceptación
@@ -103,6 +214,11 @@ public:
    */
   size_t get_step_count() const;
 
+  /**
+   * @brief Obtiene el identificador del estado actual en la máquina compilada
+   */
+  uint32_t get_current_state_id() const { return current_state_id_; }
+
   /**
    * @brief Habilita o deshabilita la traza de ejecución
    * @param enable Si habilitar la traza
@@ -115,6 +231,52 @@ public:
    */
   void set_max_steps(size_t max_steps);
 
+  /**
+   * @brief Establece el plazo de reloj de las simulaciones siguientes
+   * @param deadline Instante a partir del cual simulate() devuelve TIMEOUT
+   *                 (time_point::max() para quitarlo)
+   */
+  void set_deadline(std::chrono::steady_clock::time_point deadline);
+
+  /**
+   * @brief Enlaza una petición de cancelación
+   * @param token Cancelación a consultar (nullptr para ninguna); debe
+   *              sobrevivir al simulador
+   */
+  void set_cancellation_token(const CancellationToken* token);
+
+  /**
+   * @brief Activa el perfil de ejecución (--profile)
+   * @param profiler Perfil donde acumular los pasos (nullptr para desactivarlo);
+   *                 debe ser de la misma máquina compilada y sobrevivir al simulador
+   */
+  void set_profiler(Profiler* profiler);
+
+  /**
+   * @brief Activa los decisores de no parada (--deciders): start() les pasa
+   *        cada palabra y, si alguno lo demuestra, run() da INFINITE sin simular
+   * @param deciders Cadena de decisores de la misma máquina (nullptr para
+   *                 desactivarlos); debe sobrevivir al simulador
+   */
+  void set_deciders(DeciderPipeline* deciders);
+
+  /**
+   * @brief Guarda la cinta en un fichero disperso proyectado en memoria
+   *        (--tape-backing file:ruta) para las simulaciones siguientes
+   * @param path Fichero a crear (se borra al destruir el simulador)
+   * @return false si no se pudo crear (ver get_last_error())
+   */
+  bool set_tape_file(const std::string& path);
+
+#ifdef TAPE_STATS
+  /**
+   * @brief Activa las estadísticas de la cinta (--tape-stats)
+   * @param stats Estadísticas donde acumular (nullptr para desactivarlas);
+   *              deben sobrevivir al simulador
+   */
+  void set_tape_stats(TapeStats* stats);
+#endif
+
   /**
    * @brief Obtiene el último error ocurrido
    * @return String con el mensaje de error
@@ -128,6 +290,13 @@ public:
    */
   static std::string result_to_string(SimulationResult result);
 
+  /**
+   * @brief Describe la prueba de un resultado INFINITE
+   * @param proof Prueba a describir
+   * @return Descripción para los mensajes de mt-sim
+   */
+  static std::string proof_to_string(InfiniteProof proof);
+
   /**
    * @brief Imprime la traza de ejecución
    * @param show_tape_details Si mostrar detalles de la cinta
@@ -141,12 +310,34 @@ public:
   void print_current_configuration(bool show_tape_details = true) const;
 
   /**
-   * @brief Verifica si se detectó un posible bucle infinito
-   * Esto ocurre cuando se visita una configuración que ya se había visitado antes
+   * @brief Indica si la simulación debe detenerse por plazo o cancelación
+   */
+  bool is_interrupted() const {
+    return (cancellation_ != nullptr && cancellation_->is_cancelled()) ||
+           (deadline_ != std::chrono::steady_clock::time_point::max() &&
+            std::chrono::steady_clock::now() >= deadline_);
+  }
+
+  /**
+   * @brief Verifica si se detectó un bucle infinito
+   * Esto ocurre cuando se visita una configuración que ya se había visitado
+   * antes o cuando se demuestra un ciclo trasladado
    * @return true si se detectó bucle infinito
    */
   bool is_infinite_loop_detected() const;
 
+  /**
+   * @brief Obtiene la prueba del último resultado INFINITE
+   * @return NONE si no lo hubo o si se debió al límite de pasos
+   */
+  InfiniteProof get_infinite_proof() const;
+
+  /**
+   * @brief Obtiene el certificado del decisor que demostró el último INFINITE
+   * @return Parámetros de la prueba (vacío si no vino de un decisor)
+   */
+  const std::string& get_infinite_certificate() const;
+
 private:
   /**
    * @brief Añade la configuración actual a la traza (si está habilitada)
@@ -180,23 +371,44 @@ private:
  */
 class MultiSimulator {
 private:
-  const MultiTuringMachine* machine_;     // Máquina de Turing multicinta a simular
+  std::unique_ptr<CompiledMachine> owned_machine_;  // Compilada por el propio simulador
+  const CompiledMachine* machine_;        // Máquina compilada a simular
   MultiConfiguration current_config_;     // Configuración actual
+  uint32_t current_state_id_;             // Identificador del estado actual
+  mutable std::vector<char> current_symbols_;  // Símbolos bajo los cabezales (buffer reutilizado)
   std::vector<MultiConfiguration> trace_; // Traza de ejecución (solo si está habilitada)
   bool trace_enabled_;                    // Si la traza está habilitada
   size_t max_steps_;                      // Límite máximo de pasos (0 = sin límite)
   std::string last_error_;                // Último error ocurrido
+  Profiler* profiler_;                    // Perfil de ejecución (nullptr = desactivado)
+  std::chrono::steady_clock::time_point deadline_;  // Plazo de reloj (max() = sin plazo)
+  const CancellationToken* cancellation_;           // Cancelación externa (nullptr = ninguna)
+#ifdef TAPE_STATS
+  TapeStats* tape_stats_ = nullptr;       // Estadísticas, una por cinta (nullptr = desactivadas)
+#endif
   
   // Para detección de bucles infinitos
   std::unordered_set<std::string> visited_configurations_;
+  std::unordered_set<uint64_t> restored_visited_;  // Huellas de las visitadas antes de reanudar
+  InfiniteProof infinite_proof_;          // Prueba del último INFINITE
 
 public:
   /**
    * @brief Constructor del simulador multicinta
+   *
+   * La máquina se compila al construir el simulador: los cambios posteriores
+   * en su definición no se reflejan en la simulación.
+   *
    * @param machine Puntero a la máquina de Turing multicinta a simular
    */
   explicit MultiSimulator(const MultiTuringMachine* machine);
 
+  /**
+   * @brief Constructor del simulador sobre una máquina ya compilada
+   * @param machine Máquina compilada (debe sobrevivir al simulador)
+   */
+  explicit MultiSimulator(const CompiledMachine* machine);
+
   /**
    * @brief Destructor
    */
@@ -209,21 +421,78 @@ public:
    * @param max_steps Límite máximo de pasos (0 = sin límite)
    * @return Resultado de la simulación
    */
-  SimulationResult simulate(const std::string& input_word, 
+  SimulationResult simulate(std::string_view input_word, 
                            bool enable_trace = false, 
                            size_t max_steps = 1000);
 
+  /**
+   * @brief Prepara una simulación sin ejecutar ningún paso (simulate() es
+   *        start() seguido de run())
+   * @param input_word Palabra de entrada
+   * @param enable_trace Si habilitar la traza de ejecución
+   * @param max_steps Límite máximo de pasos (0 = sin límite)
+   * @return false si no se puede simular (ver get_last_error())
+   */
+  bool start(std::string_view input_word, bool enable_trace = false, size_t max_steps = 1000);
+
+  /**
+   * @brief start() y simulate() para una palabra que el llamante ya comprobó
+   *        contra el alfabeto de entrada: no la vuelven a recorrer
+   */
+  bool start_validated(std::string_view input_word, bool enable_trace, size_t max_steps);
+  SimulationResult simulate_validated(std::string_view input_word, bool enable_trace, size_t max_steps);
+
+  /**
+   * @brief Continúa la simulación preparada con start() o restore_checkpoint()
+   * @param step_budget Pasos como máximo en esta llamada (0 = hasta terminar)
+   * @return Resultado si la simulación terminó; vacío si se agotó step_budget
+   *         y puede continuarse con otra llamada
+   */
+  std::optional<SimulationResult> run(size_t step_budget = 0);
+
+  /**
+   * @brief Guarda en un punto de control el estado de la simulación en curso
+   *        (estado, pasos, límite, cintas y configuraciones visitadas)
+   * @param checkpoint Punto de control a completar (la palabra, su índice y
+   *                   la huella de la máquina los pone quien lo escribe)
+   */
+  void save_checkpoint(Checkpoint& checkpoint) const;
+
+  /**
+   * @brief Restaura una simulación desde un punto de control para seguirla
+   *        con run(); la traza queda deshabilitada
+   * @param checkpoint Punto de control de esta misma máquina
+   * @return false si no corresponde a la máquina (ver get_last_error())
+   */
+  bool restore_checkpoint(const Checkpoint& checkpoint);
+
+  /**
+   * @brief Sustituye la configuración actual (el depurador la usa para volver
+   *        a una configuración guardada)
+   * @param config Configuración de esta misma máquina
+   * @return false si su estado no existe en la máquina
+   */
+  bool set_configuration(const MultiConfiguration& config);
+
   /**
    * @brief Ejecuta un solo paso de la simulación multicinta
    * @return true si se pudo ejecutar el paso, false si no hay transición aplicable
    */
   bool step();
 
+private:
+  /**
+   * @brief Lee en current_symbols_ los símbolos bajo todos los cabezales
+   */
+  void read_current_symbols() const;
+
+public:
+
   /**
    * @brief Reinicia el simulador con una nueva palabra de entrada
    * @param input_word Nueva palabra de entrada
    */
-  void reset(const std::string& input_word = "");
+  void reset(std::string_view input_word = "");
 
   /**
    * @brief Verifica si la configuración actual es de aceptación
@@ -256,6 +525,11 @@ public:
    */
   size_t get_step_count() const;
 
+  /**
+   * @brief Obtiene el identificador del estado actual en la máquina compilada
+   */
+  uint32_t get_current_state_id() const { return current_state_id_; }
+
   /**
    * @brief Habilita o deshabilita la traza de ejecución
    * @param enable Si habilitar la traza
@@ -268,6 +542,44 @@ public:
    */
   void set_max_steps(size_t max_steps);
 
+  /**
+   * @brief Establece el plazo de reloj de las simulaciones siguientes
+   * @param deadline Instante a partir del cual simulate() devuelve TIMEOUT
+   *                 (time_point::max() para quitarlo)
+   */
+  void set_deadline(std::chrono::steady_clock::time_point deadline);
+
+  /**
+   * @brief Enlaza una petición de cancelación
+   * @param token Cancelación a consultar (nullptr para ninguna); debe
+   *              sobrevivir al simulador
+   */
+  void set_cancellation_token(const CancellationToken* token);
+
+  /**
+   * @brief Activa el perfil de ejecución (--profile)
+   * @param profiler Perfil donde acumular los pasos (nullptr para desactivarlo);
+   *                 debe ser de la misma máquina compilada y sobrevivir al simulador
+   */
+  void set_profiler(Profiler* profiler);
+
+  /**
+   * @brief Guarda las cintas en ficheros dispersos proyectados en memoria
+   *        (--tape-backing file:ruta): ruta.1, ruta.2, ...
+   * @param path Prefijo de los ficheros (se borran al destruir el simulador)
+   * @return false si no se pudo crear alguno (ver get_last_error())
+   */
+  bool set_tape_file(const std::string& path);
+
+#ifdef TAPE_STATS
+  /**
+   * @brief Activa las estadísticas de las cintas (--tape-stats)
+   * @param stats Array con unas estadísticas por cinta (nullptr para
+   *              desactivarlas); debe sobrevivir al simulador
+   */
+  void set_tape_stats(TapeStats* stats);
+#endif
+
   /**
    * @brief Obtiene el último error ocurrido
    * @return String con el mensaje de error
@@ -287,11 +599,27 @@ public:
   void print_current_configuration(bool show_tape_details = true) const;
 
   /**
-   * @brief Verifica si se detectó un posible bucle infinito
+   * @brief Indica si la simulación debe detenerse por plazo o cancelación
+   */
+  bool is_interrupted() const {
+    return (cancellation_ != nullptr && cancellation_->is_cancelled()) ||
+           (deadline_ != std::chrono::steady_clock::time_point::max() &&
+            std::chrono::steady_clock::now() >= deadline_);
+  }
+
+  /**
+   * @brief Verifica si se detectó un bucle infinito (configuración repetida)
    * @return true si se detectó bucle infinito
    */
   bool is_infinite_loop_detected() const;
 
+  /**
+   * @brief Obtiene la prueba del último resultado INFINITE (multicinta solo
+   *        detecta configuraciones repetidas)
+   * @return NONE si no lo hubo o si se debió al límite de pasos
+   */
+  InfiniteProof get_infinite_proof() const;
+
 private:
   /**
    * @brief Añade la configuración actual a la traza (si está habilitada)
@@ -0,0 +1,37 @@
+#include "SimulatorHandle.hpp"
+#include <vector>
+
+bool SimulatorHandle::start(std::string_view word, bool enable_trace, size_t max_steps) {
+  return simulator_ != nullptr ? simulator_->start(word, enable_trace, max_steps)
+                               : multi_simulator_->start(word, enable_trace, max_steps);
+}
+
+std::optional<SimulationResult> SimulatorHandle::run(size_t step_budget) {
+  return simulator_ != nullptr ? simulator_->run(step_budget) : multi_simulator_->run(step_budget);
+}
+
+bool SimulatorHandle::step() {
+  return simulator_ != nullptr ? simulator_->step() : multi_simulator_->step();
+}
+
+size_t SimulatorHandle::num_tapes() const {
+  return simulator_ != nullptr ? 1 : multi_simulator_->get_current_configuration().get_tapes().get_num_tapes();
+}
+
+const Tape& SimulatorHandle::tape(size_t index) const {
+  return simulator_ != nullptr ? simulator_->get_current_configuration().get_tape()
+                               : multi_simulator_->get_current_configuration().get_tapes().get_tape(index);
+}
+
+std::string SimulatorHandle::symbols() const {
+  if (multi_simulator_ != nullptr) {
+    std::vector<char> symbols = multi_simulator_->get_current_configuration().get_tapes().read_all();
+    return std::string(symbols.begin(), symbols.end());
+  }
+  return std::string(1, simulator_->get_current_configuration().get_tape().read());
+}
+
+std::string SimulatorHandle::to_string() const {
+  return simulator_ != nullptr ? simulator_->get_current_configuration().to_string(true)
+                               : multi_simulator_->get_current_configuration().to_string(true);
+}
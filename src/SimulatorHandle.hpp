@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "Simulator.hpp"
+
+/**
+ * @brief Acceso uniforme a un Simulator o a un MultiSimulator
+ *
+ * Los consumidores que sirven para los dos simuladores (SimulationGenerator,
+ * Debugger) guardan un SimulatorHandle en lugar de los dos punteros y de una
+ * copia propia de cada despacho. El simulador no es propiedad del handle y
+ * debe sobrevivirle.
+ */
+class SimulatorHandle {
+private:
+  Simulator* simulator_;             // Simulador monocinta (o nullptr)
+  MultiSimulator* multi_simulator_;  // Simulador multicinta (o nullptr)
+
+public:
+  /**
+   * @brief Constructor sobre uno de los dos simuladores (el otro, nullptr)
+   */
+  SimulatorHandle(Simulator* simulator, MultiSimulator* multi_simulator)
+      : simulator_(multi_simulator != nullptr ? nullptr : simulator), multi_simulator_(multi_simulator) {}
+
+  explicit SimulatorHandle(Simulator* simulator) : SimulatorHandle(simulator, nullptr) {}
+  explicit SimulatorHandle(MultiSimulator* simulator) : SimulatorHandle(nullptr, simulator) {}
+
+  /**
+   * @brief Empieza a simular una palabra (ver Simulator::start())
+   */
+  bool start(std::string_view word, bool enable_trace, size_t max_steps);
+
+  /**
+   * @brief Ejecuta hasta step_budget pasos (ver Simulator::run())
+   */
+  std::optional<SimulationResult> run(size_t step_budget);
+
+  /**
+   * @brief Da un paso sin detección de bucles ni límite (ver Simulator::step())
+   */
+  bool step();
+
+  /**
+   * @brief Número de cintas (1 en monocinta)
+   */
+  size_t num_tapes() const;
+
+  /**
+   * @brief Cinta index (en monocinta, la única)
+   */
+  const Tape& tape(size_t index) const;
+
+  /**
+   * @brief Símbolos bajo los cabezales, uno por cinta
+   */
+  std::string symbols() const;
+
+  /**
+   * @brief Configuración actual en texto (con la cinta)
+   */
+  std::string to_string() const;
+
+  size_t step_count() const {
+    return simulator_ != nullptr ? simulator_->get_step_count() : multi_simulator_->get_step_count();
+  }
+  uint32_t state_id() const {
+    return simulator_ != nullptr ? simulator_->get_current_state_id() : multi_simulator_->get_current_state_id();
+  }
+  const std::string& state() const {
+    return simulator_ != nullptr ? simulator_->get_current_configuration().get_current_state()
+                                 : multi_simulator_->get_current_configuration().get_current_state();
+  }
+  bool is_accepting() const {
+    return simulator_ != nullptr ? simulator_->is_accepting_state() : multi_simulator_->is_accepting_state();
+  }
+  std::string get_last_error() const {
+    return simulator_ != nullptr ? simulator_->get_last_error() : multi_simulator_->get_last_error();
+  }
+  bool is_multi_tape() const { return multi_simulator_ != nullptr; }
+  Simulator* get_simulator() const { return simulator_; }
+  MultiSimulator* get_multi_simulator() const { return multi_simulator_; }
+};
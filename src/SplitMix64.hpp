@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Generador pseudoaleatorio SplitMix64
+ *
+ * Rápido, de 64 bits y con la misma secuencia en cualquier plataforma y
+ * compilador (las distribuciones de <random> no lo garantizan), así que lo
+ * generado a partir de una semilla es reproducible.
+ */
+class SplitMix64 {
+private:
+  uint64_t state_;  // Estado interno
+
+public:
+  /**
+   * @brief Constructor
+   * @param seed Semilla
+   */
+  explicit SplitMix64(uint64_t seed) : state_(seed) {}
+
+  /**
+   * @brief Siguiente número de 64 bits
+   */
+  uint64_t next() {
+    uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  /**
+   * @brief Entero en [0, n) (n > 0)
+   */
+  size_t below(size_t n) { return static_cast<size_t>(next() % n); }
+
+  /**
+   * @brief Real en [0, 1)
+   */
+  double unit() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+};
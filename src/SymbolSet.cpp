@@ -0,0 +1,182 @@
+#include "SymbolSet.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SYMBOLSET_HAS_SSSE3_PATH 1
+#endif
+
+namespace {
+
+#ifdef SYMBOLSET_HAS_SSSE3_PATH
+/**
+ * @brief Busca el primer byte ajeno al conjunto procesando bloques de 16 bytes
+ *
+ * Para cada byte b se consulta la fila de su nibble bajo en la tabla que
+ * corresponde a su nibble alto (0..7 o 8..15) y se comprueba el bit (b >> 4) & 7.
+ * @param processed Salida: número de bytes recorridos en bloques completos
+ * @return Posición del primer byte ajeno, o SymbolSet::npos si todos pertenecen
+ */
+__attribute__((target("ssse3")))
+size_t scan_blocks_ssse3(const unsigned char* data, size_t length,
+                         const uint8_t* low_table, const uint8_t* high_table,
+                         size_t& processed) {
+  const __m128i rows_low = _mm_load_si128(reinterpret_cast<const __m128i*>(low_table));
+  const __m128i rows_high = _mm_load_si128(reinterpret_cast<const __m128i*>(high_table));
+  const __m128i bit_for_nibble = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128,
+                                               1, 2, 4, 8, 16, 32, 64, -128);
+  const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+  const __m128i seven = _mm_set1_epi8(7);
+  const __m128i zero = _mm_setzero_si128();
+
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    __m128i lo = _mm_and_si128(bytes, nibble_mask);
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble_mask);
+
+    __m128i row_low = _mm_shuffle_epi8(rows_low, lo);
+    __m128i row_high = _mm_shuffle_epi8(rows_high, lo);
+    __m128i use_high = _mm_cmpgt_epi8(hi, seven);
+    __m128i row = _mm_or_si128(_mm_and_si128(use_high, row_high),
+                               _mm_andnot_si128(use_high, row_low));
+
+    __m128i bit = _mm_shuffle_epi8(bit_for_nibble, hi);
+    __m128i missing = _mm_cmpeq_epi8(_mm_and_si128(row, bit), zero);
+    int mask = _mm_movemask_epi8(missing);
+    if (mask != 0) {
+      processed = i;
+      return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+    }
+  }
+  processed = i;
+  return SymbolSet::npos;
+}
+
+bool cpu_has_ssse3() {
+  static const bool supported = __builtin_cpu_supports("ssse3");
+  return supported;
+}
+#endif
+
+}  // namespace
+
+SymbolSet::const_iterator::const_iterator(const SymbolSet* set, int index)
+    : set_(set), index_(index) {
+  while (index_ < 256 && !set_->contains(static_cast<char>(index_))) {
+    ++index_;
+  }
+}
+
+char SymbolSet::const_iterator::operator*() const {
+  return static_cast<char>(index_);
+}
+
+SymbolSet::const_iterator& SymbolSet::const_iterator::operator++() {
+  ++index_;
+  while (index_ < 256 && !set_->contains(static_cast<char>(index_))) {
+    ++index_;
+  }
+  return *this;
+}
+
+bool SymbolSet::const_iterator::operator==(const const_iterator& other) const {
+  return set_ == other.set_ && index_ == other.index_;
+}
+
+bool SymbolSet::const_iterator::operator!=(const const_iterator& other) const {
+  return !(*this == other);
+}
+
+SymbolSet::SymbolSet() : bits_{}, size_(0), nibble_low_{}, nibble_high_{} {
+}
+
+void SymbolSet::insert(char symbol) {
+  if (contains(symbol)) {
+    return;
+  }
+  unsigned char byte = static_cast<unsigned char>(symbol);
+  bits_[byte >> 6] |= uint64_t{1} << (byte & 63);
+  uint8_t bit = static_cast<uint8_t>(1u << ((byte >> 4) & 7));
+  if (byte < 0x80) {
+    nibble_low_[byte & 0x0F] |= bit;
+  } else {
+    nibble_high_[byte & 0x0F] |= bit;
+  }
+  size_++;
+}
+
+void SymbolSet::erase(char symbol) {
+  if (!contains(symbol)) {
+    return;
+  }
+  unsigned char byte = static_cast<unsigned char>(symbol);
+  bits_[byte >> 6] &= ~(uint64_t{1} << (byte & 63));
+  uint8_t bit = static_cast<uint8_t>(1u << ((byte >> 4) & 7));
+  if (byte < 0x80) {
+    nibble_low_[byte & 0x0F] &= static_cast<uint8_t>(~bit);
+  } else {
+    nibble_high_[byte & 0x0F] &= static_cast<uint8_t>(~bit);
+  }
+  size_--;
+}
+
+size_t SymbolSet::find_first_not_in(std::string_view word) const {
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(word.data());
+  size_t length = word.size();
+  size_t i = 0;
+
+#ifdef SYMBOLSET_HAS_SSSE3_PATH
+  if (length >= 16 && cpu_has_ssse3()) {
+    size_t bad = scan_blocks_ssse3(data, length, nibble_low_.data(),
+                                   nibble_high_.data(), i);
+    if (bad != npos) {
+      return bad;
+    }
+  }
+#endif
+
+  // Versión escalar: bloques de 8 sin saltos y búsqueda exacta solo si fallan
+  for (; i + 8 <= length; i += 8) {
+    uint64_t all = 1;
+    for (size_t j = 0; j < 8; ++j) {
+      unsigned char byte = data[i + j];
+      all &= bits_[byte >> 6] >> (byte & 63);
+    }
+    if (!(all & 1u)) {
+      break;
+    }
+  }
+  for (; i < length; ++i) {
+    if (!contains(static_cast<char>(data[i]))) {
+      return i;
+    }
+  }
+  return npos;
+}
+
+bool SymbolSet::contains_all(std::string_view word) const {
+  return find_first_not_in(word) == npos;
+}
+
+size_t SymbolSet::size() const {
+  return size_;
+}
+
+bool SymbolSet::empty() const {
+  return size_ == 0;
+}
+
+void SymbolSet::clear() {
+  bits_.fill(0);
+  nibble_low_.fill(0);
+  nibble_high_.fill(0);
+  size_ = 0;
+}
+
+SymbolSet::const_iterator SymbolSet::begin() const {
+  return const_iterator(this, 0);
+}
+
+SymbolSet::const_iterator SymbolSet::end() const {
+  return const_iterator(this, 256);
+}
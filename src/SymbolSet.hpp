@@ -0,0 +1,111 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+/**
+ * @brief Conjunto de símbolos representado como bitset de 256 bits
+ *
+ * Cada símbolo (un byte) ocupa un bit, de modo que la pertenencia se resuelve
+ * con un desplazamiento y una máscara. La validación de palabras completas
+ * recorre los bytes en bloques de 16 usando una búsqueda vectorial (SSSE3)
+ * cuando el procesador la soporta, con una versión escalar equivalente.
+ */
+class SymbolSet {
+private:
+  std::array<uint64_t, 4> bits_;  // Bit i activo si el byte i pertenece al conjunto
+  size_t size_;                   // Número de símbolos del conjunto
+
+  // Tablas por nibble bajo para la búsqueda vectorial: la entrada [lo] indica con
+  // el bit h si el byte (h << 4 | lo) pertenece al conjunto (h = 0..7 y h = 8..15)
+  alignas(16) std::array<uint8_t, 16> nibble_low_;
+  alignas(16) std::array<uint8_t, 16> nibble_high_;
+
+public:
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  /**
+   * @brief Iterador de solo lectura sobre los símbolos (en orden de byte)
+   */
+  class const_iterator {
+  private:
+    const SymbolSet* set_;  // Conjunto recorrido
+    int index_;             // Byte actual (256 = fin)
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = char;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const char*;
+    using reference = char;
+
+    const_iterator(const SymbolSet* set, int index);
+    char operator*() const;
+    const_iterator& operator++();
+    bool operator==(const const_iterator& other) const;
+    bool operator!=(const const_iterator& other) const;
+  };
+
+  /**
+   * @brief Constructor de un conjunto vacío
+   */
+  SymbolSet();
+
+  /**
+   * @brief Añade un símbolo al conjunto
+   * @param symbol Símbolo a añadir
+   */
+  void insert(char symbol);
+
+  /**
+   * @brief Elimina un símbolo del conjunto
+   * @param symbol Símbolo a eliminar
+   */
+  void erase(char symbol);
+
+  /**
+   * @brief Verifica si un símbolo pertenece al conjunto
+   * @param symbol Símbolo a verificar
+   * @return true si pertenece
+   */
+  bool contains(char symbol) const {
+    unsigned char byte = static_cast<unsigned char>(symbol);
+    return (bits_[byte >> 6] >> (byte & 63)) & 1u;
+  }
+
+  /**
+   * @brief Busca el primer símbolo de una palabra que no pertenece al conjunto
+   * @param word Palabra a recorrer
+   * @return Posición del primer símbolo ajeno, o npos si todos pertenecen
+   */
+  size_t find_first_not_in(std::string_view word) const;
+
+  /**
+   * @brief Verifica si todos los símbolos de una palabra pertenecen al conjunto
+   * @param word Palabra a verificar
+   * @return true si todos pertenecen
+   */
+  bool contains_all(std::string_view word) const;
+
+  /**
+   * @brief Obtiene el número de símbolos del conjunto
+   * @return Número de símbolos
+   */
+  size_t size() const;
+
+  /**
+   * @brief Verifica si el conjunto está vacío
+   * @return true si no contiene símbolos
+   */
+  bool empty() const;
+
+  /**
+   * @brief Vacía el conjunto
+   */
+  void clear();
+
+  const_iterator begin() const;
+  const_iterator end() const;
+};
@@ -1,46 +1,405 @@
 #include "Tape.hpp"
 #include <algorithm>
-#include <sstream>
+#include <cstring>
+
+namespace {
+
+// Primera celda no blanca de una página desde la celda from, sabiendo que
+// hay alguna y que las anteriores a from están en blanco; lee ocho bytes a la
+// vez (bits_log: log2 de los bits por celda)
+int first_non_blank(const uint8_t* cells, int bits_log, int from) {
+  int offset = from >> (3 - bits_log);
+  while (offset % sizeof(uint64_t) != 0 && cells[offset] == 0) {
+    ++offset;
+  }
+  uint64_t word;
+  while (cells[offset] == 0 && (std::memcpy(&word, cells + offset, sizeof(word)), word == 0)) {
+    offset += sizeof(word);
+  }
+  while (cells[offset] == 0) {
+    ++offset;
+  }
+  // Dentro del byte, la celda de menor posición ocupa los bits bajos
+  int bit = __builtin_ctz(cells[offset]);
+  return (offset << (3 - bits_log)) + (bit >> bits_log);
+}
+
+// Última celda no blanca de una página hasta la celda to, sabiendo que hay
+// alguna y que las posteriores a to están en blanco
+int last_non_blank(const uint8_t* cells, int bits_log, int to) {
+  int offset = to >> (3 - bits_log);
+  while ((offset + 1) % sizeof(uint64_t) != 0 && cells[offset] == 0) {
+    --offset;
+  }
+  uint64_t word;
+  while (cells[offset] == 0 &&
+         (std::memcpy(&word, cells + offset + 1 - sizeof(word), sizeof(word)), word == 0)) {
+    offset -= sizeof(word);
+  }
+  while (cells[offset] == 0) {
+    --offset;
+  }
+  int bit = 31 - __builtin_clz(cells[offset]);
+  return (offset << (3 - bits_log)) + (bit >> bits_log);
+}
+
+// Descodifica length celdas desde la celda offset de una página: las sueltas
+// de los extremos una a una y las de en medio byte a byte
+template <int BITS_LOG>
+void decode_cells(const uint8_t* cells, int offset, size_t length, const char* symbols, char* out) {
+  constexpr int PER_BYTE = 8 >> BITS_LOG;
+  constexpr unsigned MASK = (1u << (1 << BITS_LOG)) - 1;
+  auto decode_one = [&](int cell) {
+    return symbols[(cells[cell / PER_BYTE] >> ((cell % PER_BYTE) << BITS_LOG)) & MASK];
+  };
+  char* end = out + length;
+  for (; out < end && offset % PER_BYTE != 0; ++offset) {
+    *out++ = decode_one(offset);
+  }
+  const uint8_t* byte = cells + offset / PER_BYTE;
+  if constexpr (BITS_LOG == 0) {
+    // Un bit por celda: el byte se copia en los 8 bytes de una palabra, el
+    // byte i se queda con el bit i, y sumarle 0x7F lo lleva al bit alto (sin
+    // acarreo al siguiente); los símbolos 0 y 1 se eligen después con XOR
+    uint64_t zeros = 0x0101010101010101ULL * static_cast<uint8_t>(symbols[0]);
+    uint64_t flips = 0x0101010101010101ULL * (static_cast<uint8_t>(symbols[0] ^ symbols[1]));
+    for (; end - out >= 8; ++byte, out += 8) {
+      uint64_t bits = (*byte * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+      bits = ((bits + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
+      uint64_t word = zeros ^ (bits * 0xFF & flips);
+      std::memcpy(out, &word, sizeof(word));
+    }
+  } else {
+    for (; end - out >= PER_BYTE; ++byte) {
+      for (int i = 0; i < PER_BYTE; ++i) {
+        *out++ = symbols[(*byte >> (i << BITS_LOG)) & MASK];
+      }
+    }
+  }
+  offset = static_cast<int>(byte - cells) * PER_BYTE;
+  for (; out < end; ++offset) {
+    *out++ = decode_one(offset);
+  }
+}
+
+}  // namespace
 
 Tape::Tape(char blank_symbol) 
-    : head_position_(0), blank_symbol_(blank_symbol) {
+    : first_page_(0), non_blank_(0), content_start_(0), content_end_(-1), start_exact_(true),
+      end_exact_(true), cached_page_(NO_PAGE), cached_slot_(SIZE_MAX), head_position_(0),
+      blank_symbol_(blank_symbol) {
+  reset_codes();
 }
 
-Tape::Tape(const std::string& input_string, char blank_symbol) 
-    : head_position_(0), blank_symbol_(blank_symbol) {
+Tape::Tape(std::string_view input_string, char blank_symbol) 
+    : first_page_(0), non_blank_(0), content_start_(0), content_end_(-1), start_exact_(true),
+      end_exact_(true), cached_page_(NO_PAGE), cached_slot_(SIZE_MAX), head_position_(0),
+      blank_symbol_(blank_symbol) {
+  reset_codes();
   reset(input_string);
 }
 
+Tape::Tape(const Tape& other)
+    : first_page_(0), non_blank_(0), content_start_(0), content_end_(-1), start_exact_(true),
+      end_exact_(true), cached_page_(NO_PAGE), cached_slot_(SIZE_MAX),
+      head_position_(other.head_position_), blank_symbol_(other.blank_symbol_) {
+  copy_codes(other);
+  copy_pages(other);
+}
+
+Tape::Tape(Tape&& other) noexcept
+    : pages_(std::move(other.pages_)), page_counts_(std::move(other.page_counts_)),
+      page_bits_(std::move(other.page_bits_)),
+      first_page_(other.first_page_), non_blank_(other.non_blank_), content_start_(other.content_start_),
+      content_end_(other.content_end_), start_exact_(other.start_exact_), end_exact_(other.end_exact_),
+      cached_page_(NO_PAGE),
+      cached_slot_(SIZE_MAX), head_position_(other.head_position_), blank_symbol_(other.blank_symbol_),
+      file_(std::move(other.file_)), codes_(other.codes_), symbols_(other.symbols_), num_codes_(other.num_codes_) {
+  other.pages_.clear();
+  other.page_counts_.clear();
+  other.page_bits_.clear();
+  other.non_blank_ = 0;
+  other.cached_page_ = NO_PAGE;
+  set_bits_log(other.bits_log_);
+}
+
+Tape& Tape::operator=(const Tape& other) {
+  if (this != &other) {
+    clear();
+    head_position_ = other.head_position_;
+    blank_symbol_ = other.blank_symbol_;
+    copy_codes(other);
+    copy_pages(other);
+  }
+  return *this;
+}
+
+Tape& Tape::operator=(Tape&& other) noexcept {
+  if (file_ != nullptr || other.file_ != nullptr) {
+    // Las páginas de un fichero no pasan de una cinta a otra
+    return *this = static_cast<const Tape&>(other);
+  }
+  if (this != &other) {
+    clear();
+    pages_ = std::move(other.pages_);
+    page_counts_ = std::move(other.page_counts_);
+    page_bits_ = std::move(other.page_bits_);
+    first_page_ = other.first_page_;
+    non_blank_ = other.non_blank_;
+    content_start_ = other.content_start_;
+    content_end_ = other.content_end_;
+    start_exact_ = other.start_exact_;
+    end_exact_ = other.end_exact_;
+    head_position_ = other.head_position_;
+    blank_symbol_ = other.blank_symbol_;
+    copy_codes(other);
+    other.pages_.clear();
+    other.page_counts_.clear();
+    other.page_bits_.clear();
+    other.non_blank_ = 0;
+    other.cached_page_ = NO_PAGE;
+  }
+  return *this;
+}
+
 Tape::~Tape() {
-  // Destructor por defecto
+  if (file_ != nullptr) {
+    pages_.clear();  // El fichero se borra entero: no hace falta perforar cada página
+  }
+  clear();
+}
+
+void Tape::set_bits_log(int bits_log) {
+  bits_log_ = bits_log;
+  per_byte_log_ = 3 - bits_log;
+  page_shift_ = PAGE_BITS_SHIFT - bits_log;
+  offset_mask_ = (1 << page_shift_) - 1;
+  code_mask_ = static_cast<uint8_t>((1u << (1 << bits_log)) - 1);
+}
+
+void Tape::reset_codes() {
+  set_bits_log(0);
+  codes_.fill(NO_CODE);
+  codes_[static_cast<uint8_t>(blank_symbol_)] = 0;
+  symbols_.fill(blank_symbol_);
+  num_codes_ = 1;
+}
+
+void Tape::copy_codes(const Tape& other) {
+  set_bits_log(other.bits_log_);
+  codes_ = other.codes_;
+  symbols_ = other.symbols_;
+  num_codes_ = other.num_codes_;
+}
+
+int Tape::add_symbol(char symbol) {
+  int code = num_codes_++;
+  codes_[static_cast<uint8_t>(symbol)] = static_cast<int16_t>(code);
+  symbols_[code] = symbol;
+  if (code >= (1 << (1 << bits_log_))) {
+    widen();
+  }
+  return code;
+}
+
+void Tape::widen() {
+  // El contenido se descodifica antes de cambiar el ancho y se vuelve a
+  // escribir con el nuevo (todos sus símbolos ya tienen código)
+  int start = get_content_start();
+  std::string content = get_content();
+  clear();
+  set_bits_log(bits_log_ + 1);
+  for (size_t i = 0; i < content.length(); ++i) {
+    set_cell(start + static_cast<int>(i), content[i]);
+  }
+}
+
+void Tape::set_alphabet(std::string_view symbols) {
+  for (char symbol : symbols) {
+    if (codes_[static_cast<uint8_t>(symbol)] == NO_CODE) {
+      add_symbol(symbol);
+    }
+  }
+}
+
+uint8_t* Tape::acquire_page(int page) {
+  if (file_ != nullptr) {
+    return file_->page(static_cast<size_t>(page - min_page()));
+  }
+  return PagePool::local().acquire();
+}
+
+void Tape::release_page(int page, uint8_t* cells) {
+  if (file_ != nullptr) {
+    file_->release(static_cast<size_t>(page - min_page()));
+  } else {
+    PagePool::local().release(cells);
+  }
+}
+
+void Tape::clear() {
+  for (size_t slot = 0; slot < pages_.size(); ++slot) {
+    if (pages_[slot] != nullptr) {
+      release_page(first_page_ + static_cast<int>(slot), pages_[slot]);
+    }
+  }
+  pages_.clear();
+  page_counts_.clear();
+  page_bits_.clear();
+  first_page_ = 0;
+  non_blank_ = 0;
+  cached_page_ = NO_PAGE;
+}
+
+void Tape::copy_pages(const Tape& other) {
+  pages_.assign(other.pages_.size(), nullptr);
+  page_counts_ = other.page_counts_;
+  page_bits_ = other.page_bits_;
+  first_page_ = other.first_page_;
+  non_blank_ = other.non_blank_;
+  content_start_ = other.content_start_;
+  content_end_ = other.content_end_;
+  start_exact_ = other.start_exact_;
+  end_exact_ = other.end_exact_;
+  for (size_t i = 0; i < pages_.size(); ++i) {
+    if (other.pages_[i] != nullptr) {
+      pages_[i] = acquire_page(first_page_ + static_cast<int>(i));
+      std::memcpy(pages_[i], other.pages_[i], PagePool::PAGE_BYTES);
+    }
+  }
+}
+
+size_t Tape::reserve_slot(int page) {
+  if (pages_.empty()) {
+    first_page_ = page;
+    pages_.assign(1, nullptr);
+    page_counts_.assign(1, 0);
+    page_bits_.assign(1, 0);
+  } else if (page < first_page_) {
+    // Hacia la izquierda se reserva al menos tanto como ya hay, para que
+    // recorrer la cinta en ese sentido no desplace el directorio en cada página
+    size_t missing = static_cast<size_t>(static_cast<int64_t>(first_page_) - page);
+    size_t grow = std::max(missing, pages_.size());
+    grow = std::min<size_t>(grow, static_cast<size_t>(static_cast<int64_t>(first_page_) - min_page()));
+    pages_.insert(pages_.begin(), grow, nullptr);
+    page_counts_.insert(page_counts_.begin(), grow, 0);
+    first_page_ -= static_cast<int>(grow);
+    // Los bits se desplazan: se rehacen (el coste ya es el de desplazar el directorio)
+    page_bits_.assign((pages_.size() + 63) / 64, 0);
+    for (size_t slot = grow; slot < pages_.size(); ++slot) {
+      if (pages_[slot] != nullptr) {
+        set_page_bit(slot, true);
+      }
+    }
+  } else {
+    size_t slot = static_cast<size_t>(static_cast<int64_t>(page) - first_page_);
+    if (slot >= pages_.size()) {
+      pages_.resize(slot + 1, nullptr);
+      page_counts_.resize(slot + 1, 0);
+      page_bits_.resize((slot + 64) / 64, 0);
+    }
+  }
+  cached_page_ = NO_PAGE;
+  return static_cast<size_t>(static_cast<int64_t>(page) - first_page_);
+}
+
+void Tape::set_cell(int position, char symbol) {
+  int code = codes_[static_cast<uint8_t>(symbol)];
+  if (code == NO_CODE) {
+    code = add_symbol(symbol);  // Puede cambiar el ancho: antes de buscar la página
+  }
+  int page = position >> page_shift_;
+  size_t slot = find_slot(page);
+  if (slot == SIZE_MAX || pages_[slot] == nullptr) {
+    if (code == 0) {
+      return;  // Blanco sobre una página en blanco
+    }
+    if (slot == SIZE_MAX) {
+      slot = reserve_slot(page);
+    }
+    pages_[slot] = acquire_page(page);
+    set_page_bit(slot, true);
+  }
+
+  int offset = position & offset_mask_;
+  int shift = (offset & ((1 << per_byte_log_) - 1)) << bits_log_;
+  unsigned mask = static_cast<unsigned>(code_mask_) << shift;
+  uint8_t& cell = pages_[slot][offset >> per_byte_log_];
+  if (((cell & mask) == 0) != (code == 0)) {
+    if (code != 0) {
+      if (non_blank_ == 0) {
+        content_start_ = content_end_ = position;
+        start_exact_ = end_exact_ = true;
+      } else if (position < content_start_) {
+        content_start_ = position;
+        start_exact_ = true;
+      } else if (position > content_end_) {
+        content_end_ = position;
+        end_exact_ = true;
+      }
+      ++page_counts_[slot];
+      ++non_blank_;
+    } else {
+      // Un extremo borrado se busca en la siguiente consulta
+      start_exact_ = start_exact_ && position != content_start_;
+      end_exact_ = end_exact_ && position != content_end_;
+      --non_blank_;
+      if (--page_counts_[slot] == 0) {
+        // La página vuelve a estar en blanco: se devuelve
+        release_page(page, pages_[slot]);
+        pages_[slot] = nullptr;
+        set_page_bit(slot, false);
+        return;
+      }
+    }
+  }
+  cell = static_cast<uint8_t>((cell & ~mask) | (static_cast<unsigned>(code) << shift));
 }
 
 char Tape::read() const {
-  // Si la posición no existe en el mapa, devuelve el símbolo blanco
-  auto it = cells_.find(head_position_);
-  if (it != cells_.end()) {
-    return it->second;
+#ifdef TAPE_STATS
+  if (stats_.stats != nullptr) {
+    stats_.stats->record_read(head_position_);
   }
-  return blank_symbol_;
+#endif
+  return cell(head_position_);
+}
+
+char Tape::read_at(int position) const {
+  return cell(position);
 }
 
 void Tape::write(char symbol) {
-  if (symbol == blank_symbol_) {
-    // Si escribimos el símbolo blanco, eliminamos la entrada del mapa
-    // para ahorrar memoria
-    cells_.erase(head_position_);
-  } else {
-    // Escribimos el símbolo en la posición actual
-    cells_[head_position_] = symbol;
+#ifdef TAPE_STATS
+  if (stats_.stats != nullptr) {
+    stats_.stats->record_write(head_position_);
   }
+#endif
+  set_cell(head_position_, symbol);
 }
 
 void Tape::move_left() {
   head_position_--;
+  if (file_ != nullptr && (head_position_ & offset_mask_) == offset_mask_) {
+    file_->advise(static_cast<size_t>((head_position_ >> page_shift_) - min_page()), -1);
+  }
+#ifdef TAPE_STATS
+  if (stats_.stats != nullptr) {
+    stats_.stats->record_move(head_position_, -1);
+  }
+#endif
 }
 
 void Tape::move_right() {
   head_position_++;
+  if (file_ != nullptr && (head_position_ & offset_mask_) == 0) {
+    file_->advise(static_cast<size_t>((head_position_ >> page_shift_) - min_page()), 1);
+  }
+#ifdef TAPE_STATS
+  if (stats_.stats != nullptr) {
+    stats_.stats->record_move(head_position_, 1);
+  }
+#endif
 }
 
 int Tape::get_head_position() const {
@@ -55,82 +414,196 @@ char Tape::get_blank_symbol() const {
   return blank_symbol_;
 }
 
-void Tape::reset(const std::string& input_string) {
+void Tape::reset(std::string_view input_string) {
   // Limpiar la cinta
-  cells_.clear();
+  clear();
   head_position_ = 0;
   
   // Escribir la cadena de entrada en la cinta, empezando en la posición 0
   for (size_t i = 0; i < input_string.length(); ++i) {
-    if (input_string[i] != blank_symbol_) {
-      cells_[static_cast<int>(i)] = input_string[i];
-    }
+    set_cell(static_cast<int>(i), input_string[i]);
   }
 }
 
 std::string Tape::to_string(int window_size) const {
-  std::ostringstream oss;
-  
   // Determinar el rango de posiciones a mostrar
   int start = head_position_ - window_size;
   int end = head_position_ + window_size;
   
-  // Mostrar las celdas
+  std::string result;
+  result.reserve(3 * static_cast<size_t>(end - start + 1));
+  
+  // Mostrar las celdas (el cabezal se marca con corchetes)
   for (int pos = start; pos <= end; ++pos) {
-    if (pos == head_position_) {
-      oss << "[";  // Marcar la posición del cabezal
-    } else {
-      oss << " ";
-    }
-    
-    // Obtener el símbolo en la posición
-    auto it = cells_.find(pos);
-    if (it != cells_.end()) {
-      oss << it->second;
-    } else {
-      oss << blank_symbol_;
-    }
-    
-    if (pos == head_position_) {
-      oss << "]";
-    } else {
-      oss << " ";
-    }
+    bool is_head = (pos == head_position_);
+    result += is_head ? '[' : ' ';
+    result += cell(pos);
+    result += is_head ? ']' : ' ';
   }
   
-  return oss.str();
+  return result;
 }
 
-std::string Tape::get_content() const {
-  if (cells_.empty()) {
-    return "";
+void Tape::for_each_content_chunk(const std::function<void(std::string_view)>& visit) const {
+  if (non_blank_ == 0) {
+    return;
   }
   
-  // Encontrar las posiciones mínima y máxima con contenido
-  auto minmax = std::minmax_element(cells_.begin(), cells_.end(),
-    [](const auto& a, const auto& b) {
-      return a.first < b.first;
-    });
-  
-  int min_pos = minmax.first->first;
-  int max_pos = minmax.second->first;
+  int min_pos = get_content_start();
+  int max_pos = get_content_end();
   
-  std::string result;
-  result.reserve(max_pos - min_pos + 1);
-  
-  // Construir la cadena desde la posición mínima hasta la máxima
-  for (int pos = min_pos; pos <= max_pos; ++pos) {
-    auto it = cells_.find(pos);
-    if (it != cells_.end()) {
-      result += it->second;
+  // Un trozo por página, desde la posición mínima hasta la máxima
+  char chunk[PagePool::PAGE_BYTES * 8];
+  for (int pos = min_pos;;) {
+    int page = pos >> page_shift_;
+    int page_end = static_cast<int>(std::min<int64_t>(max_pos, (static_cast<int64_t>(page) + 1) * page_cells() - 1));
+    size_t length = static_cast<size_t>(page_end - pos) + 1;
+    const uint8_t* cells = pages_[static_cast<size_t>(static_cast<int64_t>(page) - first_page_)];
+    if (cells != nullptr) {
+      int offset = pos & offset_mask_;
+      switch (bits_log_) {
+        case 0: decode_cells<0>(cells, offset, length, symbols_.data(), chunk); break;
+        case 1: decode_cells<1>(cells, offset, length, symbols_.data(), chunk); break;
+        case 2: decode_cells<2>(cells, offset, length, symbols_.data(), chunk); break;
+        default: decode_cells<3>(cells, offset, length, symbols_.data(), chunk); break;
+      }
     } else {
-      result += blank_symbol_;
+      std::memset(chunk, static_cast<uint8_t>(blank_symbol_), length);
+    }
+    visit(std::string_view(chunk, length));
+    if (page_end == max_pos) {
+      break;
     }
+    pos = page_end + 1;
   }
-  
+}
+
+size_t Tape::get_content_size() const {
+  return non_blank_ == 0 ? 0 : static_cast<size_t>(get_content_end() - get_content_start()) + 1;
+}
+
+std::string Tape::get_content() const {
+  std::string result;
+  result.reserve(get_content_size());
+  for_each_content_chunk([&result](std::string_view chunk) { result += chunk; });
   return result;
 }
 
+size_t Tape::next_page_slot(size_t slot) const {
+  size_t word = slot / 64;
+  uint64_t bits = page_bits_[word] & (~uint64_t{0} << (slot % 64));
+  while (bits == 0) {
+    bits = page_bits_[++word];
+  }
+  return word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+}
+
+size_t Tape::prev_page_slot(size_t slot) const {
+  size_t word = slot / 64;
+  uint64_t bits = page_bits_[word] & (~uint64_t{0} >> (63 - slot % 64));
+  while (bits == 0) {
+    bits = page_bits_[--word];
+  }
+  return word * 64 + static_cast<size_t>(63 - __builtin_clzll(bits));
+}
+
+int Tape::get_content_start() const {
+  if (non_blank_ == 0) {
+    return 0;
+  }
+  if (!start_exact_) {
+    // Hacia la derecha desde la cota: las celdas anteriores están en blanco
+    int from_page = content_start_ >> page_shift_;
+    size_t slot = next_page_slot(static_cast<size_t>(static_cast<int64_t>(from_page) - first_page_));
+    int page = first_page_ + static_cast<int>(slot);
+    int from = page == from_page ? content_start_ & offset_mask_ : 0;
+    content_start_ = page * page_cells() + first_non_blank(pages_[slot], bits_log_, from);
+    start_exact_ = true;
+  }
+  return content_start_;
+}
+
+int Tape::get_content_end() const {
+  if (non_blank_ == 0) {
+    return -1;
+  }
+  if (!end_exact_) {
+    int to_page = content_end_ >> page_shift_;
+    size_t slot = prev_page_slot(static_cast<size_t>(static_cast<int64_t>(to_page) - first_page_));
+    int page = first_page_ + static_cast<int>(slot);
+    int to = page == to_page ? content_end_ & offset_mask_ : offset_mask_;
+    content_end_ = page * page_cells() + last_non_blank(pages_[slot], bits_log_, to);
+    end_exact_ = true;
+  }
+  return content_end_;
+}
+
+bool Tape::has_same_content(const Tape& other) const {
+  if (non_blank_ != other.non_blank_) {
+    return false;
+  }
+  if (non_blank_ == 0) {
+    return true;
+  }
+  // El mismo contenido desplazado es otra cinta
+  int start = get_content_start();
+  int end = get_content_end();
+  if (start != other.get_content_start() || end != other.get_content_end()) {
+    return false;
+  }
+  if (bits_log_ != other.bits_log_ || num_codes_ != other.num_codes_ ||
+      !std::equal(symbols_.begin(), symbols_.begin() + num_codes_, other.symbols_.begin())) {
+    return get_content() == other.get_content();
+  }
+  // Con los mismos códigos basta comparar las páginas: fuera del contenido
+  // están a cero y una página sin entrada en una cinta no la tiene en la otra
+  for (int page = start >> page_shift_; page <= end >> page_shift_; ++page) {
+    const uint8_t* cells = pages_[static_cast<size_t>(static_cast<int64_t>(page) - first_page_)];
+    const uint8_t* other_cells = other.pages_[static_cast<size_t>(static_cast<int64_t>(page) - other.first_page_)];
+    if (cells == nullptr || other_cells == nullptr) {
+      if (cells != other_cells) {
+        return false;
+      }
+    } else if (std::memcmp(cells, other_cells, PagePool::PAGE_BYTES) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Tape::load(int start, std::string_view content, int head_position) {
+  clear();
+  for (size_t i = 0; i < content.length(); ++i) {
+    set_cell(start + static_cast<int>(i), content[i]);
+  }
+  head_position_ = head_position;
+}
+
+bool Tape::map_file(const std::string& path, std::string& error) {
+  auto file = std::make_unique<TapeFile>();
+  if (!file->open(path)) {
+    error = file->get_last_error();
+    return false;
+  }
+  // Pasar las páginas actuales al fichero
+  Tape contents(std::move(*this));
+  file_ = std::move(file);
+  head_position_ = contents.head_position_;
+  blank_symbol_ = contents.blank_symbol_;
+  copy_codes(contents);
+  copy_pages(contents);
+  return true;
+}
+
 bool Tape::is_empty() const {
-  return cells_.empty();
-}
\ No newline at end of file
+  return non_blank_ == 0;
+}
+
+#ifdef TAPE_STATS
+void Tape::set_stats(TapeStats* stats) {
+  stats_.stats = stats;
+  if (stats != nullptr) {
+    stats->begin_run(head_position_);
+  }
+}
+#endif
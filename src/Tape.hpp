@@ -1,19 +1,203 @@
 #pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
+#include "PagePool.hpp"
+#include "TapeFile.hpp"
+#ifdef TAPE_STATS
+#include "TapeStats.hpp"
+#endif
 
 /**
  * @brief Clase que representa la cinta infinita de la Máquina de Turing
  * 
- * La cinta se implementa usando un mapa disperso para optimizar el uso de memoria.
- * Solo se almacenan las posiciones que contienen símbolos diferentes al símbolo blanco.
- * Las posiciones no especificadas se consideran que contienen el símbolo blanco.
+ * La cinta se guarda en páginas de PagePool::PAGE_BYTES bytes indexadas por
+ * un directorio: la página i del directorio cubre las celdas desde
+ * (first_page_ + i) · page_cells(). Las páginas salen de un PagePool, así que
+ * crecer nunca copia el contenido ya escrito (solo el directorio, de un
+ * puntero por página) y no hace falta memoria doble.
+ *
+ * Cada celda guarda el código de su símbolo en 1, 2, 4 u 8 bits: los códigos
+ * se reparten en orden de aparición (o de set_alphabet()) y el blanco es
+ * siempre el 0, así que una página recién pedida (a cero) está en blanco y
+ * las páginas sin entrada en el directorio se leen como blancas. Con dos
+ * símbolos caben 32768 celdas por página. Un símbolo que no cabe en el ancho
+ * actual lo duplica y recodifica la cinta. Una página que vuelve a quedar
+ * toda en blanco se devuelve al PagePool. La última página consultada se
+ * recuerda, así que leer y escribir tras moverse una celda casi nunca pasa
+ * por el directorio.
+ *
+ * Los extremos del contenido se mantienen al escribir: un símbolo fuera de
+ * ellos los amplía y borrar uno de ellos solo lo marca como dudoso. La
+ * siguiente consulta lo busca desde la posición anterior hacia dentro: salta
+ * las entradas vacías del directorio de 64 en 64 con un mapa de bits de las
+ * ocupadas (page_bits_) y solo recorre celdas en la página donde termina, así
+ * que cuesta el hueco hasta el contenido dividido entre 64 páginas más una
+ * página, no la cinta entera.
+ *
+ * Con map_file() las páginas viven en un TapeFile en lugar del PagePool
+ * (cintas mayores que la memoria). Las copias de una cinta así usan el
+ * PagePool; una asignación conserva el respaldo del destino.
  */
 class Tape {
 private:
-  std::unordered_map<int, char> cells_;  // Celdas de la cinta (posición -> símbolo)
-  int head_position_;                    // Posición actual del cabezal
-  char blank_symbol_;                    // Símbolo blanco de la cinta
+  static constexpr int NO_PAGE = INT32_MIN;                    // cached_page_ sin página recordada
+  static constexpr int NO_CODE = -1;                           // Símbolo aún sin código
+  static constexpr int PAGE_BITS_SHIFT = 15;                   // log2 de los bits de una página
+  static_assert(PagePool::PAGE_BYTES * 8 == (1 << PAGE_BITS_SHIFT), "páginas de 4 KiB");
+  std::vector<uint8_t*> pages_;      // Directorio (nullptr = página en blanco)
+  std::vector<uint32_t> page_counts_;  // Celdas no blancas de cada página del directorio
+  std::vector<uint64_t> page_bits_;  // Un bit por entrada del directorio: si tiene página
+  int first_page_;                   // Página que cubre pages_[0]
+  size_t non_blank_;                 // Celdas no blancas en toda la cinta
+  mutable int content_start_;        // Ninguna celda no blanca a su izquierda
+  mutable int content_end_;          // Ninguna celda no blanca a su derecha
+  mutable bool start_exact_;         // Si content_start_ es no blanca (si no, se busca al consultarla)
+  mutable bool end_exact_;           // Si content_end_ es no blanca
+  mutable int cached_page_;          // Última página consultada
+  mutable size_t cached_slot_;       // Su entrada en el directorio (SIZE_MAX = fuera de él)
+  int head_position_;                // Posición actual del cabezal
+  char blank_symbol_;                // Símbolo blanco de la cinta
+  std::unique_ptr<TapeFile> file_;   // Fichero que guarda las páginas (nullptr = PagePool)
+  int bits_log_;                     // log2 de los bits por celda (0 = 1 bit ... 3 = 8 bits)
+  int per_byte_log_;                 // log2 de las celdas por byte (3 - bits_log_)
+  int page_shift_;                   // log2 de las celdas por página
+  int offset_mask_;                  // Celdas por página - 1
+  uint8_t code_mask_;                // Bits de un código (2^bits - 1)
+  std::array<int16_t, 256> codes_;   // Código de cada símbolo (NO_CODE = sin código)
+  std::array<char, 256> symbols_;    // Símbolo de cada código (symbols_[0] es el blanco)
+  int num_codes_;                    // Códigos repartidos
+
+#ifdef TAPE_STATS
+  /**
+   * @brief Enlace a las estadísticas que no se copia
+   *
+   * Solo se instrumenta la cinta viva del simulador: las copias (trazas,
+   * configuraciones guardadas) nacen sin enlace y una asignación conserva el
+   * enlace del destino.
+   */
+  struct StatsLink {
+    TapeStats* stats = nullptr;
+    StatsLink() = default;
+    StatsLink(const StatsLink&) {}
+    StatsLink& operator=(const StatsLink&) { return *this; }
+  };
+  StatsLink stats_;                      // Estadísticas de uso (make TAPE_STATS=1)
+#endif
+
+  int page_cells() const { return offset_mask_ + 1; }
+  int min_page() const { return INT32_MIN >> page_shift_; }
+
+  /**
+   * @brief Código de la celda offset de una página
+   */
+  uint8_t code_at(const uint8_t* cells, int offset) const {
+    int shift = (offset & ((1 << per_byte_log_) - 1)) << bits_log_;
+    return static_cast<uint8_t>(cells[offset >> per_byte_log_] >> shift) & code_mask_;
+  }
+
+  /**
+   * @brief Entrada del directorio de una página (SIZE_MAX si queda fuera)
+   */
+  size_t find_slot(int page) const {
+    if (page != cached_page_) {
+      size_t slot = static_cast<size_t>(static_cast<int64_t>(page) - first_page_);
+      cached_page_ = page;
+      cached_slot_ = slot < pages_.size() ? slot : SIZE_MAX;
+    }
+    return cached_slot_;
+  }
+
+  /**
+   * @brief Símbolo de una celda
+   */
+  char cell(int position) const {
+    size_t slot = find_slot(position >> page_shift_);  // Desplazamiento aritmético: redondea hacia -∞
+    if (slot == SIZE_MAX || pages_[slot] == nullptr) {
+      return blank_symbol_;
+    }
+    return symbols_[code_at(pages_[slot], position & offset_mask_)];
+  }
+
+  /**
+   * @brief Cambia el símbolo de una celda
+   */
+  void set_cell(int position, char symbol);
+
+  /**
+   * @brief Da código a un símbolo nuevo, ensanchando las celdas si no cabe
+   * @return Código del símbolo
+   */
+  int add_symbol(char symbol);
+
+  /**
+   * @brief Duplica los bits por celda y recodifica el contenido
+   */
+  void widen();
+
+  /**
+   * @brief Vuelve al código inicial (solo el blanco, un bit por celda)
+   */
+  void reset_codes();
+
+  /**
+   * @brief Fija el ancho de las celdas y lo que se deriva de él
+   */
+  void set_bits_log(int bits_log);
+
+  /**
+   * @brief Toma el ancho y los códigos de otra cinta (la propia debe estar vacía)
+   */
+  void copy_codes(const Tape& other);
+
+  /**
+   * @brief Página en blanco para la página indicada, del fichero o del PagePool
+   */
+  uint8_t* acquire_page(int page);
+
+  /**
+   * @brief Devuelve una página que quedó en blanco
+   */
+  void release_page(int page, uint8_t* cells);
+
+  /**
+   * @brief Marca o desmarca en page_bits_ la entrada slot del directorio
+   */
+  void set_page_bit(size_t slot, bool present) {
+    uint64_t bit = uint64_t{1} << (slot % 64);
+    page_bits_[slot / 64] = present ? page_bits_[slot / 64] | bit : page_bits_[slot / 64] & ~bit;
+  }
+
+  /**
+   * @brief Primera entrada con página desde slot (debe haber alguna)
+   */
+  size_t next_page_slot(size_t slot) const;
+
+  /**
+   * @brief Última entrada con página hasta slot (debe haber alguna)
+   */
+  size_t prev_page_slot(size_t slot) const;
+
+  /**
+   * @brief Amplía el directorio para que incluya una página
+   * @return Entrada de la página
+   */
+  size_t reserve_slot(int page);
+
+  /**
+   * @brief Devuelve todas las páginas y vacía el directorio
+   */
+  void clear();
+
+  /**
+   * @brief Copia las páginas de otra cinta (la propia debe estar vacía)
+   */
+  void copy_pages(const Tape& other);
 
 public:
   /**
@@ -27,10 +211,15 @@ public:
    * @param input_string Cadena inicial a escribir en la cinta
    * @param blank_symbol Símbolo blanco (por defecto '.')
    */
-  Tape(const std::string& input_string, char blank_symbol = '.');
+  Tape(std::string_view input_string, char blank_symbol = '.');
+
+  Tape(const Tape& other);
+  Tape(Tape&& other) noexcept;
+  Tape& operator=(const Tape& other);
+  Tape& operator=(Tape&& other) noexcept;
 
   /**
-   * @brief Destructor
+   * @brief Destructor (devuelve las páginas al PagePool)
    */
   ~Tape();
 
@@ -56,6 +245,14 @@ public:
    */
   void move_right();
 
+  /**
+   * @brief Lee el símbolo de una posición cualquiera sin mover el cabezal
+   * (no cuenta como lectura en las estadísticas)
+   * @param position Posición a leer
+   * @return Símbolo en esa posición
+   */
+  char read_at(int position) const;
+
   /**
    * @brief Obtiene la posición actual del cabezal
    * @return Posición del cabezal
@@ -74,11 +271,26 @@ public:
    */
   char get_blank_symbol() const;
 
+  /**
+   * @brief Da código de antemano a los símbolos de un alfabeto
+   *
+   * Fija el ancho de las celdas según el tamaño del alfabeto de cinta, de
+   * modo que escribir no tenga que recodificar la cinta. Los códigos se
+   * conservan al reiniciar la cinta.
+   * @param symbols Símbolos del alfabeto (el blanco y los repetidos se ignoran)
+   */
+  void set_alphabet(std::string_view symbols);
+
+  /**
+   * @brief Bits que ocupa cada celda (1, 2, 4 u 8)
+   */
+  int get_cell_bits() const { return 1 << bits_log_; }
+
   /**
    * @brief Reinicia la cinta con una nueva cadena de entrada
    * @param input_string Nueva cadena de entrada
    */
-  void reset(const std::string& input_string);
+  void reset(std::string_view input_string);
 
   /**
    * @brief Obtiene una representación visual de la cinta
@@ -95,9 +307,64 @@ public:
    */
   std::string get_content() const;
 
+  /**
+   * @brief Recorre get_content() en trozos consecutivos sin construir la cadena completa
+   * @param visit Recibe cada trozo (la vista solo vale durante la llamada)
+   */
+  void for_each_content_chunk(const std::function<void(std::string_view)>& visit) const;
+
+  /**
+   * @brief Longitud de get_content()
+   */
+  size_t get_content_size() const;
+
+  /**
+   * @brief Posición del primer símbolo de get_content()
+   * @return Posición más a la izquierda con contenido (0 si la cinta está vacía)
+   */
+  int get_content_start() const;
+
+  /**
+   * @brief Posición del último símbolo de get_content()
+   * @return Posición más a la derecha con contenido (-1 si la cinta está vacía)
+   */
+  int get_content_end() const;
+
+  /**
+   * @brief Restaura un contenido guardado (puntos de control)
+   * @param start Posición del primer símbolo de content
+   * @param content Contenido, como el de get_content()
+   * @param head_position Posición del cabezal
+   */
+  void load(int start, std::string_view content, int head_position);
+
+  /**
+   * @brief Guarda las páginas en un fichero disperso proyectado en memoria
+   *        (ver TapeFile); el contenido actual se conserva
+   * @param path Fichero a crear (se borra al destruir la cinta)
+   * @param error Motivo si no se pudo
+   * @return false si no se pudo crear o proyectar el fichero
+   */
+  bool map_file(const std::string& path, std::string& error);
+
+  /**
+   * @brief Compara el contenido con el de otra cinta (sin tener en cuenta los
+   *        cabezales) sin construir las cadenas de get_content()
+   * @return true si get_content() y get_content_start() coinciden
+   */
+  bool has_same_content(const Tape& other) const;
+
   /**
    * @brief Verifica si la cinta está vacía (solo contiene símbolos blancos)
    * @return true si la cinta está vacía
    */
   bool is_empty() const;
+
+#ifdef TAPE_STATS
+  /**
+   * @brief Enlaza la cinta con unas estadísticas y empieza en ellas una palabra
+   * @param stats Estadísticas a alimentar (nullptr = ninguna)
+   */
+  void set_stats(TapeStats* stats);
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "TapeFile.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+TapeFile::TapeFile() : fd_(-1), data_(nullptr) {
+}
+
+TapeFile::~TapeFile() {
+  close();
+}
+
+bool TapeFile::open(const std::string& path) {
+  close();
+
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fd < 0) {
+    last_error_ = "No se puede crear el fichero de cinta: " + path + " (" + std::strerror(errno) + ")";
+    return false;
+  }
+  // Tamaño completo sin reservar disco: el fichero queda disperso
+  if (ftruncate(fd, static_cast<off_t>(SPAN)) != 0) {
+    last_error_ = "No se puede dimensionar el fichero de cinta: " + path + " (" + std::strerror(errno) + ")";
+    ::close(fd);
+    unlink(path.c_str());
+    return false;
+  }
+  void* addr = mmap(nullptr, SPAN, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (addr == MAP_FAILED) {
+    last_error_ = "No se puede proyectar el fichero de cinta: " + path + " (" + std::strerror(errno) + ")";
+    ::close(fd);
+    unlink(path.c_str());
+    return false;
+  }
+  // Sin lectura anticipada alrededor de cada fallo: la pide advise() según el cabezal
+  madvise(addr, SPAN, MADV_RANDOM);
+
+  fd_ = fd;
+  data_ = static_cast<uint8_t*>(addr);
+  path_ = path;
+  return true;
+}
+
+void TapeFile::close() {
+  if (data_ != nullptr) {
+    munmap(data_, SPAN);
+    data_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+    unlink(path_.c_str());
+  }
+}
+
+void TapeFile::release(size_t number) {
+#ifdef FALLOC_FL_PUNCH_HOLE
+  if (fallocate(fd_, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, static_cast<off_t>(number * PagePool::PAGE_BYTES),
+                PagePool::PAGE_BYTES) == 0) {
+    return;
+  }
+#endif
+  std::memset(page(number), 0, PagePool::PAGE_BYTES);
+}
+
+void TapeFile::advise(size_t number, int direction) {
+  // Por delante: la ventana de ADVISE_PAGES páginas que empieza en la actual
+  size_t total = static_cast<size_t>(SPAN / PagePool::PAGE_BYTES);
+  size_t first = number;
+  size_t count = ADVISE_PAGES;
+  if (direction < 0) {
+    first = number >= ADVISE_PAGES - 1 ? number - (ADVISE_PAGES - 1) : 0;
+    count = number - first + 1;
+  } else if (first + count > total) {
+    count = total - first;
+  }
+  madvise(page(first), count * PagePool::PAGE_BYTES, MADV_WILLNEED);
+
+#ifdef MADV_COLD
+  // Por detrás: la página que acaba de salir de esa ventana
+  if (direction < 0 ? number + ADVISE_PAGES < total : number >= ADVISE_PAGES) {
+    madvise(page(direction < 0 ? number + ADVISE_PAGES : number - ADVISE_PAGES), PagePool::PAGE_BYTES, MADV_COLD);
+  }
+#endif
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "PagePool.hpp"
+
+/**
+ * @brief Fichero disperso proyectado en memoria que guarda las páginas de
+ *        una cinta (mt-sim --tape-backing file:ruta)
+ *
+ * Para cintas más grandes que la memoria: el fichero se crea con el tamaño
+ * de todas las páginas posibles (SPAN bytes) pero sin ocupar disco, y se
+ * proyecta compartido, así que el núcleo puede descargar las páginas que no
+ * se usan y volver a leerlas cuando el cabezal regresa. La página n de la
+ * cinta está en el desplazamiento n · PAGE_BYTES; una página que vuelve a
+ * quedar en blanco se perfora (deja de ocupar disco y se lee a cero).
+ *
+ * advise() traduce el sentido del cabezal en consejos al núcleo: leer por
+ * adelantado las páginas hacia las que avanza y enfriar las que deja atrás.
+ * El fichero se borra al cerrarlo. No es copiable.
+ */
+class TapeFile {
+public:
+  static constexpr uint64_t SPAN = uint64_t(1) << 32;  // Bytes proyectados (una celda por byte y posición)
+  static constexpr size_t ADVISE_PAGES = 16;           // Páginas por delante del cabezal que se piden
+
+private:
+  int fd_;                  // Descriptor del fichero (-1 si cerrado)
+  uint8_t* data_;           // Proyección (nullptr si cerrado)
+  std::string path_;        // Ruta del fichero
+  std::string last_error_;  // Último error ocurrido
+
+public:
+  TapeFile();
+
+  /**
+   * @brief Destructor: libera la proyección y borra el fichero
+   */
+  ~TapeFile();
+
+  TapeFile(const TapeFile&) = delete;
+  TapeFile& operator=(const TapeFile&) = delete;
+
+  /**
+   * @brief Crea (o trunca) el fichero y lo proyecta
+   * @return false si no se pudo (ver get_last_error())
+   */
+  bool open(const std::string& path);
+
+  /**
+   * @brief Libera la proyección, cierra y borra el fichero
+   */
+  void close();
+
+  /**
+   * @brief Página n de la cinta (a cero si nunca se escribió o se perforó)
+   */
+  uint8_t* page(size_t number) const { return data_ + number * PagePool::PAGE_BYTES; }
+
+  /**
+   * @brief Perfora una página; si el sistema de ficheros no lo admite, la pone a cero
+   */
+  void release(size_t number);
+
+  /**
+   * @brief Aconseja al núcleo según el cabezal, al entrar en una página
+   * @param number Página en la que acaba de entrar
+   * @param direction -1 si avanza hacia la izquierda, 1 si hacia la derecha
+   */
+  void advise(size_t number, int direction);
+
+  const std::string& get_last_error() const { return last_error_; }
+};
@@ -0,0 +1,108 @@
+#include "TapeStats.hpp"
+#include <algorithm>
+#include <fstream>
+
+TapeStats::TapeStats()
+    : origin_(0), total_reads_(0), total_writes_(0), moves_(0), reversals_(0),
+      sweeps_(0), runs_(0), min_position_(0), max_position_(0), direction_(0),
+      touched_(false) {
+}
+
+void TapeStats::begin_run(int head_position) {
+  runs_++;
+  direction_ = 0;
+  visit(head_position);
+}
+
+void TapeStats::grow(int position) {
+  if (reads_.empty()) {
+    reads_.assign(64, 0);
+    writes_.assign(64, 0);
+    origin_ = position - 32;
+    return;
+  }
+  // Se duplica el tamaño hacia el lado que se ha quedado corto
+  size_t size = reads_.size();
+  int64_t first = origin_;
+  int64_t last = first + static_cast<int64_t>(size);
+  int64_t new_first = first;
+  int64_t new_last = last;
+  if (position < first) {
+    new_first = std::min<int64_t>(position, first - static_cast<int64_t>(size));
+  } else {
+    new_last = std::max<int64_t>(static_cast<int64_t>(position) + 1, last + static_cast<int64_t>(size));
+  }
+  size_t offset = static_cast<size_t>(first - new_first);
+  for (std::vector<uint64_t>* counters : {&reads_, &writes_}) {
+    std::vector<uint64_t> grown(static_cast<size_t>(new_last - new_first), 0);
+    std::copy(counters->begin(), counters->end(), grown.begin() + offset);
+    counters->swap(grown);
+  }
+  origin_ = static_cast<int>(new_first);
+}
+
+double TapeStats::get_average_sweep() const {
+  return sweeps_ > 0 ? static_cast<double>(moves_) / static_cast<double>(sweeps_) : 0.0;
+}
+
+bool TapeStats::export_file(const std::vector<TapeStats>& tapes, const std::string& path,
+                            std::string& error) {
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    error = "No se puede crear el archivo: " + path;
+    return false;
+  }
+
+  bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+  if (json) {
+    file << "{\"tapes\":[";
+  } else {
+    for (size_t t = 0; t < tapes.size(); ++t) {
+      const TapeStats& stats = tapes[t];
+      file << "# cinta " << (t + 1) << ": palabras=" << stats.runs_
+           << " lecturas=" << stats.total_reads_ << " escrituras=" << stats.total_writes_
+           << " movimientos=" << stats.moves_ << " posicion_min=" << stats.min_position_
+           << " posicion_max=" << stats.max_position_ << " cambios_sentido=" << stats.reversals_
+           << " pasadas=" << stats.sweeps_ << " pasada_media=" << stats.get_average_sweep() << "\n";
+    }
+    file << "cinta,posicion,lecturas,escrituras\n";
+  }
+
+  for (size_t t = 0; t < tapes.size(); ++t) {
+    const TapeStats& stats = tapes[t];
+    if (json) {
+      file << (t > 0 ? "," : "") << "{\"tape\":" << (t + 1) << ",\"runs\":" << stats.runs_
+           << ",\"reads\":" << stats.total_reads_ << ",\"writes\":" << stats.total_writes_
+           << ",\"moves\":" << stats.moves_ << ",\"min_position\":" << stats.min_position_
+           << ",\"max_position\":" << stats.max_position_ << ",\"reversals\":" << stats.reversals_
+           << ",\"sweeps\":" << stats.sweeps_ << ",\"average_sweep\":" << stats.get_average_sweep()
+           << ",\"cells\":[";
+    }
+    bool first_cell = true;
+    for (size_t i = 0; i < stats.reads_.size(); ++i) {
+      if (stats.reads_[i] == 0 && stats.writes_[i] == 0) {
+        continue;
+      }
+      int64_t position = stats.origin_ + static_cast<int64_t>(i);
+      if (json) {
+        file << (first_cell ? "" : ",") << "[" << position << "," << stats.reads_[i] << ","
+             << stats.writes_[i] << "]";
+      } else {
+        file << (t + 1) << "," << position << "," << stats.reads_[i] << "," << stats.writes_[i] << "\n";
+      }
+      first_cell = false;
+    }
+    if (json) {
+      file << "]}";
+    }
+  }
+  if (json) {
+    file << "]}\n";
+  }
+
+  if (!file.good()) {
+    error = "Error al escribir el archivo: " + path;
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Estadísticas de uso de una cinta: mapa de calor y movimiento del cabezal
+ *
+ * Registra, sobre todas las palabras simuladas:
+ * - Lecturas y escrituras por celda (mapa de calor).
+ * - Posiciones mínima y máxima alcanzadas por el cabezal.
+ * - Cambios de sentido del cabezal y longitud media de las pasadas. Una pasada
+ *   es una secuencia de movimientos en el mismo sentido; quedarse quieto no la
+ *   interrumpe y cada palabra empieza una pasada nueva.
+ *
+ * La cinta solo la alimenta si el simulador se compila con -DTAPE_STATS
+ * (make TAPE_STATS=1); sin esa opción Tape no contiene ninguna llamada a esta
+ * clase y su camino crítico no cambia.
+ */
+class TapeStats {
+private:
+  std::vector<uint64_t> reads_;   // Lecturas por celda, desde la posición origin_
+  std::vector<uint64_t> writes_;  // Escrituras por celda, desde la posición origin_
+  int origin_;                    // Posición de reads_[0] y writes_[0]
+  uint64_t total_reads_;          // Lecturas totales
+  uint64_t total_writes_;         // Escrituras totales
+  uint64_t moves_;                // Movimientos del cabezal (sin contar los quietos)
+  uint64_t reversals_;            // Cambios de sentido
+  uint64_t sweeps_;               // Pasadas empezadas
+  uint64_t runs_;                 // Palabras simuladas
+  int min_position_;              // Posición mínima del cabezal
+  int max_position_;              // Posición máxima del cabezal
+  int direction_;                 // Sentido de la pasada actual (-1, 1 o 0 si no hay)
+  bool touched_;                  // Si el cabezal ha estado en alguna posición
+
+  /**
+   * @brief Amplía los contadores por celda para incluir una posición
+   */
+  void grow(int position);
+
+  /**
+   * @brief Índice de una posición en los contadores por celda (ampliándolos)
+   */
+  size_t cell_index(int position) {
+    int64_t index = static_cast<int64_t>(position) - origin_;
+    if (index < 0 || index >= static_cast<int64_t>(reads_.size())) {
+      grow(position);
+      index = static_cast<int64_t>(position) - origin_;
+    }
+    return static_cast<size_t>(index);
+  }
+
+  /**
+   * @brief Actualiza la excursión del cabezal
+   */
+  void visit(int position) {
+    if (!touched_ || position < min_position_) {
+      min_position_ = position;
+    }
+    if (!touched_ || position > max_position_) {
+      max_position_ = position;
+    }
+    touched_ = true;
+  }
+
+public:
+  /**
+   * @brief Constructor: estadísticas vacías
+   */
+  TapeStats();
+
+  /**
+   * @brief Empieza una palabra nueva (termina la pasada en curso)
+   * @param head_position Posición inicial del cabezal
+   */
+  void begin_run(int head_position);
+
+  /**
+   * @brief Registra una lectura
+   * @param position Posición del cabezal
+   */
+  void record_read(int position) {
+    reads_[cell_index(position)]++;
+    total_reads_++;
+  }
+
+  /**
+   * @brief Registra una escritura
+   * @param position Posición del cabezal
+   */
+  void record_write(int position) {
+    writes_[cell_index(position)]++;
+    total_writes_++;
+  }
+
+  /**
+   * @brief Registra un movimiento del cabezal
+   * @param position Posición tras el movimiento
+   * @param direction Sentido: -1 izquierda, 1 derecha
+   */
+  void record_move(int position, int direction) {
+    moves_++;
+    if (direction != direction_) {
+      if (direction_ != 0) {
+        reversals_++;
+      }
+      sweeps_++;
+      direction_ = direction;
+    }
+    visit(position);
+  }
+
+  /**
+   * @brief Longitud media de las pasadas (movimientos por pasada)
+   */
+  double get_average_sweep() const;
+
+  uint64_t get_total_reads() const { return total_reads_; }
+  uint64_t get_total_writes() const { return total_writes_; }
+  uint64_t get_moves() const { return moves_; }
+  uint64_t get_reversals() const { return reversals_; }
+  uint64_t get_sweeps() const { return sweeps_; }
+  uint64_t get_runs() const { return runs_; }
+  int get_min_position() const { return min_position_; }
+  int get_max_position() const { return max_position_; }
+
+  /**
+   * @brief Exporta las estadísticas de varias cintas
+   *
+   * El formato se elige por la extensión: ".json" escribe un objeto JSON con
+   * un resumen por cinta y sus celdas usadas como [posición, lecturas,
+   * escrituras]; cualquier otra, CSV con una fila por celda usada
+   * (cinta,posicion,lecturas,escrituras) precedido por el resumen de cada
+   * cinta en líneas de comentario "#".
+   *
+   * @param tapes Estadísticas de cada cinta, en orden
+   * @param path Fichero de salida
+   * @param error Salida: mensaje de error si no se pudo escribir
+   * @return true si se pudo escribir
+   */
+  static bool export_file(const std::vector<TapeStats>& tapes, const std::string& path,
+                          std::string& error);
+};
@@ -0,0 +1,86 @@
+#include "TranslatedCycleDetector.hpp"
+#include <algorithm>
+#include <utility>
+
+TranslatedCycleDetector::TranslatedCycleDetector() {
+  right_.direction = 1;
+  left_.direction = -1;
+  right_.bound = 0;
+  left_.bound = 0;
+}
+
+void TranslatedCycleDetector::reset(const Tape& tape) {
+  int head = tape.get_head_position();
+  right_.records.clear();
+  left_.records.clear();
+  if (tape.is_empty()) {
+    right_.bound = head;
+    left_.bound = head;
+  } else {
+    right_.bound = std::max(head, tape.get_content_end());
+    left_.bound = std::min(head, tape.get_content_start());
+  }
+}
+
+void TranslatedCycleDetector::save_side(const Side& side, Checkpoint::CycleSide& image) {
+  image.bound = side.bound;
+  image.records.clear();
+  for (const Record& record : side.records) {
+    image.records.push_back(Checkpoint::CycleRecord{record.state, record.position, record.reach, record.segment});
+  }
+}
+
+void TranslatedCycleDetector::restore_side(Side& side, const Checkpoint::CycleSide& image) {
+  side.bound = static_cast<int>(image.bound);
+  side.records.clear();
+  for (const Checkpoint::CycleRecord& record : image.records) {
+    side.records.push_back(Record{record.state, static_cast<int>(record.position),
+                                  static_cast<int>(record.reach), record.segment});
+  }
+}
+
+void TranslatedCycleDetector::save_state(Checkpoint& checkpoint) const {
+  checkpoint.has_cycle_detector = true;
+  save_side(right_, checkpoint.cycle_right);
+  save_side(left_, checkpoint.cycle_left);
+}
+
+void TranslatedCycleDetector::restore_state(const Checkpoint& checkpoint) {
+  restore_side(right_, checkpoint.cycle_right);
+  restore_side(left_, checkpoint.cycle_left);
+}
+
+bool TranslatedCycleDetector::add_record(Side& side, const Tape& tape, uint32_t state) {
+  Record record;
+  record.state = state;
+  record.position = tape.get_head_position();
+  record.reach = record.position;
+  record.segment.resize(MAX_SEGMENT);
+  for (int i = 0; i < MAX_SEGMENT; ++i) {
+    record.segment[i] = tape.read_at(record.position - side.direction * i);
+  }
+  side.bound = record.position;
+
+  // Del récord más reciente al más antiguo, llevando lo más atrás que llegó el
+  // cabezal desde cada uno hasta ahora
+  int reach = record.position;
+  for (auto it = side.records.rbegin(); it != side.records.rend(); ++it) {
+    if (side.direction * (reach - it->reach) > 0) {
+      reach = it->reach;
+    }
+    if (it->state != state) {
+      continue;
+    }
+    int depth = side.direction * (it->position - reach);
+    if (depth < MAX_SEGMENT &&
+        it->segment.compare(0, depth + 1, record.segment, 0, depth + 1) == 0) {
+      return true;
+    }
+  }
+
+  side.records.push_back(std::move(record));
+  if (side.records.size() > MAX_RECORDS) {
+    side.records.pop_front();
+  }
+  return false;
+}
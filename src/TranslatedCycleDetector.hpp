@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include "Checkpoint.hpp"
+#include "Tape.hpp"
+
+/**
+ * @brief Detector de ciclos trasladados en una cinta
+ *
+ * Algunas máquinas no se detienen nunca pero tampoco repiten una configuración
+ * exacta: avanzan sin parar en un sentido dejando atrás un patrón periódico.
+ * El detector guarda un récord cada vez que el cabezal llega más lejos que
+ * nunca por un lado (más allá de todo lo escrito, así que por delante solo hay
+ * blancos): el estado, la posición y las MAX_SEGMENT celdas de detrás del
+ * cabezal, y lo que llega a retroceder el cabezal hasta el récord siguiente.
+ *
+ * Si dos récords r1 y r2 del mismo lado tienen el mismo estado y coinciden las
+ * celdas de detrás del cabezal hasta lo más atrás que llegó entre r1 y r2,
+ * la ejecución de r1 a r2 solo leyó esas celdas y blancos, así que desde r2 se
+ * repite desplazada, y así indefinidamente: la máquina no se detiene.
+ *
+ * El simulador llama a reset() al empezar y a observe() tras cada paso; fuera
+ * de los récords observe() solo compara la posición del cabezal. Los récords
+ * viajan en los puntos de control (save_state() / restore_state()) para que
+ * una simulación reanudada detecte el ciclo en el mismo paso.
+ */
+class TranslatedCycleDetector {
+public:
+  static constexpr int MAX_SEGMENT = 256;      // Celdas guardadas detrás del cabezal en cada récord
+  static constexpr size_t MAX_RECORDS = 64;    // Récords guardados por lado (los más recientes)
+
+private:
+  /**
+   * @brief Récord del cabezal por un lado
+   */
+  struct Record {
+    uint32_t state;        // Estado al llegar
+    int position;          // Posición del cabezal
+    int reach;             // Lo más atrás que llegó el cabezal hasta el récord siguiente
+    std::string segment;   // segment[i]: celda a distancia i por detrás del cabezal
+  };
+
+  /**
+   * @brief Récords de un lado de la cinta (direction +1 derecha, -1 izquierda)
+   */
+  struct Side {
+    int direction;                // Sentido de avance
+    int bound;                    // Posición más avanzada por este lado hasta ahora
+    std::deque<Record> records;   // Récords, del más antiguo al más reciente
+  };
+
+  Side right_;   // Récords por la derecha
+  Side left_;    // Récords por la izquierda
+
+  /**
+   * @brief Guarda un récord nuevo y lo compara con los anteriores del mismo estado
+   * @return true si demuestra un ciclo trasladado
+   */
+  bool add_record(Side& side, const Tape& tape, uint32_t state);
+
+  /**
+   * @brief Actualiza lo más atrás que llegó el cabezal desde el último récord
+   */
+  static void save_side(const Side& side, Checkpoint::CycleSide& image);
+  static void restore_side(Side& side, const Checkpoint::CycleSide& image);
+
+  static void update_reach(Side& side, int head) {
+    if (!side.records.empty()) {
+      Record& last = side.records.back();
+      if (side.direction * (last.reach - head) > 0) {
+        last.reach = head;
+      }
+    }
+  }
+
+public:
+  TranslatedCycleDetector();
+
+  /**
+   * @brief Empieza a observar una simulación desde la configuración actual
+   * @param tape Cinta de la simulación (los límites parten de lo ya escrito)
+   */
+  void reset(const Tape& tape);
+
+  /**
+   * @brief Guarda los récords y límites en un punto de control
+   */
+  void save_state(Checkpoint& checkpoint) const;
+
+  /**
+   * @brief Continúa desde los récords y límites de un punto de control
+   */
+  void restore_state(const Checkpoint& checkpoint);
+
+  /**
+   * @brief Observa la configuración tras un paso
+   * @param tape Cinta de la simulación
+   * @param state Estado actual
+   * @return true si queda demostrado que la máquina no se detiene
+   */
+  bool observe(const Tape& tape, uint32_t state) {
+    int head = tape.get_head_position();
+    update_reach(right_, head);
+    update_reach(left_, head);
+    if (head > right_.bound) {
+      return add_record(right_, tape, state);
+    }
+    if (head < left_.bound) {
+      return add_record(left_, tape, state);
+    }
+    return false;
+  }
+};
@@ -1,6 +1,7 @@
 #include "TuringMachine.hpp"
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 
 TuringMachine::TuringMachine(char blank_symbol) 
     : initial_state_(""), blank_symbol_(blank_symbol) {
@@ -69,14 +70,12 @@ void TuringMachine::add_transition(const Transition& transition) {
   std::pair<std::string, char> key = {transition.get_from_state(), 
                                       transition.get_read_symbol()};
   
-  // Verificar si ya existe una transición para este estado y símbolo
-  if (transitions_.find(key) != transitions_.end()) {
+  // Insertar con una sola búsqueda; si ya existía, la transición es duplicada
+  if (!transitions_.emplace(std::move(key), transition).second) {
     throw std::invalid_argument("Ya existe una transición para el estado '" + 
                                transition.get_from_state() + "' y símbolo '" + 
                                std::string(1, transition.get_read_symbol()) + "'");
   }
-  
-  transitions_[key] = transition;
 }
 
 void TuringMachine::add_transition(const std::string& from_state, char read_symbol,
@@ -90,11 +89,11 @@ const std::unordered_set<std::string>& TuringMachine::get_states() const {
   return states_;
 }
 
-const std::unordered_set<char>& TuringMachine::get_input_alphabet() const {
+const SymbolSet& TuringMachine::get_input_alphabet() const {
   return input_alphabet_;
 }
 
-const std::unordered_set<char>& TuringMachine::get_tape_alphabet() const {
+const SymbolSet& TuringMachine::get_tape_alphabet() const {
   return tape_alphabet_;
 }
 
@@ -150,13 +149,13 @@ bool TuringMachine::is_valid() const {
   }
   
   // Verificar que el símbolo blanco está en el alfabeto de la cinta
-  if (tape_alphabet_.find(blank_symbol_) == tape_alphabet_.end()) {
+  if (!tape_alphabet_.contains(blank_symbol_)) {
     return false;
   }
   
   // Verificar que el alfabeto de entrada es subconjunto del alfabeto de cinta
   for (char symbol : input_alphabet_) {
-    if (tape_alphabet_.find(symbol) == tape_alphabet_.end()) {
+    if (!tape_alphabet_.contains(symbol)) {
       return false;
     }
     // Verificar que el símbolo blanco no está en el alfabeto de entrada
@@ -165,23 +164,9 @@ bool TuringMachine::is_valid() const {
     }
   }
   
-  // Verificar que todas las transiciones involucran estados y símbolos válidos
-  for (const auto& pair : transitions_) {
-    const Transition& trans = pair.second;
-    
-    // Verificar estados
-    if (states_.find(trans.get_from_state()) == states_.end() ||
-        states_.find(trans.get_to_state()) == states_.end()) {
-      return false;
-    }
-    
-    // Verificar símbolos
-    if (tape_alphabet_.find(trans.get_read_symbol()) == tape_alphabet_.end() ||
-        tape_alphabet_.find(trans.get_write_symbol()) == tape_alphabet_.end()) {
-      return false;
-    }
-  }
-  
+  // Las transiciones no se recorren: add_transition() ya exige que sus estados
+  // estén declarados y añade sus símbolos al alfabeto de cinta, y ni los
+  // estados ni los símbolos se eliminan salvo con clear(), que las borra también
   return true;
 }
 
@@ -190,20 +175,19 @@ bool TuringMachine::is_accept_state(const std::string& state) const {
 }
 
 bool TuringMachine::is_input_symbol(char symbol) const {
-  return input_alphabet_.find(symbol) != input_alphabet_.end();
+  return input_alphabet_.contains(symbol);
 }
 
 bool TuringMachine::is_tape_symbol(char symbol) const {
-  return tape_alphabet_.find(symbol) != tape_alphabet_.end();
+  return tape_alphabet_.contains(symbol);
 }
 
-bool TuringMachine::is_valid_input_word(const std::string& word) const {
-  for (char symbol : word) {
-    if (!is_input_symbol(symbol)) {
-      return false;
-    }
-  }
-  return true;
+bool TuringMachine::is_valid_input_word(std::string_view word) const {
+  return input_alphabet_.contains_all(word);
+}
+
+size_t TuringMachine::find_invalid_input_symbol(std::string_view word) const {
+  return input_alphabet_.find_first_not_in(word);
 }
 
 std::string TuringMachine::get_info() const {
@@ -266,6 +250,10 @@ void TuringMachine::clear() {
   tape_alphabet_.insert(blank_symbol_);
 }
 
+void TuringMachine::reserve_transitions(size_t count) {
+  transitions_.reserve(count);
+}
+
 size_t TuringMachine::get_transition_count() const {
   return transitions_.size();
 }
\ No newline at end of file
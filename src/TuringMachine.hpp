@@ -3,6 +3,8 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
+#include <string_view>
+#include "SymbolSet.hpp"
 #include "Transition.hpp"
 
 /**
@@ -30,8 +32,8 @@ struct StateSymbolHash {
 class TuringMachine {
 private:
   std::unordered_set<std::string> states_;           // Q: Estados de la máquina
-  std::unordered_set<char> input_alphabet_;          // Σ: Alfabeto de entrada
-  std::unordered_set<char> tape_alphabet_;           // Γ: Alfabeto de la cinta
+  SymbolSet input_alphabet_;                         // Σ: Alfabeto de entrada
+  SymbolSet tape_alphabet_;                          // Γ: Alfabeto de la cinta
   std::string initial_state_;                        // q₀: Estado inicial
   std::unordered_set<std::string> accept_states_;    // F: Estados de aceptación
   char blank_symbol_;                                // ⊔: Símbolo blanco
@@ -119,13 +121,13 @@ public:
    * @brief Obtiene el alfabeto de entrada
    * @return Alfabeto de entrada
    */
-  const std::unordered_set<char>& get_input_alphabet() const;
+  const SymbolSet& get_input_alphabet() const;
 
   /**
    * @brief Obtiene el alfabeto de la cinta
    * @return Alfabeto de la cinta
    */
-  const std::unordered_set<char>& get_tape_alphabet() const;
+  const SymbolSet& get_tape_alphabet() const;
 
   /**
    * @brief Obtiene el estado inicial
@@ -193,7 +195,14 @@ public:
    * @param word Palabra a verificar
    * @return true si todos los símbolos pertenecen al alfabeto de entrada
    */
-  bool is_valid_input_word(const std::string& word) const;
+  bool is_valid_input_word(std::string_view word) const;
+
+  /**
+   * @brief Busca el primer símbolo de una palabra fuera del alfabeto de entrada
+   * @param word Palabra a verificar
+   * @return Posición del primer símbolo inválido, o SymbolSet::npos si no hay
+   */
+  size_t find_invalid_input_symbol(std::string_view word) const;
 
   // Métodos de información
 
@@ -208,6 +217,12 @@ public:
    */
   void clear();
 
+  /**
+   * @brief Reserva espacio para un número de transiciones
+   * @param count Número de transiciones previsto (evita rehacer la tabla al cargar)
+   */
+  void reserve_transitions(size_t count);
+
   /**
    * @brief Obtiene el número total de transiciones
    * @return Número de transiciones
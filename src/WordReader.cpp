@@ -0,0 +1,175 @@
+#include "WordReader.hpp"
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+bool is_space(char c) {
+  return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+}  // namespace
+
+WordReader::WordReader()
+    : use_mapping_(false), fd_(-1), owns_fd_(false),
+      buffer_begin_(0), buffer_end_(0), eof_(true) {
+}
+
+WordReader::~WordReader() {
+  close();
+}
+
+void WordReader::close() {
+  mapped_.close();
+  remaining_ = std::string_view();
+  use_mapping_ = false;
+  if (owns_fd_ && fd_ >= 0) {
+    ::close(fd_);
+  }
+  fd_ = -1;
+  owns_fd_ = false;
+  buffer_begin_ = 0;
+  buffer_end_ = 0;
+  eof_ = true;
+}
+
+bool WordReader::open_file(const std::string& path) {
+  close();
+
+  if (mapped_.open(path)) {
+    remaining_ = mapped_.view();
+    use_mapping_ = true;
+    return true;
+  }
+
+  // Ficheros no proyectables (tuberías, dispositivos): lectura por bloques
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    last_error_ = "No se puede abrir fichero de palabras: " + path +
+                  " (" + std::strerror(errno) + ")";
+    return false;
+  }
+  fd_ = fd;
+  owns_fd_ = true;
+  eof_ = false;
+  buffer_.resize(DEFAULT_BUFFER_SIZE);
+  return true;
+}
+
+void WordReader::open_stdin(size_t buffer_size) {
+  close();
+  fd_ = STDIN_FILENO;
+  owns_fd_ = false;
+  eof_ = false;
+  buffer_.resize(buffer_size > 0 ? buffer_size : DEFAULT_BUFFER_SIZE);
+}
+
+bool WordReader::next(std::string_view& word) {
+  std::string_view line;
+
+  if (use_mapping_) {
+    if (remaining_.empty()) {
+      return false;
+    }
+    const void* newline = std::memchr(remaining_.data(), '\n', remaining_.size());
+    if (newline != nullptr) {
+      size_t length = static_cast<const char*>(newline) - remaining_.data();
+      line = remaining_.substr(0, length);
+      remaining_.remove_prefix(length + 1);
+    } else {
+      line = remaining_;
+      remaining_ = std::string_view();
+    }
+  } else if (!next_streamed_line(line)) {
+    return false;
+  }
+
+  word = strip(line);
+  return true;
+}
+
+bool WordReader::next_streamed_line(std::string_view& line) {
+  while (true) {
+    const char* start = buffer_.data() + buffer_begin_;
+    size_t pending = buffer_end_ - buffer_begin_;
+    const void* newline = std::memchr(start, '\n', pending);
+    if (newline != nullptr) {
+      size_t length = static_cast<const char*>(newline) - start;
+      line = std::string_view(start, length);
+      buffer_begin_ += length + 1;
+      return true;
+    }
+
+    if (eof_) {
+      if (pending == 0) {
+        return false;
+      }
+      // Última línea sin salto de línea final
+      line = std::string_view(start, pending);
+      buffer_begin_ = buffer_end_;
+      return true;
+    }
+
+    // Compactar los datos pendientes al principio y ampliar si la línea no cabe
+    if (buffer_begin_ > 0) {
+      std::memmove(buffer_.data(), start, pending);
+      buffer_begin_ = 0;
+      buffer_end_ = pending;
+    }
+    if (buffer_end_ == buffer_.size()) {
+      buffer_.resize(buffer_.size() * 2);
+    }
+
+    ssize_t count = ::read(fd_, buffer_.data() + buffer_end_, buffer_.size() - buffer_end_);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      last_error_ = std::string("Error de lectura de palabras: ") + std::strerror(errno);
+      eof_ = true;
+    } else if (count == 0) {
+      eof_ = true;
+    } else {
+      buffer_end_ += static_cast<size_t>(count);
+    }
+  }
+}
+
+std::string_view WordReader::strip(std::string_view line) {
+  size_t begin = 0;
+  size_t end = line.size();
+  while (begin < end && is_space(line[begin])) {
+    ++begin;
+  }
+  while (end > begin && is_space(line[end - 1])) {
+    --end;
+  }
+  std::string_view trimmed = line.substr(begin, end - begin);
+
+  // Caso habitual: sin espacios interiores, la vista apunta a la entrada
+  bool inner_space = false;
+  for (char c : trimmed) {
+    if (static_cast<unsigned char>(c) <= ' ' && is_space(c)) {
+      inner_space = true;
+      break;
+    }
+  }
+  if (!inner_space) {
+    return trimmed;
+  }
+
+  scratch_.clear();
+  for (char c : trimmed) {
+    if (!is_space(c)) {
+      scratch_.push_back(c);
+    }
+  }
+  return scratch_;
+}
+
+const std::string& WordReader::get_last_error() const {
+  return last_error_;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MappedFile.hpp"
+
+/**
+ * @brief Lector de palabras (una por línea) sin copias intermedias
+ *
+ * Los ficheros regulares se proyectan en memoria y cada palabra se entrega como
+ * una vista sobre la proyección; los saltos de línea se localizan con memchr,
+ * que recorre el buffer de forma vectorizada. La entrada estándar (o cualquier
+ * fichero no proyectable) se lee por bloques grandes sobre un buffer propio.
+ *
+ * Como en la lectura línea a línea original, se eliminan todos los espacios de
+ * la línea y una línea vacía representa la palabra vacía. Solo las líneas con
+ * espacios interiores (caso raro) se copian a un buffer auxiliar.
+ *
+ * Las vistas devueltas por next() son válidas hasta la siguiente llamada.
+ */
+class WordReader {
+private:
+  MappedFile mapped_;             // Proyección del fichero (modo proyección)
+  std::string_view remaining_;    // Parte de la proyección aún sin leer
+  bool use_mapping_;              // true si se lee de la proyección
+  int fd_;                        // Descriptor para lectura por bloques (-1 si no hay)
+  bool owns_fd_;                  // Si el descriptor debe cerrarse al terminar
+  std::vector<char> buffer_;      // Buffer de lectura por bloques
+  size_t buffer_begin_;           // Inicio de los datos pendientes en el buffer
+  size_t buffer_end_;             // Fin de los datos pendientes en el buffer
+  bool eof_;                      // Si el descriptor llegó al final
+  std::string scratch_;           // Copia de líneas con espacios interiores
+  std::string last_error_;        // Último error ocurrido
+
+  /**
+   * @brief Obtiene la siguiente línea cruda del modo por bloques
+   * @param line Salida: línea sin el salto de línea
+   * @return true si se obtuvo una línea
+   */
+  bool next_streamed_line(std::string_view& line);
+
+  /**
+   * @brief Elimina los espacios de una línea
+   * @param line Línea cruda
+   * @return Vista sobre la línea recortada o sobre scratch_ si hubo que copiar
+   */
+  std::string_view strip(std::string_view line);
+
+  /**
+   * @brief Cierra la fuente actual
+   */
+  void close();
+
+public:
+  static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;  // 1 MiB
+
+  /**
+   * @brief Constructor de un lector sin fuente
+   */
+  WordReader();
+
+  WordReader(const WordReader&) = delete;
+  WordReader& operator=(const WordReader&) = delete;
+
+  /**
+   * @brief Destructor
+   */
+  ~WordReader();
+
+  /**
+   * @brief Abre un fichero de palabras (proyección si es un fichero regular)
+   * @param path Ruta del fichero
+   * @return true si se pudo abrir
+   */
+  bool open_file(const std::string& path);
+
+  /**
+   * @brief Usa la entrada estándar como fuente de palabras
+   * @param buffer_size Tamaño del buffer de lectura
+   */
+  void open_stdin(size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+  /**
+   * @brief Obtiene la siguiente palabra
+   * @param word Salida: vista sobre la palabra (válida hasta la siguiente llamada)
+   * @return true si se obtuvo una palabra, false al final de la entrada
+   */
+  bool next(std::string_view& word);
+
+  /**
+   * @brief Obtiene el último error ocurrido
+   * @return Mensaje de error
+   */
+  const std::string& get_last_error() const;
+};
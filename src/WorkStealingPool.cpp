@@ -0,0 +1,125 @@
+#include "WorkStealingPool.hpp"
+
+WorkStealingPool::WorkStealingPool(size_t num_workers, TaskOrder order)
+    : order_(order), queued_(0), pending_(0), steals_(0), executed_(0), next_submit_(0),
+      closed_(true) {
+  workers_.reserve(num_workers > 0 ? num_workers : 1);
+  for (size_t i = 0; i < workers_.capacity(); ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+}
+
+void WorkStealingPool::wake_one() {
+  // Tomar el mutex evita que el aviso se pierda entre la comprobación y la
+  // espera de un hilo
+  { std::lock_guard<std::mutex> lock(idle_mutex_); }
+  idle_cv_.notify_one();
+}
+
+void WorkStealingPool::submit(Task task) {
+  size_t worker = next_submit_;
+  next_submit_ = (next_submit_ + 1) % workers_.size();
+  push(worker, std::move(task));
+}
+
+void WorkStealingPool::push(size_t worker, Task task) {
+  pending_.fetch_add(1);
+  {
+    std::lock_guard<std::mutex> lock(workers_[worker]->mutex);
+    workers_[worker]->tasks.push_back(std::move(task));
+  }
+  queued_.fetch_add(1);
+  wake_one();
+}
+
+void WorkStealingPool::requeue(size_t worker, Task task) {
+  // Detrás de las que esperan: al principio si se toma desde el final
+  pending_.fetch_add(1);
+  {
+    std::lock_guard<std::mutex> lock(workers_[worker]->mutex);
+    if (order_ == TaskOrder::NEWEST_FIRST) {
+      workers_[worker]->tasks.push_front(std::move(task));
+    } else {
+      workers_[worker]->tasks.push_back(std::move(task));
+    }
+  }
+  queued_.fetch_add(1);
+  wake_one();
+}
+
+bool WorkStealingPool::take(size_t worker, Task& task) {
+  {
+    Worker& own = *workers_[worker];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      if (order_ == TaskOrder::NEWEST_FIRST) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+      } else {
+        task = std::move(own.tasks.front());
+        own.tasks.pop_front();
+      }
+      queued_.fetch_sub(1);
+      return true;
+    }
+  }
+  for (size_t offset = 1; offset < workers_.size(); ++offset) {
+    Worker& victim = *workers_[(worker + offset) % workers_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      queued_.fetch_sub(1);
+      steals_.fetch_add(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingPool::worker_loop(size_t worker) {
+  Task task;
+  while (true) {
+    if (take(worker, task)) {
+      task(worker);
+      task = nullptr;
+      executed_.fetch_add(1);
+      if (pending_.fetch_sub(1) == 1) {
+        // Sin tareas pendientes: los hilos terminan si ya no llegarán más
+        { std::lock_guard<std::mutex> lock(idle_mutex_); }
+        idle_cv_.notify_all();
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    idle_cv_.wait(lock, [this] { return queued_.load() > 0 || (closed_.load() && pending_.load() == 0); });
+    if (queued_.load() == 0 && closed_.load() && pending_.load() == 0) {
+      return;
+    }
+  }
+}
+
+void WorkStealingPool::start() {
+  closed_ = false;
+  threads_.reserve(workers_.size());
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    threads_.emplace_back(&WorkStealingPool::worker_loop, this, i);
+  }
+}
+
+void WorkStealingPool::wait() {
+  {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    closed_ = true;
+  }
+  idle_cv_.notify_all();
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+  threads_.clear();
+}
+
+void WorkStealingPool::run() {
+  start();
+  wait();
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Orden en que un hilo toma las tareas de su propia cola
+ */
+enum class TaskOrder {
+  NEWEST_FIRST,  // La más reciente primero (búsquedas en árbol: datos aún en caché)
+  OLDEST_FIRST   // Por orden de llegada (lotes con salida ordenada)
+};
+
+/**
+ * @brief Conjunto de hilos con robo de trabajo
+ *
+ * Cada hilo tiene su propia cola de tareas: las que crea una tarea en curso
+ * van al final de la cola de su hilo, que las toma del final (NEWEST_FIRST) o
+ * del principio (OLDEST_FIRST). Un hilo sin tareas roba del principio de la
+ * cola de otro, donde están las más antiguas (en una búsqueda en árbol, los
+ * subárboles más grandes). Cada cola tiene su propio mutex, así que los hilos
+ * solo compiten entre sí al robar.
+ *
+ * Una tarea larga puede ceder el hilo con requeue(): vuelve a la cola de su
+ * hilo detrás de todas las tareas que ya esperan, así que las tareas largas se
+ * turnan entre sí y con las nuevas.
+ *
+ * run() ejecuta las tareas encoladas (y las que creen) hasta que no queda
+ * ninguna. Para alimentar el conjunto mientras trabaja, start() arranca los
+ * hilos, submit() encola desde fuera y wait() espera a que se vacíe.
+ */
+class WorkStealingPool {
+public:
+  /**
+   * @brief Tarea: recibe el índice del hilo que la ejecuta
+   */
+  using Task = std::function<void(size_t worker)>;
+
+private:
+  /**
+   * @brief Cola de tareas de un hilo
+   */
+  struct Worker {
+    std::mutex mutex;          // Protege tasks
+    std::deque<Task> tasks;    // Tareas en cola
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers_;  // Una cola por hilo
+  TaskOrder order_;                               // Orden de la propia cola
+  std::atomic<size_t> queued_;                    // Tareas en cola
+  std::atomic<size_t> pending_;                   // Tareas en cola o en curso
+  std::atomic<uint64_t> steals_;                  // Tareas robadas
+  std::atomic<uint64_t> executed_;                // Tareas ejecutadas
+  size_t next_submit_;                            // Cola de la próxima submit()
+  std::atomic<bool> closed_;                      // Si ya no llegarán tareas de fuera
+  std::vector<std::thread> threads_;              // Hilos arrancados por start()
+  std::mutex idle_mutex_;                         // Espera de los hilos sin tareas
+  std::condition_variable idle_cv_;               // Aviso de tarea nueva o de fin
+
+  /**
+   * @brief Saca una tarea de la propia cola o la roba de otra
+   * @return false si no encontró ninguna
+   */
+  bool take(size_t worker, Task& task);
+
+  /**
+   * @brief Bucle de un hilo
+   */
+  void worker_loop(size_t worker);
+
+  /**
+   * @brief Avisa a un hilo en espera
+   */
+  void wake_one();
+
+public:
+  /**
+   * @brief Constructor
+   * @param num_workers Número de hilos (al menos 1)
+   * @param order Orden en que cada hilo toma las tareas de su cola
+   */
+  explicit WorkStealingPool(size_t num_workers, TaskOrder order = TaskOrder::NEWEST_FIRST);
+
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+  /**
+   * @brief Encola una tarea inicial, repartiendo por turnos entre las colas
+   *        (antes de run() o desde fuera de los hilos)
+   */
+  void submit(Task task);
+
+  /**
+   * @brief Encola una tarea en la cola de un hilo (desde una tarea en curso)
+   * @param worker Hilo que ejecuta la tarea en curso
+   */
+  void push(size_t worker, Task task);
+
+  /**
+   * @brief Devuelve una tarea en curso a la cola de su hilo, detrás de las
+   *        que ya esperan (desde la propia tarea)
+   * @param worker Hilo que ejecuta la tarea en curso
+   */
+  void requeue(size_t worker, Task task);
+
+  /**
+   * @brief Arranca los hilos; siguen esperando tareas hasta wait()
+   */
+  void start();
+
+  /**
+   * @brief Espera a que no quede ninguna tarea y detiene los hilos
+   */
+  void wait();
+
+  /**
+   * @brief Ejecuta las tareas con todos los hilos hasta que no quede ninguna
+   */
+  void run();
+
+  size_t get_num_workers() const { return workers_.size(); }
+  uint64_t get_steals() const { return steals_.load(); }
+  uint64_t get_executed() const { return executed_.load(); }
+};
@@ -1,71 +1,259 @@
-#include <cctype>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
 #include <cstdlib>
-#include <fstream>
 #include <iostream>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 #include <memory>
 
 #include "TuringMachine.hpp"
 #include "MultiTuringMachine.hpp"
+#include "BatchScheduler.hpp"
+#include "CancellationToken.hpp"
+#include "Checkpoint.hpp"
+#include "CompiledMachine.hpp"
+#include "DeciderPipeline.hpp"
+#include "Debugger.hpp"
+#include "LatencyReport.hpp"
+#include "MappedFile.hpp"
 #include "Parser.hpp"
+#include "Profiler.hpp"
+#include "ResultCache.hpp"
+#include "ResultWriter.hpp"
+#include "Server.hpp"
 #include "Simulator.hpp"
+#include "TapeStats.hpp"
+#include "WordReader.hpp"
 
 /**
- * @brief Elimina espacios en blanco al inicio y final de una cadena
- * @param s Cadena a procesar
- * @return Cadena sin espacios
+ * @brief Verifica si una palabra contiene solo símbolos válidos del alfabeto
+ * @param w Palabra a verificar
+ * @param machine Máquina compilada con el alfabeto (monocinta o multicinta)
+ * @param bad Puntero para almacenar el símbolo inválido (opcional)
+ * @return true si la palabra es válida
+ */
+static bool word_in_alphabet(std::string_view w, const CompiledMachine& machine,
+                             std::string* bad = nullptr) {
+  size_t pos = machine.find_invalid_input_symbol(w);
+  if (pos == SymbolSet::npos) {
+    return true;
+  }
+  if (bad) {
+    *bad = std::string(1, w[pos]);
+  }
+  return false;
+}
+
+/**
+ * @brief Escribe el registro de una palabra que no llegó a simularse
+ * @param writer Escritor de resultados
+ * @param index Índice de la palabra
+ * @param result Resultado a registrar
+ * @param is_multi_tape Si la máquina es multicinta
+ */
+static void write_unsimulated_record(ResultWriter& writer, size_t index,
+                                     SimulationResult result, bool is_multi_tape) {
+  if (is_multi_tape) {
+    writer.write_record(index, result, 0, static_cast<const MultiConfiguration*>(nullptr));
+  } else {
+    writer.write_record(index, result, 0, static_cast<const Configuration*>(nullptr));
+  }
+}
+
+/**
+ * @brief Calcula la huella del contenido final de las cintas tras una simulación
+ * @param simulator Simulador monocinta (si la máquina es monocinta)
+ * @param multi_simulator Simulador multicinta (si la máquina es multicinta)
+ * @return Huella encadenada de todas las cintas
  */
-static std::string strip_spaces(const std::string& s) {
-  std::string t;
-  for (char c : s) {
-    if (!std::isspace(static_cast<unsigned char>(c))) {
-      t.push_back(c);
+static uint64_t final_tape_digest(const Simulator* simulator,
+                                  const MultiSimulator* multi_simulator) {
+  if (multi_simulator != nullptr) {
+    const MultiTape& tapes = multi_simulator->get_current_configuration().get_tapes();
+    uint64_t digest = ResultCache::hash_bytes("");
+    for (size_t i = 0; i < tapes.get_num_tapes(); ++i) {
+      digest = ResultCache::digest_tape(tapes.get_tape(i), digest);
     }
+    return digest;
   }
-  return t;
+  return ResultCache::digest_tape(simulator->get_current_configuration().get_tape());
 }
 
 /**
- * @brief Verifica si una palabra contiene solo símbolos válidos del alfabeto
- * @param w Palabra a verificar
- * @param machine Máquina de Turing con el alfabeto
- * @param bad Puntero para almacenar el símbolo inválido (opcional)
- * @return true si la palabra es válida
+ * @brief Calcula la huella del fichero de una máquina (caché en disco y puntos
+ *        de control solo valen para el mismo fichero)
+ * @param path Fichero de la máquina
+ * @param digest Salida: huella del contenido
+ * @param error Salida: mensaje de error si no se pudo leer
+ * @return true si se pudo leer
  */
-static bool word_in_alphabet(const std::string& w, const TuringMachine& machine,
-                             std::string* bad = nullptr) {
-  for (char c : w) {
-    if (!machine.is_input_symbol(c)) {
-      if (bad) {
-        *bad = std::string(1, c);
+static bool machine_file_digest(const std::string& path, uint64_t& digest, std::string& error) {
+  MappedFile machine_file;
+  if (!machine_file.open(path)) {
+    error = machine_file.get_last_error();
+    return false;
+  }
+  digest = ResultCache::hash_bytes(machine_file.view());
+  return true;
+}
+
+// Pasos por tramo de una simulación con puntos de control
+static const size_t CHECKPOINT_SLICE = 1 << 16;
+
+// Activado por SIGINT/SIGTERM en modo servidor
+static volatile std::sig_atomic_t stop_requested = 0;
+
+static void handle_stop_signal(int) {
+  stop_requested = 1;
+}
+
+// Activado por SIGINT/SIGTERM en un lote con presupuesto de tiempo y por
+// SIGINT en el depurador
+static CancellationToken interrupt_request;
+
+static void handle_interrupt_signal(int) {
+  interrupt_request.cancel();
+}
+
+/**
+ * @brief Modo servidor: mt-sim --serve <socket> [--workers N] [--max-connections N]
+ *        [--max-steps-limit N] [--idle-timeout S]
+ * @param argc Número de argumentos
+ * @param argv Argumentos (argv[1] es --serve)
+ * @return Código de salida
+ */
+static int run_server(int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "[Error] Falta ruta del socket después de --serve\n";
+    return 1;
+  }
+  std::string socket_path = argv[2];
+  unsigned hardware_threads = std::thread::hardware_concurrency();
+  size_t num_workers = hardware_threads > 0 ? hardware_threads : 4;
+  size_t max_connections = 64;
+  size_t max_steps_limit = Server::DEFAULT_MAX_STEPS_LIMIT;
+  size_t idle_timeout_s = Server::DEFAULT_IDLE_TIMEOUT_S;
+
+  for (int i = 3; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--workers" || arg == "--max-connections" || arg == "--max-steps-limit" ||
+        arg == "--idle-timeout") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta N después de " << arg << "\n";
+        return 1;
       }
-      return false;
+      try {
+        long long v = std::stoll(argv[++i]);
+        if (v <= 0) {
+          throw std::invalid_argument("no positivo");
+        }
+        if (arg == "--idle-timeout" && v > 86400) {
+          throw std::invalid_argument("demasiado grande");
+        }
+        (arg == "--workers"           ? num_workers
+         : arg == "--max-connections" ? max_connections
+         : arg == "--max-steps-limit" ? max_steps_limit
+                                      : idle_timeout_s) = static_cast<size_t>(v);
+      } catch (...) {
+        std::cerr << "[Error] " << arg << " requiere un entero > 0\n";
+        return 1;
+      }
+    } else {
+      std::cerr << "[Aviso] Opción desconocida: " << arg << "\n";
     }
   }
-  return true;
+
+  // Un cliente que cierra antes de tiempo no debe terminar el proceso
+  std::signal(SIGPIPE, SIG_IGN);
+  struct sigaction action{};
+  action.sa_handler = handle_stop_signal;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGINT, &action, nullptr);
+  sigaction(SIGTERM, &action, nullptr);
+
+  Server server(socket_path, num_workers, max_connections);
+  server.set_max_steps_limit(max_steps_limit);
+  server.set_idle_timeout(static_cast<int>(idle_timeout_s));
+  if (!server.start()) {
+    std::cerr << "[Error] " << server.get_last_error() << "\n";
+    return 3;
+  }
+  std::cerr << "[Servidor] escuchando en " << socket_path << " (" << num_workers
+            << " hilos, máximo " << max_connections << " conexiones, " << max_steps_limit
+            << " pasos por palabra)\n";
+
+  server.run(&stop_requested);
+
+  std::cerr << "[Servidor] detenido: " << server.get_requests_served() << " peticiones, "
+            << server.get_words_served() << " palabras\n";
+  return 0;
 }
 
 /**
- * @brief Verifica si una palabra contiene solo símbolos válidos del alfabeto (multicinta)
- * @param w Palabra a verificar
- * @param machine Máquina de Turing multicinta con el alfabeto
- * @param bad Puntero para almacenar el símbolo inválido (opcional)
- * @return true si la palabra es válida
+ * @brief Compila una máquina a imagen binaria: mt-sim compile <fichero> [-o <salida.tmb>]
+ * @param argc Número de argumentos
+ * @param argv Argumentos (argv[1] es compile)
+ * @return Código de salida
  */
-static bool word_in_alphabet_multi(const std::string& w, const MultiTuringMachine& machine,
-                                   std::string* bad = nullptr) {
-  for (char c : w) {
-    if (!machine.is_input_symbol(c)) {
-      if (bad) {
-        *bad = std::string(1, c);
+static int run_compile(int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "[Error] Uso: " << argv[0] << " compile <fichero_maquina> [-o <salida.tmb>]\n";
+    return 1;
+  }
+  std::string input_path = argv[2];
+  std::string output_path;
+  for (int i = 3; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "-o") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta ruta después de -o\n";
+        return 1;
       }
-      return false;
+      output_path = argv[++i];
+    } else {
+      std::cerr << "[Aviso] Opción desconocida: " << arg << "\n";
     }
   }
-  return true;
+  if (output_path.empty()) {
+    size_t dot = input_path.find_last_of('.');
+    size_t slash = input_path.find_last_of('/');
+    bool has_extension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+    output_path = (has_extension ? input_path.substr(0, dot) : input_path) + ".tmb";
+  }
+
+  TuringMachine machine;
+  MultiTuringMachine multi_machine(1);
+  bool is_multi_tape = false;
+  CompiledMachine compiled;
+  try {
+    if (!Parser::load_auto_detect(input_path, machine, multi_machine, is_multi_tape)) {
+      std::cerr << "[Error carga] " << Parser::get_last_error() << "\n";
+      return 2;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "[Error carga] " << e.what() << "\n";
+    return 2;
+  }
+  bool ok = is_multi_tape ? compiled.compile(multi_machine) : compiled.compile(machine);
+  if (!ok) {
+    std::cerr << "[Error carga] " << compiled.get_last_error() << "\n";
+    return 2;
+  }
+  if (!compiled.save_image(output_path)) {
+    std::cerr << "[Error] No se puede escribir la imagen: " << output_path << "\n";
+    return 3;
+  }
+
+  std::cerr << "[Compilado] " << output_path << ": " << compiled.get_num_states() << " estados, "
+            << compiled.get_transition_count() << " transiciones, "
+            << compiled.get_num_tapes() << (compiled.get_num_tapes() == 1 ? " cinta" : " cintas")
+            << ", tabla " << (compiled.is_dense() ? "densa" : "de huellas") << "\n";
+  return 0;
 }
 
 /**
@@ -74,14 +262,46 @@ static bool word_in_alphabet_multi(const std::string& w, const MultiTuringMachin
  */
 static void show_help(const char* program_name) {
   std::cout << "Uso: " << program_name << " <fichero_maquina> [opciones]\n"
+            << "     " << program_name << " compile <fichero_maquina> [-o <salida.tmb>]\n"
+            << "     " << program_name << " --serve <socket> [--workers N] [--max-connections N]\n"
+            << "                  [--max-steps-limit N] [--idle-timeout S]\n"
             << "Opciones:\n"
             << "  --trace              Muestra traza paso a paso\n"
             << "  --words <fichero>    Lee palabras de un fichero (una por línea)\n"
             << "  --strict             Error si la palabra contiene símbolos fuera del alfabeto\n"
             << "  --max-steps <N>      Límite de pasos de la simulación (0 = sin límite)\n"
+            << "  --output <formato>   Formato de resultados: text, jsonl, tsv o binary\n"
+            << "  --no-tape            No incluye el contenido final de las cintas\n"
+            << "  --cache <N>          Memoriza hasta N resultados de palabras repetidas\n"
+            << "  --cache-file <f>     Caché persistente en disco (implica --cache 65536)\n"
+            << "  --profile            Informe de transiciones, estados y celdas más usados\n"
+            << "  --profile-top <N>    Entradas de cada clasificación del informe (por defecto 10)\n"
+            << "  --profile-collapsed <f>  Escribe pilas colapsadas para flame graphs (implica --profile)\n"
+            << "  --tape-stats <f>     Exporta el uso de las cintas a CSV o JSON (.json); requiere\n"
+            << "                       compilar con make TAPE_STATS=1\n"
+            << "  --timeout-ms <N>     Plazo de reloj por palabra en ms (TIMEOUT al agotarse)\n"
+            << "  --batch-timeout-ms <N>  Plazo de reloj de todo el lote en ms; las palabras que\n"
+            << "                       quedan se dan como TIMEOUT sin simularlas\n"
+            << "  --checkpoint <f>     Guarda periódicamente el estado de la simulación en curso\n"
+            << "  --checkpoint-steps <N>    Punto de control cada N pasos\n"
+            << "  --checkpoint-seconds <T>  Punto de control cada T segundos (por defecto 60)\n"
+            << "  --resume <f>         Continúa la simulación de un punto de control\n"
+            << "  --latency            Percentiles de tiempo y pasos por palabra y resultado\n"
+            << "  --slowest <K>        Lista las K palabras más lentas (implica --latency)\n"
+            << "  --deciders <lista>   Decisores de no parada antes de simular (monocinta):\n"
+            << "                       backward, ctl, bouncer separados por comas, o all\n"
+            << "  --decider-steps <N>  Trabajo máximo de cada decisor por palabra (por defecto 100000)\n"
+            << "  --decider-ms <T>     Tiempo máximo de cada decisor por palabra (por defecto 50; 0 = sin plazo)\n"
+            << "  --jobs <N>           Simula las palabras con N hilos (resultados en orden)\n"
+            << "  --slice-steps <K>    Pasos de cada tramo de una palabra con --jobs (por defecto 65536)\n"
+            << "  --tape-backing <b>   Dónde guardar las cintas: memory (por defecto) o file:<ruta>,\n"
+            << "                       fichero disperso proyectado en memoria (cintas enormes)\n"
+            << "  --debug <palabra>    Depurador interactivo (órdenes por la entrada estándar)\n"
             << "  --info               Muestra información de la máquina y termina\n"
             << "  --help               Muestra esta ayuda\n\n"
             << "Si no se especifica --words, lee palabras desde la entrada estándar.\n"
+            << "El fichero de máquina puede ser texto o una imagen compilada (.tmb).\n"
+            << "Con --serve atiende peticiones por un socket Unix (ver tools/mt-client).\n"
             << "Una línea vacía representa la palabra vacía (épsilon).\n";
 }
 
@@ -90,6 +310,12 @@ int main(int argc, char** argv) {
     show_help(argv[0]);
     return 1;
   }
+  if (std::string(argv[1]) == "--serve") {
+    return run_server(argc, argv);
+  }
+  if (std::string(argv[1]) == "compile") {
+    return run_compile(argc, argv);
+  }
   
   std::string machine_path = argv[1];
 
@@ -99,6 +325,28 @@ int main(int argc, char** argv) {
   bool show_info = false;
   std::optional<std::string> words_path;
   size_t max_steps = 1000;  // Por defecto, límite de 1000 pasos
+  OutputFormat output_format = OutputFormat::TEXT;
+  bool show_tape = true;
+  size_t cache_size = 0;
+  std::optional<std::string> cache_path;
+  bool profile = false;
+  size_t profile_top = 10;
+  std::optional<std::string> profile_collapsed_path;
+  std::optional<std::string> tape_stats_path;
+  bool latency = false;
+  size_t slowest = 0;
+  size_t word_timeout_ms = 0;   // 0 = sin plazo por palabra
+  size_t batch_timeout_ms = 0;  // 0 = sin plazo del lote
+  std::optional<std::string> checkpoint_path;
+  size_t checkpoint_steps = 0;
+  size_t checkpoint_seconds = 0;
+  std::optional<std::string> resume_path;
+  std::optional<std::string> debug_word;
+  std::optional<std::string> deciders_list;
+  std::optional<std::string> tape_file;
+  DeciderBudget decider_budget;
+  size_t jobs = 1;
+  size_t slice_steps = BatchScheduler::DEFAULT_SLICE_STEPS;
 
   // Parseo de opciones
   for (int i = 2; i < argc; ++i) {
@@ -110,6 +358,17 @@ int main(int argc, char** argv) {
       strict_mode = true;
     } else if (arg == "--info") {
       show_info = true;
+    } else if (arg == "--no-tape") {
+      show_tape = false;
+    } else if (arg == "--output") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta formato después de --output\n";
+        return 1;
+      }
+      if (!ResultWriter::parse_format(argv[++i], output_format)) {
+        std::cerr << "[Error] --output requiere text, jsonl, tsv o binary\n";
+        return 1;
+      }
     } else if (arg == "--help") {
       show_help(argv[0]);
       return 0;
@@ -119,6 +378,173 @@ int main(int argc, char** argv) {
         return 1;
       }
       words_path = argv[++i];
+    } else if (arg == "--cache") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta N después de --cache\n";
+        return 1;
+      }
+      try {
+        long long v = std::stoll(argv[++i]);
+        if (v < 0) {
+          throw std::invalid_argument("negativo");
+        }
+        cache_size = static_cast<size_t>(v);
+      } catch (...) {
+        std::cerr << "[Error] --cache requiere un entero >= 0\n";
+        return 1;
+      }
+    } else if (arg == "--profile") {
+      profile = true;
+    } else if (arg == "--profile-collapsed") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta ruta después de --profile-collapsed\n";
+        return 1;
+      }
+      profile = true;
+      profile_collapsed_path = argv[++i];
+    } else if (arg == "--profile-top") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta N después de --profile-top\n";
+        return 1;
+      }
+      try {
+        long long v = std::stoll(argv[++i]);
+        if (v <= 0) {
+          throw std::invalid_argument("no positivo");
+        }
+        profile_top = static_cast<size_t>(v);
+      } catch (...) {
+        std::cerr << "[Error] --profile-top requiere un entero > 0\n";
+        return 1;
+      }
+    } else if (arg == "--timeout-ms" || arg == "--batch-timeout-ms") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta N después de " << arg << "\n";
+        return 1;
+      }
+      try {
+        long long v = std::stoll(argv[++i]);
+        if (v <= 0) {
+          throw std::invalid_argument("no positivo");
+        }
+        (arg == "--timeout-ms" ? word_timeout_ms : batch_timeout_ms) = static_cast<size_t>(v);
+      } catch (...) {
+        std::cerr << "[Error] " << arg << " requiere un entero > 0\n";
+        return 1;
+      }
+    } else if (arg == "--debug") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta palabra después de --debug (\"\" para la vacía)\n";
+        return 1;
+      }
+      debug_word = argv[++i];
+    } else if (arg == "--checkpoint" || arg == "--resume") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta ruta después de " << arg << "\n";
+        return 1;
+      }
+      (arg == "--checkpoint" ? checkpoint_path : resume_path) = argv[++i];
+    } else if (arg == "--checkpoint-steps" || arg == "--checkpoint-seconds") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta N después de " << arg << "\n";
+        return 1;
+      }
+      try {
+        long long v = std::stoll(argv[++i]);
+        if (v <= 0) {
+          throw std::invalid_argument("no positivo");
+        }
+        (arg == "--checkpoint-steps" ? checkpoint_steps : checkpoint_seconds) = static_cast<size_t>(v);
+      } catch (...) {
+        std::cerr << "[Error] " << arg << " requiere un entero > 0\n";
+        return 1;
+      }
+    } else if (arg == "--deciders") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta lista después de --deciders\n";
+        return 1;
+      }
+      deciders_list = argv[++i];
+    } else if (arg == "--tape-backing") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta respaldo después de --tape-backing\n";
+        return 1;
+      }
+      std::string backing = argv[++i];
+      if (backing == "memory") {
+        tape_file.reset();
+      } else if (backing.rfind("file:", 0) == 0 && backing.size() > 5) {
+        tape_file = backing.substr(5);
+      } else {
+        std::cerr << "[Error] --tape-backing requiere memory o file:<ruta>\n";
+        return 1;
+      }
+    } else if (arg == "--decider-steps" || arg == "--decider-ms") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta N después de " << arg << "\n";
+        return 1;
+      }
+      try {
+        long long v = std::stoll(argv[++i]);
+        if (v < 0 || (v == 0 && arg == "--decider-steps")) {
+          throw std::invalid_argument("fuera de rango");
+        }
+        (arg == "--decider-steps" ? decider_budget.steps : decider_budget.milliseconds) =
+            static_cast<uint64_t>(v);
+      } catch (...) {
+        std::cerr << "[Error] " << arg << " requiere un entero "
+                  << (arg == "--decider-steps" ? "> 0" : ">= 0") << "\n";
+        return 1;
+      }
+    } else if (arg == "--jobs" || arg == "--slice-steps") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta N después de " << arg << "\n";
+        return 1;
+      }
+      try {
+        long long v = std::stoll(argv[++i]);
+        if (v <= 0) {
+          throw std::invalid_argument("no positivo");
+        }
+        (arg == "--jobs" ? jobs : slice_steps) = static_cast<size_t>(v);
+      } catch (...) {
+        std::cerr << "[Error] " << arg << " requiere un entero > 0\n";
+        return 1;
+      }
+    } else if (arg == "--latency") {
+      latency = true;
+    } else if (arg == "--slowest") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta K después de --slowest\n";
+        return 1;
+      }
+      try {
+        long long v = std::stoll(argv[++i]);
+        if (v <= 0) {
+          throw std::invalid_argument("no positivo");
+        }
+        slowest = static_cast<size_t>(v);
+      } catch (...) {
+        std::cerr << "[Error] --slowest requiere un entero > 0\n";
+        return 1;
+      }
+      latency = true;
+    } else if (arg == "--tape-stats") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta ruta después de --tape-stats\n";
+        return 1;
+      }
+#ifndef TAPE_STATS
+      std::cerr << "[Error] --tape-stats requiere compilar con make TAPE_STATS=1\n";
+      return 1;
+#endif
+      tape_stats_path = argv[++i];
+    } else if (arg == "--cache-file") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta ruta después de --cache-file\n";
+        return 1;
+      }
+      cache_path = argv[++i];
     } else if (arg == "--max-steps") {
       if (i + 1 >= argc) {
         std::cerr << "[Error] Falta N después de --max-steps\n";
@@ -139,31 +565,49 @@ int main(int argc, char** argv) {
     }
   }
 
-  // Cargar la Máquina de Turing (detectar automáticamente si es multicinta)
+  // Cargar la Máquina de Turing: imagen compilada o texto (detectar
+  // automáticamente si es multicinta)
   TuringMachine machine;
   std::unique_ptr<MultiTuringMachine> multi_machine;
+  CompiledMachine compiled;
   bool is_multi_tape = false;
+  bool is_image = CompiledMachine::is_image_file(machine_path);
   
-  try {
-    // Intentar cargar como máquina multicinta primero
-    multi_machine = std::make_unique<MultiTuringMachine>(1); // Temporal, se reemplazará al cargar
-    if (Parser::load_multi_from_file(machine_path, *multi_machine)) {
-      is_multi_tape = true;
-    } else {
-      // Si falla, intentar cargar como máquina de una cinta
-      multi_machine.reset(); // Limpiar el puntero
-      if (!Parser::load_from_file(machine_path, machine)) {
+  if (is_image) {
+    // Imagen .tmb: se proyecta y se usa sin parsear
+    if (!compiled.load_image(machine_path)) {
+      std::cerr << "[Error carga] " << compiled.get_last_error() << "\n";
+      return 2;
+    }
+    is_multi_tape = compiled.is_multi_tape();
+  } else {
+    try {
+      // Una sola lectura: el Parser detecta el tipo por la cabecera
+      multi_machine = std::make_unique<MultiTuringMachine>(1); // El número de cintas lo fija el archivo
+      if (!Parser::load_auto_detect(machine_path, machine, *multi_machine, is_multi_tape)) {
         std::cerr << "[Error carga] " << Parser::get_last_error() << "\n";
         return 2;
       }
+      if (!is_multi_tape) {
+        multi_machine.reset();
+      }
+    } catch (const std::exception& e) {
+      std::cerr << "[Error carga] " << e.what() << "\n";
+      return 2;
     }
-  } catch (const std::exception& e) {
-    std::cerr << "[Error carga] " << e.what() << "\n";
-    return 2;
   }
 
   // Si se solicita información, mostrarla y terminar
   if (show_info) {
+    if (is_image) {
+      // La definición se reconstruye desde la imagen solo para mostrarla
+      if (is_multi_tape) {
+        multi_machine = std::make_unique<MultiTuringMachine>(1);
+        compiled.to_multi_machine(*multi_machine);
+      } else {
+        compiled.to_machine(machine);
+      }
+    }
     if (is_multi_tape) {
       std::cout << "=== MÁQUINA DE TURING MULTICINTA ===" << std::endl;
       std::cout << multi_machine->get_info() << std::endl;
@@ -174,119 +618,639 @@ int main(int argc, char** argv) {
     return 0;
   }
 
-  // Crear el simulador apropiado
+  // Compilar la definición de texto (la imagen ya está compilada)
+  if (!is_image) {
+    bool ok = is_multi_tape ? compiled.compile(*multi_machine) : compiled.compile(machine);
+    if (!ok) {
+      std::cerr << "[Error carga] " << compiled.get_last_error() << "\n";
+      return 2;
+    }
+  }
+
+  // Crear el simulador apropiado sobre la máquina compilada
   std::unique_ptr<Simulator> simulator;
   std::unique_ptr<MultiSimulator> multi_simulator;
   
   if (is_multi_tape) {
-    multi_simulator = std::make_unique<MultiSimulator>(multi_machine.get());
+    multi_simulator = std::make_unique<MultiSimulator>(&compiled);
   } else {
-    simulator = std::make_unique<Simulator>(&machine);
+    simulator = std::make_unique<Simulator>(&compiled);
   }
 
-  // Fuente de palabras: fichero o stdin
-  std::unique_ptr<std::istream> file_in;
-  std::istream* in = &std::cin;
-  
-  if (words_path.has_value()) {
-    file_in = std::make_unique<std::ifstream>(words_path.value());
-    if (!*file_in) {
-      std::cerr << "[Error] No se puede abrir fichero de palabras: "
-                << words_path.value() << "\n";
+  // Cintas en un fichero proyectado: se reutiliza para todas las palabras
+  if (tape_file.has_value()) {
+    bool ok = is_multi_tape ? multi_simulator->set_tape_file(tape_file.value())
+                            : simulator->set_tape_file(tape_file.value());
+    if (!ok) {
+      std::cerr << "[Error] " << (is_multi_tape ? multi_simulator->get_last_error() : simulator->get_last_error())
+                << "\n";
+      return 1;
+    }
+  }
+
+  // Decisores de no parada: se prueban al empezar cada palabra, antes de simular
+  std::unique_ptr<DeciderPipeline> deciders;
+  if (deciders_list.has_value()) {
+    if (is_multi_tape) {
+      std::cerr << "[Aviso] --deciders solo se aplica a máquinas monocinta\n";
+    } else {
+      deciders = std::make_unique<DeciderPipeline>(&compiled);
+      if (!deciders->set_deciders(deciders_list.value())) {
+        std::cerr << "[Error] " << deciders->get_last_error() << "\n";
+        return 1;
+      }
+      deciders->set_budget(decider_budget);
+      simulator->set_deciders(deciders.get());
+    }
+  }
+
+  // Depurador: Ctrl-C interrumpe la orden en curso, no la sesión
+  if (debug_word.has_value()) {
+    Debugger debugger(simulator.get(), multi_simulator.get());
+    if (!debugger.start(debug_word.value())) {
+      std::cerr << "[Error simulación] " << debugger.get_last_error() << "\n";
+      return 1;
+    }
+    struct sigaction action{};
+    action.sa_handler = handle_interrupt_signal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    debugger.set_cancellation_token(&interrupt_request);
+    debugger.run_repl(std::cin, std::cout);
+    return 0;
+  }
+
+  // En los formatos estructurados la traza no se imprime: mezclaría texto libre
+  // con los registros
+  std::unique_ptr<ResultWriter> writer;
+  if (output_format != OutputFormat::TEXT) {
+    if (trace) {
+      std::cerr << "[Aviso] --trace se ignora con --output distinto de text\n";
+      trace = false;
+    }
+    writer = std::make_unique<ResultWriter>(output_format, show_tape);
+  }
+
+  // Perfil de ejecución: contadores indexados por la forma compilada
+  std::unique_ptr<Profiler> profiler;
+  if (profile) {
+    profiler = std::make_unique<Profiler>(&compiled, profile_collapsed_path.has_value());
+    if (is_multi_tape) {
+      multi_simulator->set_profiler(profiler.get());
+    } else {
+      simulator->set_profiler(profiler.get());
+    }
+  }
+
+  // Estadísticas de uso de las cintas: solo existen si Tape se compiló con
+  // TAPE_STATS
+  std::vector<TapeStats> tape_stats;
+#ifdef TAPE_STATS
+  if (tape_stats_path.has_value()) {
+    tape_stats.resize(compiled.get_num_tapes());
+    if (is_multi_tape) {
+      multi_simulator->set_tape_stats(tape_stats.data());
+    } else {
+      simulator->set_tape_stats(tape_stats.data());
+    }
+  }
+#endif
+
+  // Puntos de control: el estado guardado solo vale para el mismo fichero de
+  // máquina. La traza no se guarda en ellos, así que no se admite
+  bool checkpointing = checkpoint_path.has_value();
+  std::optional<Checkpoint> resume_point;
+  uint64_t machine_digest = 0;
+  if (checkpointing || resume_path.has_value()) {
+    std::string error;
+    if (!machine_file_digest(machine_path, machine_digest, error)) {
+      std::cerr << "[Error] " << error << "\n";
+      return 3;
+    }
+    if (checkpointing && checkpoint_steps == 0 && checkpoint_seconds == 0) {
+      checkpoint_seconds = 60;
+    }
+    if (trace) {
+      std::cerr << "[Aviso] --trace se ignora con " << (checkpointing ? "--checkpoint" : "--resume") << "\n";
+      trace = false;
+    }
+  }
+  if (resume_path.has_value()) {
+    Checkpoint checkpoint;
+    std::string error;
+    if (!checkpoint.load(resume_path.value(), error)) {
+      std::cerr << "[Error] " << error << "\n";
       return 3;
     }
-    in = file_in.get();
+    if (checkpoint.machine_digest != machine_digest) {
+      std::cerr << "[Error carga] El punto de control es de otra máquina: " << resume_path.value() << "\n";
+      return 2;
+    }
+    // La ejecución continúa con los mismos parámetros con que empezó
+    max_steps = static_cast<size_t>(checkpoint.max_steps);
+    resume_point = std::move(checkpoint);
   }
 
-  // Procesar palabras
-  std::string line;
-  while (std::getline(*in, line)) {
-    // Permitir espacios alrededor, línea vacía = palabra vacía (épsilon)
-    std::string word = strip_spaces(line);
+  // Caché de resultados: la traza, el perfil, las estadísticas de cinta y los
+  // puntos de control exigen simular cada palabra, así que la anulan; los
+  // certificados de los decisores tampoco se guardan en ella
+  std::unique_ptr<ResultCache> cache;
+  if (cache_path.has_value() && cache_size == 0) {
+    cache_size = 65536;
+  }
+  if (cache_size > 0 && (trace || profile || tape_stats_path.has_value() || checkpointing ||
+                         resume_point.has_value() || deciders)) {
+    std::cerr << "[Aviso] --cache se ignora con "
+              << (trace ? "--trace" : profile ? "--profile" : tape_stats_path.has_value() ? "--tape-stats"
+                  : checkpointing ? "--checkpoint" : resume_point.has_value() ? "--resume" : "--deciders")
+              << "\n";
+  } else if (cache_size > 0) {
+    cache = std::make_unique<ResultCache>(cache_size);
+    if (cache_path.has_value()) {
+      // Los registros del disco solo valen para este mismo fichero de máquina
+      uint64_t digest = 0;
+      std::string error;
+      if (!machine_file_digest(machine_path, digest, error)) {
+        std::cerr << "[Error] " << error << "\n";
+        return 3;
+      }
+      if (!cache->open_disk(cache_path.value(), digest)) {
+        std::cerr << "[Error] " << cache->get_last_error() << "\n";
+        return 3;
+      }
+    }
+  }
 
-    // Validación del alfabeto según el tipo de máquina
-    std::string bad_symbol;
-    bool valid_word = false;
-    
+  // Latencia por palabra: el reloj solo se consulta si se pidió
+  std::unique_ptr<LatencyReport> latency_report;
+  if (latency) {
+    latency_report = std::make_unique<LatencyReport>(slowest);
+  }
+  std::chrono::steady_clock::time_point word_start;
+
+  // Presupuesto de tiempo: plazo por palabra, plazo del lote y cancelación por
+  // señal. Sin presupuesto, SIGINT conserva su efecto por defecto
+  bool time_budget = word_timeout_ms > 0 || batch_timeout_ms > 0;
+  auto batch_deadline = std::chrono::steady_clock::time_point::max();
+  size_t words_out_of_time = 0;
+  bool batch_cancelled = false;
+  if (time_budget) {
+    if (batch_timeout_ms > 0) {
+      batch_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(batch_timeout_ms);
+    }
+    // SA_RESETHAND: una segunda señal termina el proceso como siempre
+    struct sigaction action{};
+    action.sa_handler = handle_interrupt_signal;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
     if (is_multi_tape) {
-      valid_word = word_in_alphabet_multi(word, *multi_machine, &bad_symbol);
+      multi_simulator->set_cancellation_token(&interrupt_request);
+    } else {
+      simulator->set_cancellation_token(&interrupt_request);
+    }
+  }
+
+  auto record_latency = [&](size_t index, std::string_view w, SimulationResult result, uint64_t steps) {
+    auto elapsed = std::chrono::steady_clock::now() - word_start;
+    latency_report->record(index, w, result,
+                           static_cast<uint64_t>(
+                               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                           steps);
+  };
+
+  // Lote en varios hilos: cada palabra avanza por tramos de slice_steps pasos
+  // y los resultados salen en orden. Lo que necesita ver cada palabra en el
+  // hilo principal (traza, perfil, estadísticas, puntos de control, caché,
+  // latencia) se queda en un hilo
+  std::unique_ptr<BatchScheduler> scheduler;
+  if (jobs > 1) {
+    const char* conflict = trace ? "--trace" : profile ? "--profile" : tape_stats_path.has_value() ? "--tape-stats"
+                           : checkpointing ? "--checkpoint" : resume_point.has_value() ? "--resume"
+                           : cache ? "--cache" : latency_report ? "--latency"
+                           : tape_file.has_value() ? "--tape-backing" : nullptr;
+    if (conflict != nullptr) {
+      std::cerr << "[Aviso] --jobs se ignora con " << conflict << "\n";
     } else {
-      valid_word = word_in_alphabet(word, machine, &bad_symbol);
+      scheduler = std::make_unique<BatchScheduler>(&compiled, jobs, slice_steps);
+      scheduler->set_max_steps(max_steps);
+      if (deciders) {
+        std::string error;
+        if (!scheduler->set_deciders(deciders_list.value(), decider_budget, error)) {
+          std::cerr << "[Error] " << error << "\n";
+          return 1;
+        }
+      }
+      if (time_budget) {
+        scheduler->set_word_timeout(std::chrono::milliseconds(word_timeout_ms));
+        scheduler->set_batch_deadline(batch_deadline);
+        scheduler->set_cancellation_token(&interrupt_request);
+      }
+    }
+  }
+
+  // Fuente de palabras: fichero (proyectado en memoria) o stdin
+  WordReader reader;
+  if (words_path.has_value()) {
+    if (!reader.open_file(words_path.value())) {
+      std::cerr << "[Error] " << reader.get_last_error() << "\n";
+      return 3;
+    }
+  } else if (!resume_point.has_value()) {
+    reader.open_stdin();
+  }
+
+  // Con --resume y sin --words solo se continúa la palabra del punto de control
+  bool resume_only = resume_point.has_value() && !words_path.has_value();
+  bool resume_only_done = false;
+  auto next_word = [&](std::string_view& w) {
+    if (!resume_only) {
+      return reader.next(w);
+    }
+    if (resume_only_done) {
+      return false;
+    }
+    resume_only_done = true;
+    w = resume_point->word;
+    return true;
+  };
+
+  // Simulación por tramos de CHECKPOINT_SLICE pasos: entre tramos se escribe
+  // el punto de control cuando toca
+  auto run_checkpointed = [&](auto& sim, std::string_view w, size_t index,
+                              const Checkpoint* resume_from) {
+    bool ready = resume_from != nullptr ? sim.restore_checkpoint(*resume_from)
+                                        : sim.start_validated(w, false, max_steps);
+    if (!ready) {
+      return SimulationResult::ERROR;
+    }
+    auto last_save = std::chrono::steady_clock::now();
+    size_t last_save_steps = sim.get_step_count();
+    while (true) {
+      size_t budget = CHECKPOINT_SLICE;
+      if (checkpointing && checkpoint_steps > 0) {
+        budget = std::min(budget, last_save_steps + checkpoint_steps - sim.get_step_count());
+      }
+      std::optional<SimulationResult> finished = sim.run(budget);
+      if (finished.has_value()) {
+        return finished.value();
+      }
+      if (!checkpointing) {
+        continue;
+      }
+      auto now = std::chrono::steady_clock::now();
+      bool due = (checkpoint_steps > 0 && sim.get_step_count() - last_save_steps >= checkpoint_steps) ||
+                 (checkpoint_seconds > 0 && now - last_save >= std::chrono::seconds(checkpoint_seconds));
+      if (!due) {
+        continue;
+      }
+      Checkpoint checkpoint;
+      sim.save_checkpoint(checkpoint);
+      checkpoint.machine_digest = machine_digest;
+      checkpoint.word_index = index;
+      checkpoint.word = std::string(w);
+      std::string error;
+      if (!checkpoint.save(checkpoint_path.value(), error)) {
+        std::cerr << "[Aviso] " << error << "\n";
+      }
+      last_save = now;
+      last_save_steps = sim.get_step_count();
+    }
+  };
+
+  // Salida del resultado de una palabra simulada (registro o texto)
+  auto report = [&](size_t index, std::string_view w, SimulationResult result, Simulator* sim,
+                    MultiSimulator* multi_sim) {
+    // Formatos estructurados: un registro por palabra en el buffer de salida
+    if (writer) {
+      if (multi_sim != nullptr) {
+        writer->write_record(index, result, multi_sim->get_step_count(),
+                             &multi_sim->get_current_configuration());
+      } else {
+        writer->write_record(index, result, sim->get_step_count(),
+                             &sim->get_current_configuration());
+      }
+      if (result == SimulationResult::ERROR) {
+        std::cerr << "[Error simulación] "
+                  << (multi_sim != nullptr ? multi_sim->get_last_error() : sim->get_last_error()) << "\n";
+      }
+      return;
+    }
+
+    // Mostrar el resultado
+    std::cout << Simulator::result_to_string(result) << "\n";
+    
+    // Mostrar el estado final de la cinta/cintas (salvo con --no-tape)
+    if (show_tape && multi_sim != nullptr) {
+      const auto& config = multi_sim->get_current_configuration();
+      const auto& tapes = config.get_tapes();
+      std::cout << "Cintas finales:\n";
+      for (size_t i = 0; i < tapes.get_num_tapes(); ++i) {
+        std::cout << "  Cinta " << (i+1) << ": " << tapes.get_tape(i).to_string(20) << "\n";
+      }
+    } else if (show_tape) {
+      const auto& config = sim->get_current_configuration();
+      std::cout << "Cinta final: " << config.get_tape().to_string(20) << "\n";
+    }
+    
+    // Si está habilitada la traza, mostrarla
+    if (trace) {
+      std::cout << "\n=== Traza de ejecución para \"" << w << "\" ===\n";
+      if (multi_sim != nullptr) {
+        multi_sim->print_trace(true);
+      } else {
+        sim->print_trace(true);
+      }
+      std::cout << "=== Fin de traza ===\n\n";
     }
     
-    if (!valid_word) {
+    // Mostrar información adicional para casos especiales
+    if (result == SimulationResult::INFINITE) {
+      std::cout << "[Info] Simulación detenida: ";
+      InfiniteProof proof = multi_sim != nullptr ? multi_sim->get_infinite_proof() : sim->get_infinite_proof();
+      if (proof != InfiniteProof::NONE) {
+        std::cout << "bucle infinito detectado (" << Simulator::proof_to_string(proof);
+        if (multi_sim == nullptr && !sim->get_infinite_certificate().empty()) {
+          std::cout << ": " << sim->get_infinite_certificate();
+        }
+        std::cout << ")\n";
+      } else {
+        std::cout << "límite de pasos alcanzado (" << max_steps << ")\n";
+      }
+    } else if (result == SimulationResult::TIMEOUT) {
+      std::cout << "[Info] Simulación detenida: "
+                << (interrupt_request.is_cancelled() ? "cancelada" : "plazo de tiempo agotado") << "\n";
+    } else if (result == SimulationResult::ERROR) {
+      std::string error_msg = multi_sim != nullptr ? multi_sim->get_last_error() : sim->get_last_error();
+      std::cerr << "[Error simulación] " << error_msg << "\n";
+    }
+  };
+
+  // Salida de una palabra del lote en varios hilos, ya en orden
+  auto report_job = [&](BatchScheduler::Job& job) {
+    if (!job.simulated) {
+      if (job.result == SimulationResult::TIMEOUT) {
+        words_out_of_time++;
+      } else if (strict_mode) {
+        std::cerr << "[Error palabra] símbolo fuera del alfabeto: '"
+                  << job.bad_symbol << "' en \"" << job.word << "\"\n";
+      }
+      if (writer) {
+        write_unsimulated_record(*writer, job.index, job.result, is_multi_tape);
+      } else {
+        std::cout << Simulator::result_to_string(job.result) << "\n";
+      }
+      return;
+    }
+    if (!job.error.empty()) {
+      std::cerr << "[Error simulación] " << job.error << "\n";
+      if (writer) {
+        write_unsimulated_record(*writer, job.index, SimulationResult::ERROR, is_multi_tape);
+      } else {
+        std::cout << "ERROR\n";
+      }
+      return;
+    }
+    report(job.index, job.word, job.result, job.simulator.get(), job.multi_simulator.get());
+  };
+
+  // Procesar palabras (vistas sobre la entrada, sin copias)
+  // Se permiten espacios alrededor, línea vacía = palabra vacía (épsilon)
+  std::string_view word;
+  if (scheduler) {
+    // Se escribe cada resultado en cuanto terminan todas las palabras
+    // anteriores; con la ventana llena se espera a la más antigua
+    for (size_t word_index = 0; next_word(word); ++word_index) {
+      if (interrupt_request.is_cancelled()) {
+        batch_cancelled = true;
+        break;
+      }
+      while (scheduler->has_ready() || scheduler->is_full()) {
+        report_job(*scheduler->next());
+      }
+      std::string bad_symbol;
+      if (word_in_alphabet(word, compiled, &bad_symbol)) {
+        scheduler->submit(word_index, word);
+      } else {
+        scheduler->submit_result(word_index, word, SimulationResult::REJECTED, bad_symbol);
+      }
+    }
+    while (scheduler->has_pending()) {
+      report_job(*scheduler->next());
+    }
+  }
+  size_t first_index = resume_only ? static_cast<size_t>(resume_point->word_index) : 0;
+  for (size_t word_index = first_index; !scheduler && next_word(word); ++word_index) {
+    if (interrupt_request.is_cancelled()) {
+      batch_cancelled = true;
+      break;
+    }
+
+    // Al continuar un lote, las palabras anteriores al punto de control ya
+    // tienen resultado
+    const Checkpoint* resume_from = nullptr;
+    if (resume_point.has_value() && word_index <= resume_point->word_index) {
+      if (word_index < resume_point->word_index) {
+        continue;
+      }
+      if (word != resume_point->word) {
+        std::cerr << "[Error] La palabra " << word_index
+                  << " de la entrada no es la del punto de control\n";
+        return 1;
+      }
+      resume_from = &resume_point.value();
+    }
+
+    // Validación del alfabeto según el tipo de máquina
+    std::string bad_symbol;
+    if (!word_in_alphabet(word, compiled, &bad_symbol)) {
       if (strict_mode) {
         std::cerr << "[Error palabra] símbolo fuera del alfabeto: '" 
                   << bad_symbol << "' en \"" << word << "\"\n";
-        std::cout << "REJECT\n";
-        continue;
+      }
+      // En modo no estricto la palabra simplemente no pertenece al lenguaje
+      if (writer) {
+        write_unsimulated_record(*writer, word_index, SimulationResult::REJECTED, is_multi_tape);
       } else {
-        // Modo no estricto: la palabra simplemente no pertenece al lenguaje
         std::cout << "REJECT\n";
-        continue;
       }
+      continue;
     }
 
     // Simular la máquina con la palabra
-    try {
-      SimulationResult result;
-      
-      if (is_multi_tape) {
-        result = multi_simulator->simulate(word, trace, max_steps);
-      } else {
-        result = simulator->simulate(word, trace, max_steps);
+    if (latency_report || time_budget) {
+      word_start = std::chrono::steady_clock::now();
+    }
+    if (time_budget) {
+      // Agotado el plazo del lote, el resto de palabras no se simula
+      if (word_start >= batch_deadline) {
+        words_out_of_time++;
+        if (writer) {
+          write_unsimulated_record(*writer, word_index, SimulationResult::TIMEOUT, is_multi_tape);
+        } else {
+          std::cout << "TIMEOUT\n";
+        }
+        continue;
+      }
+      auto deadline = batch_deadline;
+      if (word_timeout_ms > 0) {
+        deadline = std::min(deadline, word_start + std::chrono::milliseconds(word_timeout_ms));
       }
-      
-      // Mostrar el resultado
-      std::cout << Simulator::result_to_string(result) << "\n";
-      
-      // Mostrar el estado final de la cinta/cintas
       if (is_multi_tape) {
-        const auto& config = multi_simulator->get_current_configuration();
-        const auto& tapes = config.get_tapes();
-        std::cout << "Cintas finales:\n";
-        for (size_t i = 0; i < tapes.get_num_tapes(); ++i) {
-          std::cout << "  Cinta " << (i+1) << ": " << tapes.get_tape(i).to_string(20) << "\n";
-        }
+        multi_simulator->set_deadline(deadline);
       } else {
-        const auto& config = simulator->get_current_configuration();
-        std::cout << "Cinta final: " << config.get_tape().to_string(20) << "\n";
+        simulator->set_deadline(deadline);
       }
-      
-      // Si está habilitada la traza, mostrarla
-      if (trace) {
-        std::cout << "\n=== Traza de ejecución para \"" << word << "\" ===\n";
-        if (is_multi_tape) {
-          multi_simulator->print_trace(true);
-        } else {
-          simulator->print_trace(true);
+    }
+    try {
+      SimulationResult result;
+
+      if (cache) {
+        // Con caché solo se conserva la huella de las cintas, tanto en los
+        // aciertos como en los fallos, para que la salida no dependa de ella
+        CachedResult cached;
+        if (!cache->lookup(word, max_steps, cached)) {
+          if (is_multi_tape) {
+            cached.result = multi_simulator->simulate_validated(word, false, max_steps);
+            cached.steps = multi_simulator->get_step_count();
+            cached.proof = multi_simulator->get_infinite_proof();
+          } else {
+            cached.result = simulator->simulate_validated(word, false, max_steps);
+            cached.steps = simulator->get_step_count();
+            cached.proof = simulator->get_infinite_proof();
+          }
+          cached.tape_digest = final_tape_digest(simulator.get(), multi_simulator.get());
+          if (cached.result == SimulationResult::ERROR) {
+            std::cerr << "[Error simulación] "
+                      << (is_multi_tape ? multi_simulator->get_last_error()
+                                        : simulator->get_last_error()) << "\n";
+          } else if (cached.result != SimulationResult::TIMEOUT) {
+            // Un TIMEOUT depende del reloj, no de la palabra: no se memoriza
+            cache->store(word, cached);
+          }
         }
-        std::cout << "=== Fin de traza ===\n\n";
-      }
-      
-      // Mostrar información adicional para casos especiales
-      if (result == SimulationResult::INFINITE) {
-        std::cout << "[Info] Simulación detenida: ";
-        bool loop_detected = is_multi_tape ? 
-                            multi_simulator->is_infinite_loop_detected() :
-                            simulator->is_infinite_loop_detected();
-        if (loop_detected) {
-          std::cout << "bucle infinito detectado (configuración repetida)\n";
-        } else {
-          std::cout << "límite de pasos alcanzado (" << max_steps << ")\n";
+        if (latency_report) {
+          record_latency(word_index, word, cached.result, cached.steps);
+        }
+
+        if (writer) {
+          writer->write_digest_record(word_index, cached.result, cached.steps, cached.tape_digest);
+          continue;
+        }
+        std::cout << Simulator::result_to_string(cached.result) << "\n";
+        if (show_tape) {
+          std::cout << "Huella de cinta: " << ResultWriter::digest_to_string(cached.tape_digest) << "\n";
         }
-      } else if (result == SimulationResult::ERROR) {
-        std::string error_msg = is_multi_tape ? 
-                               multi_simulator->get_last_error() :
-                               simulator->get_last_error();
-        std::cerr << "[Error simulación] " << error_msg << "\n";
+        if (cached.result == SimulationResult::INFINITE) {
+          std::cout << "[Info] Simulación detenida: ";
+          if (cached.proof != InfiniteProof::NONE) {
+            std::cout << "bucle infinito detectado (" << Simulator::proof_to_string(cached.proof) << ")\n";
+          } else {
+            std::cout << "límite de pasos alcanzado (" << max_steps << ")\n";
+          }
+        } else if (cached.result == SimulationResult::TIMEOUT) {
+          std::cout << "[Info] Simulación detenida: "
+                    << (interrupt_request.is_cancelled() ? "cancelada" : "plazo de tiempo agotado") << "\n";
+        }
+        continue;
+      }
+
+      if (checkpointing || resume_from != nullptr) {
+        result = is_multi_tape ? run_checkpointed(*multi_simulator, word, word_index, resume_from)
+                               : run_checkpointed(*simulator, word, word_index, resume_from);
+      } else if (is_multi_tape) {
+        result = multi_simulator->simulate_validated(word, trace, max_steps);
+      } else {
+        result = simulator->simulate_validated(word, trace, max_steps);
+      }
+      if (latency_report) {
+        record_latency(word_index, word, result,
+                       is_multi_tape ? multi_simulator->get_step_count() : simulator->get_step_count());
       }
       
+      report(word_index, word, result, simulator.get(), multi_simulator.get());
     } catch (const std::exception& e) {
+      if (latency_report) {
+        record_latency(word_index, word, SimulationResult::ERROR, 0);
+      }
       std::cerr << "[Error simulación] " << e.what() << "\n";
-      std::cout << "ERROR\n";
+      if (writer) {
+        write_unsimulated_record(*writer, word_index, SimulationResult::ERROR, is_multi_tape);
+      } else {
+        std::cout << "ERROR\n";
+      }
     }
   }
 
-  return 0;
+  if (words_out_of_time > 0 || batch_cancelled) {
+    if (writer) {
+      writer->flush();
+    }
+    std::cout.flush();
+    if (words_out_of_time > 0) {
+      std::cerr << "[Aviso] plazo del lote agotado: " << words_out_of_time
+                << " palabras sin simular (TIMEOUT)\n";
+    }
+    if (batch_cancelled) {
+      std::cerr << "[Aviso] lote cancelado por señal: palabras restantes sin procesar\n";
+    }
+  }
+
+  // Un error de lectura termina la entrada como un fin de fichero: las
+  // palabras siguientes no se han procesado y el lote no cuenta como completo
+  bool read_failed = !reader.get_last_error().empty();
+  if (read_failed) {
+    if (writer) {
+      writer->flush();
+    }
+    std::cout.flush();
+    std::cerr << "[Error] " << reader.get_last_error() << "\n";
+  }
+
+  // El informe va a la salida de error para no mezclarse con los resultados
+  if (profiler) {
+    if (writer) {
+      writer->flush();
+    }
+    std::cout.flush();
+    profiler->print_report(std::cerr, profile_top);
+    if (profile_collapsed_path.has_value() &&
+        !profiler->write_collapsed(profile_collapsed_path.value())) {
+      std::cerr << "[Error] " << profiler->get_last_error() << "\n";
+      return 3;
+    }
+  }
+
+  if (latency_report) {
+    if (writer) {
+      writer->flush();
+    }
+    std::cout.flush();
+    latency_report->print_report(std::cerr);
+  }
+
+  if (tape_stats_path.has_value()) {
+    std::string error;
+    if (!TapeStats::export_file(tape_stats, tape_stats_path.value(), error)) {
+      std::cerr << "[Error] " << error << "\n";
+      return 3;
+    }
+  }
+
+  if (cache) {
+    std::cerr << "[Caché] aciertos: " << cache->get_hits()
+              << ", fallos: " << cache->get_misses();
+    if (cache_path.has_value()) {
+      std::cerr << ", desde disco: " << cache->get_disk_hits()
+                << ", nuevos en disco: " << cache->get_pending_entries();
+    }
+    std::cerr << "\n";
+    if (!cache->save_disk()) {
+      std::cerr << "[Error] " << cache->get_last_error() << "\n";
+      return 3;
+    }
+  }
+
+  return read_failed ? 3 : 0;
 }
\ No newline at end of file
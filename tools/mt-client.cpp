@@ -0,0 +1,202 @@
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Protocol.hpp"
+#include "Simulator.hpp"
+#include "WordReader.hpp"
+
+/**
+ * @brief Cliente de prueba del modo servidor de mt-sim
+ *
+ * Envía las palabras (de --words o de la entrada estándar) en lotes al servidor
+ * y escribe un resultado por línea: índice, resultado, pasos y, por cinta,
+ * cabezal y contenido, separados por tabuladores (como --output tsv).
+ */
+
+static void show_help(const char* program_name) {
+  std::cout << "Uso: " << program_name << " <socket> <fichero_maquina> [opciones]\n"
+            << "Opciones:\n"
+            << "  --words <fichero>    Lee palabras de un fichero (una por línea)\n"
+            << "  --max-steps <N>      Límite de pasos de la simulación (> 0; el servidor fija un máximo)\n"
+            << "  --batch <N>          Palabras por petición (por defecto 1000)\n"
+            << "  --no-tape            No pide el contenido final de las cintas\n"
+            << "  --help               Muestra esta ayuda\n";
+}
+
+/**
+ * @brief Conecta con el socket Unix del servidor
+ * @param path Ruta del socket
+ * @return Descriptor conectado o -1 si hubo error
+ */
+static int connect_to(const std::string& path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) {
+    std::cerr << "[Error] Ruta de socket demasiado larga: " << path << "\n";
+    return -1;
+  }
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+  int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+    std::cerr << "[Error] No se puede conectar a " << path << ": " << std::strerror(errno) << "\n";
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    return -1;
+  }
+  return fd;
+}
+
+/**
+ * @brief Envía un lote y escribe sus resultados
+ * @param fd Conexión con el servidor
+ * @param request Petición con el lote
+ * @param first_index Índice global de la primera palabra del lote
+ * @return true si el servidor respondió al lote completo
+ */
+static bool run_batch(int fd, const Protocol::Request& request, size_t first_index) {
+  Protocol::Encoder out;
+  Protocol::encode_request(out, request);
+  // Si el envío falla, el servidor pudo rechazar la conexión con un error:
+  // se intenta leer igualmente para mostrarlo
+  bool sent = Protocol::write_all(fd, out.data().data(), out.size());
+
+  std::vector<char> payload;
+  Protocol::Response response;
+  while (Protocol::read_frame(fd, payload)) {
+    if (!Protocol::decode_response(payload, response)) {
+      std::cerr << "[Error] Respuesta mal formada\n";
+      return false;
+    }
+    if (response.type == Protocol::RESPONSE_END) {
+      return true;
+    }
+    if (response.type == Protocol::RESPONSE_ERROR) {
+      std::cerr << response.message << "\n";
+      return false;
+    }
+    std::cout << (first_index + response.index) << "\t"
+              << Simulator::result_to_string(response.result) << "\t" << response.steps;
+    for (const Protocol::TapeResult& tape : response.tapes) {
+      std::cout << "\t" << tape.head << "\t" << tape.content;
+    }
+    std::cout << "\n";
+  }
+  std::cerr << (sent ? "[Error] El servidor cerró la conexión\n"
+                     : "[Error] No se pudo enviar la petición\n");
+  return false;
+}
+
+int main(int argc, char** argv) {
+  if (argc >= 2 && std::string(argv[1]) == "--help") {
+    show_help(argv[0]);
+    return 0;
+  }
+  if (argc < 3) {
+    show_help(argv[0]);
+    return 1;
+  }
+
+  std::string socket_path = argv[1];
+  Protocol::Request request;
+  std::optional<std::string> words_path;
+  size_t batch_size = 1000;
+
+  // El servidor identifica las máquinas por ruta: se envía la ruta absoluta
+  // para que el registro no dependa del directorio de cada cliente
+  char resolved[PATH_MAX];
+  request.machine = ::realpath(argv[2], resolved) != nullptr ? resolved : argv[2];
+
+  for (int i = 3; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--no-tape") {
+      request.include_tape = false;
+    } else if (arg == "--help") {
+      show_help(argv[0]);
+      return 0;
+    } else if (arg == "--words") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta ruta después de --words\n";
+        return 1;
+      }
+      words_path = argv[++i];
+    } else if (arg == "--max-steps" || arg == "--batch") {
+      if (i + 1 >= argc) {
+        std::cerr << "[Error] Falta N después de " << arg << "\n";
+        return 1;
+      }
+      try {
+        long long v = std::stoll(argv[++i]);
+        if (v <= 0) {
+          throw std::invalid_argument("fuera de rango");
+        }
+        if (arg == "--batch") {
+          batch_size = static_cast<size_t>(v);
+        } else {
+          request.max_steps = static_cast<uint64_t>(v);
+        }
+      } catch (...) {
+        std::cerr << "[Error] " << arg << " requiere un entero > 0\n";
+        return 1;
+      }
+    } else {
+      std::cerr << "[Aviso] Opción desconocida: " << arg << "\n";
+    }
+  }
+
+  WordReader reader;
+  if (words_path.has_value()) {
+    if (!reader.open_file(words_path.value())) {
+      std::cerr << "[Error] " << reader.get_last_error() << "\n";
+      return 3;
+    }
+  } else {
+    reader.open_stdin();
+  }
+
+  // El servidor puede cerrar la conexión (rechazo o parada) mientras se envía
+  std::signal(SIGPIPE, SIG_IGN);
+  int fd = connect_to(socket_path);
+  if (fd < 0) {
+    return 3;
+  }
+
+  // Las palabras se envían por lotes sobre la misma conexión
+  size_t sent = 0;
+  std::string_view word;
+  bool ok = true;
+  bool more = true;
+  while (ok && more) {
+    request.words.clear();
+    while (request.words.size() < batch_size && (more = reader.next(word))) {
+      request.words.emplace_back(word);
+    }
+    if (request.words.empty()) {
+      break;
+    }
+    ok = run_batch(fd, request, sent);
+    sent += request.words.size();
+  }
+
+  ::close(fd);
+  if (!ok) {
+    return 4;
+  }
+  // Un error de lectura corta la entrada: las palabras siguientes no se enviaron
+  if (!reader.get_last_error().empty()) {
+    std::cerr << "[Error] " << reader.get_last_error() << "\n";
+    return 3;
+  }
+  return 0;
+}
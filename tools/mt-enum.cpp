@@ -0,0 +1,136 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "Enumerator.hpp"
+#include "Simulator.hpp"
+
+/**
+ * @brief Enumeración de máquinas de n estados y m símbolos (mt-enum)
+ *
+ * Recorre en forma normal de árbol todas las máquinas monocinta de n estados
+ * y m símbolos sobre la cinta en blanco, las clasifica (se detiene, no se
+ * detiene con prueba, sin decidir) y escribe opcionalmente la base de datos de
+ * resultados. Al terminar muestra el recuento y la máquina que más tarda en
+ * detenerse.
+ */
+
+namespace {
+
+void show_help(const char* program_name) {
+  std::cout << "Uso: " << program_name << " [opciones]\n\n"
+            << "Opciones:\n"
+            << "  --states N           Estados (1-" << Enumerator::MAX_STATES << ", por defecto 2)\n"
+            << "  --symbols N          Símbolos de cinta con el blanco (2-" << Enumerator::MAX_SYMBOLS
+            << ", por defecto 2)\n"
+            << "  --max-steps N        Límite de pasos por máquina (por defecto 1000)\n"
+            << "  --deciders <lista>   Decisores de no parada: backward, ctl, bouncer, all o none\n"
+            << "                       (por defecto all)\n"
+            << "  --decider-steps N    Trabajo máximo de cada decisor por máquina (por defecto 100000)\n"
+            << "  --workers N          Hilos (por defecto, los del procesador)\n"
+            << "  --format <f>         Formato de la base de datos: binary o text (por defecto binary)\n"
+            << "  -o <fichero>         Base de datos de resultados (sin -o no se escribe)\n"
+            << "  --help               Muestra esta ayuda\n";
+}
+
+size_t parse_positive(const std::string& option, const std::string& value) {
+  if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos ||
+      std::stoull(value) == 0) {
+    throw std::invalid_argument(option + " requiere un entero > 0");
+  }
+  return static_cast<size_t>(std::stoull(value));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  EnumerationOptions options;
+  unsigned hardware_threads = std::thread::hardware_concurrency();
+  options.num_workers = hardware_threads > 0 ? hardware_threads : 4;
+  EnumerationFormat format = EnumerationFormat::BINARY;
+  std::string output_path;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      if (arg == "--help") {
+        show_help(argv[0]);
+        return 0;
+      }
+      if (i + 1 >= argc) {
+        throw std::invalid_argument("Opción desconocida o incompleta: " + arg);
+      }
+      std::string value = argv[++i];
+      if (arg == "--states") {
+        options.num_states = parse_positive(arg, value);
+      } else if (arg == "--symbols") {
+        options.num_symbols = parse_positive(arg, value);
+      } else if (arg == "--max-steps") {
+        options.max_steps = parse_positive(arg, value);
+      } else if (arg == "--deciders") {
+        options.deciders = value == "none" ? "" : value;
+      } else if (arg == "--decider-steps") {
+        options.budget.steps = parse_positive(arg, value);
+      } else if (arg == "--workers") {
+        options.num_workers = parse_positive(arg, value);
+      } else if (arg == "--format") {
+        if (value != "binary" && value != "text") {
+          throw std::invalid_argument("--format debe ser binary o text");
+        }
+        format = value == "text" ? EnumerationFormat::TEXT : EnumerationFormat::BINARY;
+      } else if (arg == "-o") {
+        output_path = value;
+      } else {
+        throw std::invalid_argument("Opción desconocida: " + arg);
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "[Error] " << e.what() << "\n";
+    return 1;
+  }
+
+  Enumerator enumerator(options);
+  std::FILE* out = nullptr;
+  if (!output_path.empty()) {
+    out = std::fopen(output_path.c_str(), "wb");
+    if (out == nullptr) {
+      std::cerr << "[Error] No se puede crear el archivo: " << output_path << "\n";
+      return 3;
+    }
+    enumerator.set_output(out, format);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  bool ok = enumerator.run();
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (out != nullptr && std::fclose(out) != 0) {
+    ok = false;
+  }
+  if (!ok) {
+    std::cerr << "[Error] " << enumerator.get_last_error() << "\n";
+    return 3;
+  }
+
+  const Enumerator::Summary& summary = enumerator.get_summary();
+  std::cout << "Máquinas (" << options.num_states << " estados, " << options.num_symbols
+            << " símbolos): " << summary.nodes << " en " << seconds << " s con " << options.num_workers
+            << (options.num_workers == 1 ? " hilo" : " hilos") << "\n"
+            << "  se detienen:    " << summary.halting << "\n"
+            << "  no se detienen: " << summary.nonhalting << "\n";
+  for (size_t i = 1; i < summary.proofs.size(); ++i) {
+    if (summary.proofs[i] > 0) {
+      std::cout << "    " << Simulator::proof_to_string(static_cast<InfiniteProof>(i)) << ": "
+                << summary.proofs[i] << "\n";
+    }
+  }
+  std::cout << "  sin decidir:    " << summary.undecided << "\n";
+  if (!summary.champion.empty()) {
+    // La transición de parada no se da: S(n) la cuenta como un paso más
+    std::cout << "Más pasos hasta detenerse: " << summary.max_halt_steps << " (" << summary.champion
+              << ", S = " << summary.max_halt_steps + 1 << " contando la transición de parada)\n";
+  }
+  return 0;
+}
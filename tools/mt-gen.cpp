@@ -0,0 +1,333 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "MachineFactory.hpp"
+#include "Parser.hpp"
+#include "SplitMix64.hpp"
+
+/**
+ * @brief Generador de máquinas y de corpus de palabras (mt-gen)
+ *
+ * mt-gen machine: escribe una máquina con el Parser, aleatoria (dependiente
+ *                 solo de la semilla) o de una familia conocida.
+ * mt-gen words:   escribe un corpus de palabras, una por línea, con longitud
+ *                 uniforme, fija o geométrica y una proporción de repetidas.
+ *
+ * El corpus se escribe por bloques según se genera: solo se guarda una ventana
+ * acotada de palabras recientes de donde sacar las repetidas, así que puede
+ * ocupar varios GB sin tenerlo en memoria.
+ */
+
+namespace {
+
+const size_t OUTPUT_BUFFER_SIZE = 1 << 20;              // Bloque de escritura del corpus
+const size_t RECENT_WORDS = 65536;                      // Ventana máxima de palabras recientes
+const size_t RECENT_BYTES = static_cast<size_t>(64) << 20;  // Memoria máxima de la ventana
+
+void show_help(const char* program_name) {
+  std::cout << "Uso: " << program_name << " machine [opciones]\n"
+            << "     " << program_name << " words [opciones]\n\n"
+            << "Opciones de machine:\n"
+            << "  --family <f>         busy-beaver, unary-counter, binary-counter, sorter o copy\n"
+            << "                       (sin --family: máquina aleatoria)\n"
+            << "  --states N           Estados (aleatoria: sin contar qf; busy-beaver: 2-5; por defecto 4)\n"
+            << "  --symbols N          Símbolos de entrada de la aleatoria (por defecto 2)\n"
+            << "  --tapes N            Cintas (aleatoria o copy; por defecto 1, copy 2)\n"
+            << "  --density P          Probabilidad de definir cada transición (por defecto 1)\n"
+            << "  --halt P             Probabilidad de ir al estado de parada (por defecto 0.05)\n\n"
+            << "Opciones de words:\n"
+            << "  --count N            Número de palabras (por defecto 1000)\n"
+            << "  --alphabet <s>       Símbolos de las palabras (por defecto ab)\n"
+            << "  --length N | MIN:MAX Longitud fija o rango (por defecto 0:16)\n"
+            << "  --distribution <d>   uniform o geometric (media --mean-length, truncada al rango)\n"
+            << "  --mean-length M      Media de la geométrica (por defecto el centro del rango)\n"
+            << "  --duplicates P       Proporción de palabras repetidas de las recientes (por defecto 0)\n\n"
+            << "Comunes:\n"
+            << "  --seed N             Semilla (por defecto 1)\n"
+            << "  -o <fichero>         Fichero de salida (por defecto la salida estándar)\n"
+            << "  --help               Muestra esta ayuda\n";
+}
+
+/**
+ * @brief Opciones de la línea de comandos
+ */
+struct Options {
+  std::string family;
+  MachineFactory::RandomOptions random;
+  bool tapes_given = false;
+  bool states_given = false;
+
+  uint64_t count = 1000;
+  std::string alphabet = "ab";
+  size_t min_length = 0;
+  size_t max_length = 16;
+  bool geometric = false;
+  double mean_length = -1.0;
+  double duplicates = 0.0;
+
+  std::string output;
+};
+
+uint64_t parse_unsigned(const std::string& option, const std::string& value) {
+  if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+    throw std::invalid_argument(option + " requiere un entero >= 0");
+  }
+  return std::stoull(value);
+}
+
+double parse_probability(const std::string& option, const std::string& value) {
+  size_t used = 0;
+  double number = -1.0;
+  try {
+    number = std::stod(value, &used);
+  } catch (const std::exception&) {
+  }
+  if (used != value.size() || !(number >= 0.0 && number <= 1.0)) {
+    throw std::invalid_argument(option + " requiere un número entre 0 y 1");
+  }
+  return number;
+}
+
+/**
+ * @brief Lee las opciones a partir de argv[first]
+ * @throws std::invalid_argument si alguna no es válida
+ */
+Options parse_options(int argc, char** argv, int first) {
+  Options options;
+  for (int i = first; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      throw std::invalid_argument("Opción desconocida o incompleta: " + arg);
+    }
+    std::string value = argv[++i];
+    if (arg == "--family") {
+      options.family = value;
+    } else if (arg == "--states") {
+      options.random.num_states = parse_unsigned(arg, value);
+      options.states_given = true;
+    } else if (arg == "--symbols") {
+      options.random.num_symbols = parse_unsigned(arg, value);
+    } else if (arg == "--tapes") {
+      options.random.num_tapes = parse_unsigned(arg, value);
+      options.tapes_given = true;
+    } else if (arg == "--density") {
+      options.random.density = parse_probability(arg, value);
+    } else if (arg == "--halt") {
+      options.random.halt_probability = parse_probability(arg, value);
+    } else if (arg == "--seed") {
+      options.random.seed = parse_unsigned(arg, value);
+    } else if (arg == "--count") {
+      options.count = parse_unsigned(arg, value);
+    } else if (arg == "--alphabet") {
+      if (value.empty()) {
+        throw std::invalid_argument("--alphabet no puede estar vacío");
+      }
+      options.alphabet = value;
+    } else if (arg == "--length") {
+      size_t colon = value.find(':');
+      if (colon == std::string::npos) {
+        options.min_length = options.max_length = parse_unsigned(arg, value);
+      } else {
+        options.min_length = parse_unsigned(arg, value.substr(0, colon));
+        options.max_length = parse_unsigned(arg, value.substr(colon + 1));
+      }
+      if (options.min_length > options.max_length) {
+        throw std::invalid_argument("--length requiere MIN <= MAX");
+      }
+    } else if (arg == "--distribution") {
+      if (value != "uniform" && value != "geometric") {
+        throw std::invalid_argument("--distribution debe ser uniform o geometric");
+      }
+      options.geometric = value == "geometric";
+    } else if (arg == "--mean-length") {
+      size_t used = 0;
+      try {
+        options.mean_length = std::stod(value, &used);
+      } catch (const std::exception&) {
+        used = 0;
+      }
+      if (used != value.size() || !(options.mean_length >= 0.0)) {
+        throw std::invalid_argument("--mean-length requiere un número >= 0");
+      }
+    } else if (arg == "--duplicates") {
+      options.duplicates = parse_probability(arg, value);
+    } else if (arg == "-o") {
+      options.output = value;
+    } else {
+      throw std::invalid_argument("Opción desconocida: " + arg);
+    }
+  }
+  return options;
+}
+
+/**
+ * @brief Genera y escribe la máquina pedida
+ */
+bool generate_machine(const Options& options, std::ostream& out) {
+  if (options.family.empty()) {
+    if (options.random.num_tapes > 1) {
+      return Parser::save_multi_to_stream(out, MachineFactory::random_multi_machine(options.random));
+    }
+    return Parser::save_to_stream(out, MachineFactory::random_machine(options.random));
+  }
+  if (options.family == "busy-beaver") {
+    int states = options.states_given ? static_cast<int>(options.random.num_states) : 4;
+    return Parser::save_to_stream(out, MachineFactory::busy_beaver(states));
+  }
+  if (options.family == "unary-counter") {
+    return Parser::save_to_stream(out, MachineFactory::unary_counter());
+  }
+  if (options.family == "binary-counter") {
+    return Parser::save_to_stream(out, MachineFactory::binary_counter());
+  }
+  if (options.family == "sorter") {
+    return Parser::save_to_stream(out, MachineFactory::sorter());
+  }
+  if (options.family == "copy") {
+    size_t tapes = options.tapes_given ? options.random.num_tapes : 2;
+    return Parser::save_multi_to_stream(out, MachineFactory::tape_copy(tapes));
+  }
+  throw std::invalid_argument("Familia desconocida: " + options.family);
+}
+
+/**
+ * @brief Sortea la longitud de una palabra
+ */
+size_t draw_length(const Options& options, SplitMix64& random) {
+  size_t span = options.max_length - options.min_length;
+  if (span == 0) {
+    return options.min_length;
+  }
+  if (!options.geometric) {
+    return options.min_length + random.below(span + 1);
+  }
+  // Geométrica sobre MIN, MIN+1, ... con la media pedida; lo que pasa de MAX se trunca
+  double mean = options.mean_length >= 0.0 ? options.mean_length
+                                           : static_cast<double>(options.min_length) + span / 2.0;
+  double extra = std::max(0.0, mean - static_cast<double>(options.min_length));
+  if (extra <= 0.0) {
+    return options.min_length;
+  }
+  double p = 1.0 / (extra + 1.0);
+  double u = 1.0 - random.unit();  // En (0, 1]
+  double k = std::floor(std::log(u) / std::log1p(-p));
+  return options.min_length + static_cast<size_t>(std::min(k, static_cast<double>(span)));
+}
+
+/**
+ * @brief Genera el corpus y lo escribe por bloques
+ */
+bool generate_words(const Options& options, std::FILE* out) {
+  SplitMix64 random(options.random.seed);
+  std::string buffer;
+  buffer.reserve(OUTPUT_BUFFER_SIZE + options.max_length + 1);
+
+  // Ventana circular de palabras recientes para las repetidas
+  size_t window = std::max<size_t>(1, std::min(RECENT_WORDS, RECENT_BYTES / (options.max_length + 1)));
+  std::vector<std::string> recent;
+  size_t next_slot = 0;
+
+  std::string word;
+  for (uint64_t i = 0; i < options.count; ++i) {
+    if (!recent.empty() && options.duplicates > 0.0 && random.unit() < options.duplicates) {
+      word = recent[random.below(recent.size())];
+    } else {
+      word.resize(draw_length(options, random));
+      for (char& symbol : word) {
+        symbol = options.alphabet[random.below(options.alphabet.size())];
+      }
+      if (options.duplicates > 0.0) {
+        if (recent.size() < window) {
+          recent.push_back(word);
+        } else {
+          recent[next_slot] = word;
+          next_slot = (next_slot + 1) % window;
+        }
+      }
+    }
+
+    buffer += word;
+    buffer += '\n';
+    if (buffer.size() >= OUTPUT_BUFFER_SIZE) {
+      if (std::fwrite(buffer.data(), 1, buffer.size(), out) != buffer.size()) {
+        return false;
+      }
+      buffer.clear();
+    }
+  }
+  return std::fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size() && std::fflush(out) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2 || std::string(argv[1]) == "--help") {
+    show_help(argv[0]);
+    return argc < 2 ? 1 : 0;
+  }
+  std::string command = argv[1];
+  if (command != "machine" && command != "words") {
+    std::cerr << "[Error] Orden desconocida: " << command << " (machine o words)\n";
+    return 1;
+  }
+  for (int i = 2; i < argc; ++i) {
+    if (std::string(argv[i]) == "--help") {
+      show_help(argv[0]);
+      return 0;
+    }
+  }
+
+  Options options;
+  try {
+    options = parse_options(argc, argv, 2);
+  } catch (const std::exception& e) {
+    std::cerr << "[Error] " << e.what() << "\n";
+    return 1;
+  }
+
+  if (command == "machine") {
+    std::ofstream file;
+    if (!options.output.empty()) {
+      file.open(options.output);
+      if (!file.is_open()) {
+        std::cerr << "[Error] No se puede crear el archivo: " << options.output << "\n";
+        return 3;
+      }
+    }
+    try {
+      if (!generate_machine(options, options.output.empty() ? std::cout : file)) {
+        std::cerr << "[Error] " << Parser::get_last_error() << "\n";
+        return 3;
+      }
+    } catch (const std::exception& e) {
+      std::cerr << "[Error] " << e.what() << "\n";
+      return 1;
+    }
+    return 0;
+  }
+
+  std::FILE* out = stdout;
+  if (!options.output.empty()) {
+    out = std::fopen(options.output.c_str(), "wb");
+    if (out == nullptr) {
+      std::cerr << "[Error] No se puede crear el archivo: " << options.output << "\n";
+      return 3;
+    }
+  }
+  bool written = generate_words(options, out);
+  if (out != stdout && std::fclose(out) != 0) {
+    written = false;
+  }
+  if (!written) {
+    std::cerr << "[Error] Error al escribir el corpus\n";
+    return 3;
+  }
+  return 0;
+}